@@ -0,0 +1,271 @@
+#include "Generator.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+namespace bo {
+namespace bench {
+
+namespace {
+
+// NOTE: SplitMix64, rather than the standard distributions whose output
+//       differs between standard libraries.
+class Random {
+public:
+	explicit Random(std::uint64_t seed)
+	  : m_state(seed) {}
+
+	std::uint64_t next() {
+		auto z = (m_state += 0x9e3779b97f4a7c15ULL);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+
+	std::size_t below(std::size_t bound) { return static_cast<std::size_t>(next() % bound); }
+	bool chance(unsigned percentage) { return below(100) < percentage; }
+
+private:
+	std::uint64_t m_state;
+};
+
+constexpr std::array<std::string_view, 8> integer_types { "i8", "i16", "i32", "i64", "u8", "u16", "u32", "u64" };
+constexpr std::array<std::string_view, 5> arithmetic_operators { "+", "-", "*", "&", "|" };
+constexpr std::array<std::string_view, 4> comparison_operators { "<", ">", "==", "!=" };
+
+struct ArrayType {
+	std::size_t size;
+	std::string_view element_type;
+};
+
+// NOTE: Every function of the program has the signature
+//       `(anon a: T, anon b: T, values: [N]T): T`, so an array type fully
+//       determines a signature and functions sharing one can call each other.
+//       Overloads are resolved by exact types, so the arguments are never
+//       literals nor `acc`, whose type is mutable.
+class ProgramGenerator {
+public:
+	explicit ProgramGenerator(GeneratorOptions const& options)
+	  : m_options(options), m_random(options.seed), m_functions_by_signature(std::max<std::size_t>(options.array_type_count, 1)) {
+		for (std::size_t i = 0; i < m_functions_by_signature.size(); ++i) {
+			m_array_types.push_back({ 4 + i / integer_types.size(), integer_types[i % integer_types.size()] });
+		}
+	}
+
+	std::string generate() {
+		for (std::size_t i = 0; i < m_options.function_count; ++i) {
+			generate_function(i);
+		}
+
+		m_code += "fn main(): void {\n\tprint(0);\n}\n";
+		return std::move(m_code);
+	}
+
+private:
+	struct Function {
+		std::size_t name;
+		std::vector<std::size_t> signatures;
+	};
+
+	std::size_t pick_name(std::size_t signature) {
+		if (!m_functions.empty() && m_random.chance(m_options.overload_density)) {
+			// NOTE: A few tries at finding a name that isn't declared with this
+			//       signature yet, otherwise the function gets a name of its own.
+			for (int attempt = 0; attempt < 4; ++attempt) {
+				auto& function = m_functions[m_random.below(m_functions.size())];
+				if (std::ranges::find(function.signatures, signature) == function.signatures.end()) {
+					function.signatures.push_back(signature);
+					return function.name;
+				}
+			}
+		}
+
+		m_functions.push_back({ m_functions.size(), { signature } });
+		return m_functions.back().name;
+	}
+
+	void generate_function(std::size_t index) {
+		m_signature = m_random.below(m_array_types.size());
+		auto const& array_type = m_array_types[m_signature];
+		auto name = pick_name(m_signature);
+
+		fmt::format_to(std::back_inserter(m_code), "// function {}\nfn f{}(anon a: {}, anon b: {}, values: [{}]{}): {} {{\n", index, name, array_type.element_type, array_type.element_type, array_type.size, array_type.element_type, array_type.element_type);
+		fmt::format_to(std::back_inserter(m_code), "\tmut acc: {} = a;\n", array_type.element_type);
+		m_variables = { "a", "b", "acc" };
+		m_next_variable = 0;
+		m_indent = 1;
+		for (std::size_t i = 0; i < m_options.local_count; ++i) {
+			indent();
+			generate_local();
+			m_code += ";\n";
+		}
+
+		generate_statements(m_options.nesting_depth);
+		m_code += "\tacc\n}\n";
+
+		m_functions_by_signature[m_signature].push_back(name);
+	}
+
+	void indent() { m_code.append(m_indent, '\t'); }
+
+	std::string new_variable() { return fmt::format("v{}", m_next_variable++); }
+
+	void generate_statements(std::size_t depth) {
+		auto statement_count = 2 + m_random.below(2);
+		// NOTE: Exactly one statement of each block nests further, so that the
+		//       requested depth is reached without the size of the function
+		//       growing exponentially with it.
+		auto nested_statement = m_random.below(statement_count);
+		for (std::size_t i = 0; i < statement_count; ++i) {
+			if (depth > 0 && i == nested_statement) {
+				generate_nested_statement(depth - 1);
+			} else {
+				generate_simple_statement();
+			}
+		}
+	}
+
+	void generate_local() {
+		auto variable = new_variable();
+		fmt::format_to(std::back_inserter(m_code), "var {}: {} = ", variable, m_array_types[m_signature].element_type);
+		generate_parenthesized_expression();
+		m_variables.push_back(std::move(variable));
+	}
+
+	void generate_simple_statement() {
+		indent();
+		switch (m_random.below(3)) {
+		case 0:
+			generate_local();
+			break;
+		case 1:
+			m_code += "acc = ";
+			generate_parenthesized_expression();
+			break;
+		default:
+			m_code += "acc += ";
+			generate_parenthesized_expression();
+			break;
+		}
+
+		m_code += ";\n";
+	}
+
+	void generate_nested_statement(std::size_t depth) {
+		auto variable_count = m_variables.size();
+		indent();
+		switch (m_random.below(3)) {
+		case 0: {
+			auto variable = new_variable();
+			fmt::format_to(std::back_inserter(m_code), "for ({} in values) {{\n", variable);
+			m_variables.push_back(std::move(variable));
+			generate_block(depth);
+			break;
+		}
+		case 1:
+			m_code += "if (";
+			generate_condition();
+			m_code += ") {\n";
+			generate_block(depth);
+			m_code += " else {\n";
+			generate_block(0);
+			break;
+		default:
+			m_code += "{\n";
+			generate_block(depth);
+			break;
+		}
+
+		m_code += "\n";
+		m_variables.resize(variable_count);
+	}
+
+	// NOTE: Leaves the closing brace unterminated, for an `else` to follow.
+	void generate_block(std::size_t depth) {
+		auto variable_count = m_variables.size();
+		++m_indent;
+		generate_statements(depth);
+		--m_indent;
+		m_variables.resize(variable_count);
+		indent();
+		m_code += "}";
+	}
+
+	void generate_condition() {
+		generate_expression(m_options.expression_size / 2);
+		fmt::format_to(std::back_inserter(m_code), " {} ", comparison_operators[m_random.below(comparison_operators.size())]);
+		generate_expression(m_options.expression_size / 2);
+	}
+
+	void generate_parenthesized_expression() {
+		m_code.append(m_options.parenthesis_depth, '(');
+		generate_expression(m_options.expression_size);
+		m_code.append(m_options.parenthesis_depth, ')');
+	}
+
+	void generate_expression(std::size_t size) {
+		if (size == 0) {
+			generate_operand();
+			return;
+		}
+
+		auto left_size = m_random.below(size);
+		auto is_parenthesized = m_random.chance(50);
+		if (is_parenthesized) {
+			m_code += "(";
+		}
+
+		generate_expression(left_size);
+		fmt::format_to(std::back_inserter(m_code), " {} ", arithmetic_operators[m_random.below(arithmetic_operators.size())]);
+		generate_expression(size - 1 - left_size);
+		if (is_parenthesized) {
+			m_code += ")";
+		}
+	}
+
+	void generate_operand() {
+		auto const& array_type = m_array_types[m_signature];
+		auto const& callees = m_functions_by_signature[m_signature];
+		auto choice = m_random.below(10);
+		if (choice == 0 && !callees.empty()) {
+			fmt::format_to(std::back_inserter(m_code), "f{}({}, {}, values: values)", callees[m_random.below(callees.size())], random_argument(), random_argument());
+		} else if (choice <= 2) {
+			fmt::format_to(std::back_inserter(m_code), "{}_{}", 1 + m_random.below(100), array_type.element_type);
+		} else {
+			m_code += random_variable();
+		}
+	}
+
+	std::string_view random_variable() { return m_variables[m_random.below(m_variables.size())]; }
+
+	std::string_view random_argument() {
+		auto variable = random_variable();
+		return variable == "acc" ? "a" : variable;
+	}
+
+	GeneratorOptions const& m_options;
+	Random m_random;
+	std::vector<ArrayType> m_array_types;
+	std::vector<Function> m_functions;
+	std::vector<std::vector<std::size_t>> m_functions_by_signature;
+	std::string m_code;
+
+	std::size_t m_signature { 0 };
+	std::vector<std::string> m_variables;
+	std::size_t m_next_variable { 0 };
+	std::size_t m_indent { 0 };
+};
+
+}
+
+std::string generate_program(GeneratorOptions const& options) {
+	return ProgramGenerator { options }.generate();
+}
+
+}
+}
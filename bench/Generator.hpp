@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace bo {
+namespace bench {
+
+// NOTE: Shapes the synthetic programs the benchmarks run on. The same options
+//       always produce the same program, whatever the platform, so results
+//       from different commits can be compared.
+struct GeneratorOptions {
+	std::uint64_t seed { 1 };
+	std::size_t function_count { 1000 };
+	// NOTE: How deep ifs, loops and blocks nest inside each function.
+	std::size_t nesting_depth { 3 };
+	// NOTE: Binary operators in each expression.
+	std::size_t expression_size { 6 };
+	// NOTE: Redundant parentheses around the expression of every assignment
+	//       and declaration, to stress the recursion of the stages.
+	std::size_t parenthesis_depth { 0 };
+	// NOTE: Percentage of the functions that overload the name of an earlier
+	//       one rather than introducing a new name.
+	unsigned overload_density { 25 };
+	// NOTE: Distinct array types, and so distinct signatures, in the program.
+	std::size_t array_type_count { 8 };
+	// NOTE: Locals declared at the top of each function, before its other
+	//       statements, all of which can refer to them.
+	std::size_t local_count { 0 };
+};
+
+// NOTE: The programs are well typed, so every stage of the compiler runs to
+//       completion on them.
+std::string generate_program(GeneratorOptions const&);
+
+}
+}
@@ -0,0 +1,705 @@
+#include "Generator.hpp"
+
+#include "ConstantFolder.hpp"
+#include "Error.hpp"
+#include "FlatAST.hpp"
+#include "Lexer.hpp"
+#include "OutputSink.hpp"
+#include "Parser.hpp"
+#include "System.hpp"
+#include "Transpiler.hpp"
+#include "Typechecker.hpp"
+#include "utils/Result.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// NOTE: The time spent in one iteration of a benchmark, excluding its setup,
+//       and how much it processed, in whatever unit the benchmark counts.
+struct Measurement {
+	double wall_seconds;
+	double cpu_seconds;
+	std::size_t items;
+};
+
+// NOTE: CPU time covers every thread of the process, so that the parallel
+//       stages can be told apart from the serial ones.
+class Stopwatch {
+public:
+	void start() {
+		m_wall_start = std::chrono::steady_clock::now();
+		m_cpu_start = cpu_seconds();
+	}
+
+	Measurement stop(std::size_t items) const {
+		std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - m_wall_start;
+		return { wall_time.count(), cpu_seconds() - m_cpu_start, items };
+	}
+
+private:
+	static double cpu_seconds() {
+		timespec time;
+		::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+		return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) / 1e9;
+	}
+
+	std::chrono::steady_clock::time_point m_wall_start;
+	double m_cpu_start { 0 };
+};
+
+class DiscardingSink : public bo::OutputSink {
+public:
+	virtual Result<void, bo::Error> write(std::span<std::string_view const> blocks) override {
+		for (auto block : blocks) {
+			m_size += block.size();
+		}
+
+		return {};
+	}
+
+	std::size_t size() const { return m_size; }
+
+private:
+	std::size_t m_size { 0 };
+};
+
+struct Workload {
+	std::string_view name;
+	bo::bench::GeneratorOptions options;
+	std::string source;
+	// NOTE: When set, only the benchmarks whose name starts with it run on the
+	//       workload, for workloads too large to go through every stage.
+	std::string_view benchmark_prefix {};
+};
+
+struct Benchmark {
+	std::string_view name;
+	// NOTE: What Measurement::items counts, e.g. "tokens".
+	std::string_view unit;
+	Result<Measurement, bo::Error> (*run)(std::string_view source);
+};
+
+struct BenchmarkResult {
+	std::string name;
+	std::string_view unit;
+	std::size_t iterations;
+	double mean_wall_seconds;
+	double median_wall_seconds;
+	double min_wall_seconds;
+	double stddev_wall_seconds;
+	double mean_cpu_seconds;
+	std::size_t items;
+	std::size_t source_bytes;
+};
+
+static std::vector<Workload> make_workloads() {
+	std::vector<Workload> workloads;
+	workloads.push_back({ "small", { .function_count = 100 }, {} });
+	workloads.push_back({ "large", { .function_count = 5000 }, {} });
+	workloads.push_back({ "deep", { .function_count = 1000, .nesting_depth = 12 }, {} });
+	workloads.push_back({ "long_expressions", { .function_count = 1000, .expression_size = 48 }, {} });
+	workloads.push_back({ "nested_expressions", { .function_count = 200, .parenthesis_depth = 64 }, {} });
+	workloads.push_back({ "overloads", { .function_count = 5000, .overload_density = 90 }, {} });
+	workloads.push_back({ "array_types", { .function_count = 5000, .array_type_count = 512 }, {} });
+	// NOTE: 100k locals over 10k functions, every identifier resolving among
+	//       the locals of its own function.
+	workloads.push_back({ "locals", { .function_count = 10000, .local_count = 10 }, {} });
+	// NOTE: The same amount of code spread over more and more distinct types,
+	//       whose count shouldn't show in the time spent typechecking.
+	workloads.push_back({ "types_1k", { .function_count = 40000, .nesting_depth = 0, .expression_size = 2, .array_type_count = 1000 }, {} });
+	workloads.push_back({ "types_10k", { .function_count = 40000, .nesting_depth = 0, .expression_size = 2, .array_type_count = 10000 }, {} });
+	workloads.push_back({ "types_40k", { .function_count = 40000, .nesting_depth = 0, .expression_size = 2, .array_type_count = 40000 }, {} });
+	// NOTE: About 1, 10 and 100 MB of source, to compare streaming and batch
+	//       lexing as the token buffer outgrows the caches.
+	workloads.push_back({ "1mb", { .function_count = 1130 }, {}, "lex_" });
+	workloads.push_back({ "10mb", { .function_count = 11300 }, {}, "lex_" });
+	workloads.push_back({ "100mb", { .function_count = 113000 }, {}, "lex_" });
+	return workloads;
+}
+
+// NOTE: Each benchmark only times its own stage, the stages before it are run
+//       untimed on every iteration to produce its input.
+static Result<Measurement, bo::Error> benchmark_lex_streaming(std::string_view source) {
+	Stopwatch stopwatch;
+	stopwatch.start();
+	bo::Lexer lexer { source };
+	std::size_t token_count = 0;
+	while (TRY(lexer.next_token()).type() != bo::Token::Type::EndOfFile) {
+		++token_count;
+	}
+
+	return stopwatch.stop(token_count + 1);
+}
+
+static Result<Measurement, bo::Error> benchmark_lex_batch(std::string_view source) {
+	Stopwatch stopwatch;
+	stopwatch.start();
+	auto tokens = TRY(bo::Lexer::tokenize(source));
+	return stopwatch.stop(tokens.size());
+}
+
+// NOTE: Lexing and parsing together, since streaming interleaves them.
+template<bo::Parser::LexingMode lexing_mode>
+static Result<Measurement, bo::Error> benchmark_lex_parse(std::string_view source) {
+	bo::Arena arena;
+	Stopwatch stopwatch;
+	stopwatch.start();
+	auto parser = TRY(bo::Parser::create(source, arena, 0, lexing_mode));
+	TRY(parser.parse_program());
+	return stopwatch.stop(source.size());
+}
+
+// NOTE: The tokens are lexed up front, so that only parsing is timed.
+static Result<Measurement, bo::Error> benchmark_parse(std::string_view source) {
+	bo::Arena arena;
+	auto parser = TRY(bo::Parser::create(source, arena, 0, bo::Parser::LexingMode::Batch));
+	Stopwatch stopwatch;
+	stopwatch.start();
+	TRY(parser.parse_program());
+	return stopwatch.stop(arena.object_count());
+}
+
+// NOTE: Visits the nodes of the pointer AST that have an entry in the flat
+//       tree, in the same order, adding up the same kinds and spans.
+class PointerWalker {
+public:
+	void walk_program(bo::AST::Program const* program) {
+		for (auto function : program->function_declarations()) {
+			walk_function(function);
+		}
+		visit(program);
+	}
+
+	std::size_t node_count() const { return m_node_count; }
+	std::uint64_t checksum() const { return m_checksum; }
+
+private:
+	void visit(bo::AST::Node const* node) {
+		++m_node_count;
+		m_checksum += static_cast<std::uint64_t>(node->kind()) + node->span().start;
+	}
+
+	void walk_optional_expression(bo::AST::Expression const* expression) {
+		if (expression) {
+			walk_expression(expression);
+		}
+	}
+
+	void walk_type(bo::AST::Type const* type) {
+		if (type->inner_type()) {
+			walk_type(type->inner_type());
+		}
+		walk_optional_expression(type->array_size());
+		walk_optional_expression(type->name());
+		visit(type);
+	}
+
+	void walk_function(bo::AST::FunctionDeclarationStatement const* function) {
+		visit(function->name());
+		for (auto const& parameter : function->parameters()) {
+			visit(parameter.name);
+			walk_type(parameter.type);
+		}
+		walk_type(function->return_type());
+		walk_expression(function->body());
+		visit(function);
+	}
+
+	void walk_statement(bo::AST::Statement const* statement) {
+		switch (statement->kind()) {
+		case bo::AST::Kind::ExpressionStatement:
+			walk_expression(static_cast<bo::AST::ExpressionStatement const*>(statement)->expression());
+			break;
+		case bo::AST::Kind::VariableDeclarationStatement:
+			{
+				auto variable_declaration = static_cast<bo::AST::VariableDeclarationStatement const*>(statement);
+				visit(variable_declaration->identifier());
+				if (variable_declaration->type()) {
+					walk_type(variable_declaration->type());
+				}
+				walk_optional_expression(variable_declaration->initializer());
+				break;
+			}
+		case bo::AST::Kind::InfiniteForStatement:
+			walk_expression(static_cast<bo::AST::InfiniteForStatement const*>(statement)->body());
+			break;
+		case bo::AST::Kind::ForWithConditionStatement:
+			{
+				auto for_with_condition = static_cast<bo::AST::ForWithConditionStatement const*>(statement);
+				walk_expression(for_with_condition->condition());
+				walk_expression(for_with_condition->body());
+				break;
+			}
+		case bo::AST::Kind::ForWithRangeStatement:
+			{
+				auto for_with_range = static_cast<bo::AST::ForWithRangeStatement const*>(statement);
+				visit(for_with_range->range_variable());
+				walk_expression(for_with_range->range_expression());
+				walk_expression(for_with_range->body());
+				break;
+			}
+		case bo::AST::Kind::ReturnStatement:
+			walk_optional_expression(static_cast<bo::AST::ReturnStatement const*>(statement)->expression());
+			break;
+		default:
+			break;
+		}
+		visit(statement);
+	}
+
+	void walk_expression(bo::AST::Expression const* expression) {
+		switch (expression->kind()) {
+		case bo::AST::Kind::ParenthesizedExpression:
+			walk_expression(static_cast<bo::AST::ParenthesizedExpression const*>(expression)->expression());
+			break;
+		case bo::AST::Kind::BinaryExpression:
+			{
+				auto binary_expression = static_cast<bo::AST::BinaryExpression const*>(expression);
+				walk_expression(binary_expression->lhs());
+				walk_expression(binary_expression->rhs());
+				break;
+			}
+		case bo::AST::Kind::UnaryExpression:
+			walk_expression(static_cast<bo::AST::UnaryExpression const*>(expression)->operand());
+			break;
+		case bo::AST::Kind::AssignmentExpression:
+			{
+				auto assignment_expression = static_cast<bo::AST::AssignmentExpression const*>(expression);
+				walk_expression(assignment_expression->lhs());
+				walk_expression(assignment_expression->rhs());
+				break;
+			}
+		case bo::AST::Kind::UpdateExpression:
+			walk_expression(static_cast<bo::AST::UpdateExpression const*>(expression)->operand());
+			break;
+		case bo::AST::Kind::PointerDereferenceExpression:
+			walk_expression(static_cast<bo::AST::PointerDereferenceExpression const*>(expression)->operand());
+			break;
+		case bo::AST::Kind::AddressOfExpression:
+			walk_expression(static_cast<bo::AST::AddressOfExpression const*>(expression)->operand());
+			break;
+		case bo::AST::Kind::RangeExpression:
+			{
+				auto range_expression = static_cast<bo::AST::RangeExpression const*>(expression);
+				walk_expression(range_expression->start());
+				walk_expression(range_expression->end());
+				break;
+			}
+		case bo::AST::Kind::BlockExpression:
+			for (auto statement : static_cast<bo::AST::BlockExpression const*>(expression)->statements()) {
+				walk_statement(statement);
+			}
+			break;
+		case bo::AST::Kind::IfExpression:
+			{
+				auto if_expression = static_cast<bo::AST::IfExpression const*>(expression);
+				walk_expression(if_expression->condition());
+				walk_expression(if_expression->then());
+				walk_optional_expression(if_expression->else_());
+				break;
+			}
+		case bo::AST::Kind::FunctionCallExpression:
+			{
+				auto function_call = static_cast<bo::AST::FunctionCallExpression const*>(expression);
+				visit(function_call->name());
+				for (auto const& argument : function_call->arguments()) {
+					walk_optional_expression(argument.name);
+					walk_expression(argument.value);
+				}
+				break;
+			}
+		case bo::AST::Kind::ArrayExpression:
+			for (auto element : static_cast<bo::AST::ArrayExpression const*>(expression)->elements()) {
+				walk_expression(element);
+			}
+			break;
+		case bo::AST::Kind::ArraySubscriptExpression:
+			{
+				auto array_subscript = static_cast<bo::AST::ArraySubscriptExpression const*>(expression);
+				walk_expression(array_subscript->array());
+				walk_expression(array_subscript->index());
+				break;
+			}
+		default:
+			break;
+		}
+		visit(expression);
+	}
+
+	std::size_t m_node_count { 0 };
+	std::uint64_t m_checksum { 0 };
+};
+
+static Result<Measurement, bo::Error> benchmark_flatten(std::string_view source) {
+	bo::Arena arena;
+	auto parser = TRY(bo::Parser::create(source, arena));
+	auto program = TRY(parser.parse_program());
+	Stopwatch stopwatch;
+	stopwatch.start();
+	auto tree = bo::FlatAST::flatten(program);
+	return stopwatch.stop(tree.node_count());
+}
+
+// NOTE: The same traversal over both layouts, to see what the flat one saves a
+//       pass over the whole tree. Its nodes are stored in post-order, so the
+//       flat walk is a single loop over the arrays.
+static Result<Measurement, bo::Error> benchmark_walk_pointer(std::string_view source) {
+	bo::Arena arena;
+	auto parser = TRY(bo::Parser::create(source, arena));
+	auto program = TRY(parser.parse_program());
+	Stopwatch stopwatch;
+	stopwatch.start();
+	PointerWalker walker;
+	walker.walk_program(program);
+	auto checksum = walker.checksum();
+	asm volatile("" : : "r"(checksum));
+	return stopwatch.stop(walker.node_count());
+}
+
+static Result<Measurement, bo::Error> benchmark_walk_flat(std::string_view source) {
+	bo::Arena arena;
+	auto parser = TRY(bo::Parser::create(source, arena));
+	auto tree = bo::FlatAST::flatten(TRY(parser.parse_program()));
+	Stopwatch stopwatch;
+	stopwatch.start();
+	std::uint64_t checksum = 0;
+	for (bo::FlatAST::NodeIndex node = 0; node < tree.node_count(); ++node) {
+		checksum += static_cast<std::uint64_t>(tree.kind(node)) + tree.span(node).start;
+	}
+
+	asm volatile("" : : "r"(checksum));
+	return stopwatch.stop(tree.node_count());
+}
+
+static Result<Measurement, bo::Error> benchmark_typecheck(std::string_view source) {
+	bo::Arena arena;
+	auto parser = TRY(bo::Parser::create(source, arena));
+	auto program = TRY(parser.parse_program());
+	Stopwatch stopwatch;
+	stopwatch.start();
+	bo::Typechecker typechecker;
+	TRY(typechecker.check(program));
+	return stopwatch.stop(typechecker.program().node_count());
+}
+
+// NOTE: The trait queries the typechecker runs for every operator and
+//       assignment, asked about every type of the checked program. Programs
+//       only have a handful of types, so they are gone over enough times for
+//       the queries to outweigh the untimed setup.
+static Result<Measurement, bo::Error> benchmark_type_queries(std::string_view source) {
+	constexpr std::size_t queries_per_type_per_round = 4;
+	constexpr std::size_t target_queries = 1 << 24;
+
+	bo::Arena arena;
+	auto parser = TRY(bo::Parser::create(source, arena));
+	auto program = TRY(parser.parse_program());
+	bo::Typechecker typechecker;
+	TRY(typechecker.check(program));
+	auto const& checked_program = typechecker.program();
+	auto rounds = std::max<std::size_t>(target_queries / (queries_per_type_per_round * checked_program.type_count()), 1);
+	Stopwatch stopwatch;
+	stopwatch.start();
+	std::size_t checksum = 0;
+	for (std::size_t round = 0; round < rounds; ++round) {
+		for (bo::Types::Id id = 0; id < checked_program.type_count(); ++id) {
+			auto const& type = checked_program.get_type(id);
+			checksum += type.is_builtin() + type.is_integer() + type.is_signed() + type.size();
+		}
+	}
+
+	// NOTE: Keeps the loop from being optimized away.
+	asm volatile("" : : "r"(checksum));
+	return stopwatch.stop(rounds * checked_program.type_count() * queries_per_type_per_round);
+}
+
+static Result<Measurement, bo::Error> benchmark_fold(std::string_view source) {
+	bo::Arena arena;
+	auto parser = TRY(bo::Parser::create(source, arena));
+	auto program = TRY(parser.parse_program());
+	bo::Typechecker typechecker;
+	TRY(typechecker.check(program));
+	auto node_count = typechecker.program().node_count();
+	Stopwatch stopwatch;
+	stopwatch.start();
+	bo::ConstantFolder folder { typechecker.program() };
+	folder.fold();
+	return stopwatch.stop(node_count);
+}
+
+static Result<Measurement, bo::Error> benchmark_transpile(std::string_view source) {
+	bo::Arena arena;
+	auto parser = TRY(bo::Parser::create(source, arena));
+	auto program = TRY(parser.parse_program());
+	bo::Typechecker typechecker;
+	TRY(typechecker.check(program));
+	bo::ConstantFolder folder { typechecker.program() };
+	folder.fold();
+	DiscardingSink sink;
+	Stopwatch stopwatch;
+	stopwatch.start();
+	bo::Transpiler transpiler(typechecker.program());
+	TRY(transpiler.transpile(sink));
+	return stopwatch.stop(sink.size());
+}
+
+static Result<Measurement, bo::Error> benchmark_pipeline(std::string_view source) {
+	Stopwatch stopwatch;
+	stopwatch.start();
+	bo::Arena arena;
+	auto parser = TRY(bo::Parser::create(source, arena));
+	auto program = TRY(parser.parse_program());
+	bo::Typechecker typechecker;
+	TRY(typechecker.check(program));
+	bo::ConstantFolder folder { typechecker.program() };
+	folder.fold();
+	DiscardingSink sink;
+	bo::Transpiler transpiler(typechecker.program());
+	TRY(transpiler.transpile(sink));
+	return stopwatch.stop(source.size());
+}
+
+constexpr Benchmark benchmarks[] {
+	{ "lex_streaming", "tokens", benchmark_lex_streaming },
+	{ "lex_batch", "tokens", benchmark_lex_batch },
+	{ "lex_parse_streaming", "source bytes", benchmark_lex_parse<bo::Parser::LexingMode::Streaming> },
+	{ "lex_parse_batch", "source bytes", benchmark_lex_parse<bo::Parser::LexingMode::Batch> },
+	{ "parse", "nodes", benchmark_parse },
+	{ "flatten", "nodes", benchmark_flatten },
+	{ "walk_pointer", "nodes", benchmark_walk_pointer },
+	{ "walk_flat", "nodes", benchmark_walk_flat },
+	{ "typecheck", "nodes", benchmark_typecheck },
+	{ "type_queries", "queries", benchmark_type_queries },
+	{ "fold", "nodes", benchmark_fold },
+	{ "transpile", "bytes", benchmark_transpile },
+	{ "pipeline", "source bytes", benchmark_pipeline },
+};
+
+static bool is_selected(Benchmark const& benchmark, Workload const& workload, std::string_view filter) {
+	return benchmark.name.starts_with(workload.benchmark_prefix) && fmt::format("{}/{}", benchmark.name, workload.name).find(filter) != std::string::npos;
+}
+
+// NOTE: Like Google Benchmark, an iteration is run untimed to warm up and then
+//       iterations are repeated until they add up to the minimum time.
+static Result<BenchmarkResult, bo::Error> run_benchmark(Benchmark const& benchmark, Workload const& workload, double min_time) {
+	constexpr std::size_t min_iterations = 3;
+	constexpr std::size_t max_iterations = 100000;
+
+	TRY(benchmark.run(workload.source));
+
+	std::vector<Measurement> measurements;
+	double total_wall_seconds = 0;
+	while (measurements.size() < max_iterations && (measurements.size() < min_iterations || total_wall_seconds < min_time)) {
+		auto measurement = TRY(benchmark.run(workload.source));
+		total_wall_seconds += measurement.wall_seconds;
+		measurements.push_back(measurement);
+	}
+
+	auto iterations = measurements.size();
+	std::vector<double> wall_seconds;
+	double total_cpu_seconds = 0;
+	for (auto const& measurement : measurements) {
+		wall_seconds.push_back(measurement.wall_seconds);
+		total_cpu_seconds += measurement.cpu_seconds;
+	}
+
+	std::ranges::sort(wall_seconds);
+	auto mean = total_wall_seconds / static_cast<double>(iterations);
+	double variance = 0;
+	for (auto seconds : wall_seconds) {
+		variance += (seconds - mean) * (seconds - mean);
+	}
+
+	BenchmarkResult result;
+	result.name = fmt::format("{}/{}", benchmark.name, workload.name);
+	result.unit = benchmark.unit;
+	result.iterations = iterations;
+	result.mean_wall_seconds = mean;
+	result.median_wall_seconds = iterations % 2 == 1 ? wall_seconds[iterations / 2] : (wall_seconds[iterations / 2 - 1] + wall_seconds[iterations / 2]) / 2;
+	result.min_wall_seconds = wall_seconds.front();
+	result.stddev_wall_seconds = std::sqrt(variance / static_cast<double>(iterations));
+	result.mean_cpu_seconds = total_cpu_seconds / static_cast<double>(iterations);
+	result.items = measurements.front().items;
+	result.source_bytes = workload.source.size();
+	return result;
+}
+
+static void append_json_string(std::string& json, std::string_view string) {
+	json += '"';
+	for (auto c : string) {
+		if (c == '"' || c == '\\') {
+			json += '\\';
+		}
+
+		json += c;
+	}
+	json += '"';
+}
+
+// NOTE: The layout follows Google Benchmark's JSON reporter, so existing tools
+//       for comparing its results can be used on ours.
+static std::string results_to_json(std::vector<Workload> const& workloads, std::vector<BenchmarkResult> const& results) {
+	char host_name[256] {};
+	::gethostname(host_name, sizeof(host_name) - 1);
+	auto date = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+	char formatted_date[64];
+	std::strftime(formatted_date, sizeof(formatted_date), "%FT%T%z", std::localtime(&date));
+
+	std::string json = "{\n  \"context\": {\n    \"date\": ";
+	append_json_string(json, formatted_date);
+	json += ",\n    \"host_name\": ";
+	append_json_string(json, host_name);
+	fmt::format_to(std::back_inserter(json), ",\n    \"num_cpus\": {},\n    \"workloads\": [\n", std::thread::hardware_concurrency());
+	for (std::size_t i = 0; i < workloads.size(); ++i) {
+		auto const& workload = workloads[i];
+		auto const& options = workload.options;
+		json += "      {\"name\": ";
+		append_json_string(json, workload.name);
+		fmt::format_to(std::back_inserter(json), ", \"seed\": {}, \"function_count\": {}, \"nesting_depth\": {}, \"expression_size\": {}, \"parenthesis_depth\": {}, \"overload_density\": {}, \"array_type_count\": {}, \"local_count\": {}, \"source_bytes\": {}}}{}\n", options.seed, options.function_count, options.nesting_depth, options.expression_size, options.parenthesis_depth, options.overload_density, options.array_type_count, options.local_count, workload.source.size(), i + 1 < workloads.size() ? "," : "");
+	}
+
+	json += "    ]\n  },\n  \"benchmarks\": [\n";
+	for (std::size_t i = 0; i < results.size(); ++i) {
+		auto const& result = results[i];
+		json += "    {\n      \"name\": ";
+		append_json_string(json, result.name);
+		json += ",\n      \"run_type\": \"iteration\",\n      \"unit\": ";
+		append_json_string(json, result.unit);
+		fmt::format_to(std::back_inserter(json), ",\n      \"iterations\": {},\n      \"real_time\": {:.6f},\n      \"cpu_time\": {:.6f},\n      \"time_unit\": \"ms\",\n", result.iterations, result.mean_wall_seconds * 1e3, result.mean_cpu_seconds * 1e3);
+		fmt::format_to(std::back_inserter(json), "      \"median_real_time\": {:.6f},\n      \"min_real_time\": {:.6f},\n      \"stddev_real_time\": {:.6f},\n", result.median_wall_seconds * 1e3, result.min_wall_seconds * 1e3, result.stddev_wall_seconds * 1e3);
+		fmt::format_to(std::back_inserter(json), "      \"items\": {},\n      \"items_per_second\": {:.1f},\n      \"source_bytes_per_second\": {:.1f}\n    }}{}\n", result.items, static_cast<double>(result.items) / result.mean_wall_seconds, static_cast<double>(result.source_bytes) / result.mean_wall_seconds, i + 1 < results.size() ? "," : "");
+	}
+
+	json += "  ]\n}\n";
+	return json;
+}
+
+static std::string format_rate(double rate) {
+	if (rate >= 1e9) {
+		return fmt::format("{:.2f}G", rate / 1e9);
+	}
+
+	if (rate >= 1e6) {
+		return fmt::format("{:.2f}M", rate / 1e6);
+	}
+
+	if (rate >= 1e3) {
+		return fmt::format("{:.2f}k", rate / 1e3);
+	}
+
+	return fmt::format("{:.2f}", rate);
+}
+
+template<typename T>
+static bool parse_number(std::string_view string, T& value) {
+	auto [end, error] = std::from_chars(string.data(), string.data() + string.size(), value);
+	return error == std::errc {} && end == string.data() + string.size();
+}
+
+// NOTE: Prints the program of a custom workload, e.g. to feed it to boc.
+static int generate(std::string_view program_name, std::span<char*> arguments) {
+	bo::bench::GeneratorOptions options;
+	for (std::string_view argument : arguments) {
+		auto equals = argument.find('=');
+		auto name = argument.substr(0, equals);
+		auto value = equals == std::string_view::npos ? std::string_view {} : argument.substr(equals + 1);
+		bool is_valid = name == "--seed"        ? parse_number(value, options.seed)
+		              : name == "--functions"   ? parse_number(value, options.function_count)
+		              : name == "--depth"       ? parse_number(value, options.nesting_depth)
+		              : name == "--expression"  ? parse_number(value, options.expression_size)
+		              : name == "--parentheses" ? parse_number(value, options.parenthesis_depth)
+		              : name == "--overloads"   ? parse_number(value, options.overload_density) && options.overload_density <= 100
+		              : name == "--array-types" ? parse_number(value, options.array_type_count) && options.array_type_count > 0
+		              : name == "--locals"      ? parse_number(value, options.local_count)
+		                                        : false;
+		if (!is_valid) {
+			fmt::print(stderr, "Usage: {} generate [--seed=<n>] [--functions=<n>] [--depth=<n>] [--expression=<n>] [--parentheses=<n>] [--overloads=<percentage>] [--array-types=<n>] [--locals=<n>]\n", program_name);
+			return 1;
+		}
+	}
+
+	fmt::print("{}", bo::bench::generate_program(options));
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	constexpr std::string_view filter_option = "--filter=";
+	constexpr std::string_view min_time_option = "--min-time=";
+	constexpr std::string_view json_option = "--json=";
+
+	auto arguments = std::span { argv, static_cast<std::size_t>(argc) };
+	std::string_view program_name = arguments.empty() ? "boc-bench" : arguments[0];
+	if (arguments.size() >= 2 && std::string_view { arguments[1] } == "generate") {
+		return generate(program_name, arguments.subspan(2));
+	}
+
+	std::string_view filter;
+	double min_time = 0.5;
+	std::optional<std::string> json_path;
+	for (std::string_view argument : arguments.empty() ? arguments : arguments.subspan(1)) {
+		if (argument.starts_with(filter_option)) {
+			filter = argument.substr(filter_option.size());
+		} else if (argument.starts_with(min_time_option) && parse_number(argument.substr(min_time_option.size()), min_time)) {
+			continue;
+		} else if (argument.starts_with(json_option)) {
+			json_path = std::string { argument.substr(json_option.size()) };
+		} else {
+			fmt::print(stderr, "Usage: {} [--filter=<substring>] [--min-time=<seconds>] [--json=<file>]\n", program_name);
+			fmt::print(stderr, "       {} generate [--seed=<n>] [--functions=<n>] [--depth=<n>] [--expression=<n>] [--parentheses=<n>] [--overloads=<percentage>] [--array-types=<n>] [--locals=<n>]\n", program_name);
+			return 1;
+		}
+	}
+
+	// NOTE: Only the workloads that a selected benchmark runs on are generated,
+	//       the largest ones take a while.
+	auto workloads = make_workloads();
+	std::erase_if(workloads, [&](Workload const& workload) {
+		return std::ranges::none_of(benchmarks, [&](Benchmark const& benchmark) { return is_selected(benchmark, workload, filter); });
+	});
+	for (auto& workload : workloads) {
+		workload.source = bo::bench::generate_program(workload.options);
+	}
+
+	std::vector<BenchmarkResult> results;
+	fmt::print("{:<32} {:>10} {:>12} {:>12} {:>20}\n", "Benchmark", "Iterations", "Time (ms)", "CPU (ms)", "Rate (/s)");
+	for (auto const& workload : workloads) {
+		for (auto const& benchmark : benchmarks) {
+			if (!is_selected(benchmark, workload, filter)) {
+				continue;
+			}
+
+			auto name = fmt::format("{}/{}", benchmark.name, workload.name);
+			auto result = run_benchmark(benchmark, workload, min_time);
+			if (result.is_error()) {
+				fmt::print(stderr, "Error: {}: {}\n", name, result.error().message());
+				return 1;
+			}
+
+			auto const& value = result.value();
+			fmt::print("{:<32} {:>10} {:>12.3f} {:>12.3f} {:>20}\n", name, value.iterations, value.mean_wall_seconds * 1e3, value.mean_cpu_seconds * 1e3, fmt::format("{} {}", format_rate(static_cast<double>(value.items) / value.mean_wall_seconds), value.unit));
+			results.push_back(result.release_value());
+		}
+	}
+
+	if (json_path) {
+		if (auto result = bo::write_file(*json_path, results_to_json(workloads, results)); result.is_error()) {
+			fmt::print(stderr, "Error: {}\n", result.error().message());
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -58,7 +58,7 @@ void BooleanLiteral::dump() const {
 }
 
 void Identifier::dump() const {
-	fmt::print("{{\"node\":\"Identifier\",\"span\":[{},{}],\"id\":{:?}}}", span().start, span().end, m_id);
+	fmt::print("{{\"node\":\"Identifier\",\"span\":[{},{}],\"id\":{:?}}}", span().start, span().end, id());
 }
 
 void BinaryExpression::dump() const {
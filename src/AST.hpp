@@ -1,69 +1,108 @@
 #pragma once
 
 #include "Span.hpp"
+#include "Symbol.hpp"
 
-#include <memory>
-#include <vector>
+#include <cstdint>
+#include <span>
+#include <string_view>
 
 namespace bo {
 
 namespace AST {
 
+#define _BO_ENUMERATE_NODE_KINDS                       \
+	BO_ENUMERATE_NODE_KIND(ParenthesizedExpression)      \
+	BO_ENUMERATE_NODE_KIND(IntegerLiteral)               \
+	BO_ENUMERATE_NODE_KIND(CharLiteral)                  \
+	BO_ENUMERATE_NODE_KIND(BooleanLiteral)               \
+	BO_ENUMERATE_NODE_KIND(Identifier)                   \
+	BO_ENUMERATE_NODE_KIND(BinaryExpression)             \
+	BO_ENUMERATE_NODE_KIND(UnaryExpression)              \
+	BO_ENUMERATE_NODE_KIND(AssignmentExpression)         \
+	BO_ENUMERATE_NODE_KIND(UpdateExpression)             \
+	BO_ENUMERATE_NODE_KIND(PointerDereferenceExpression) \
+	BO_ENUMERATE_NODE_KIND(AddressOfExpression)          \
+	BO_ENUMERATE_NODE_KIND(RangeExpression)              \
+	BO_ENUMERATE_NODE_KIND(BlockExpression)              \
+	BO_ENUMERATE_NODE_KIND(IfExpression)                 \
+	BO_ENUMERATE_NODE_KIND(FunctionCallExpression)       \
+	BO_ENUMERATE_NODE_KIND(ArrayExpression)              \
+	BO_ENUMERATE_NODE_KIND(ArraySubscriptExpression)     \
+	BO_ENUMERATE_NODE_KIND(ExpressionStatement)          \
+	BO_ENUMERATE_NODE_KIND(VariableDeclarationStatement) \
+	BO_ENUMERATE_NODE_KIND(FunctionDeclarationStatement) \
+	BO_ENUMERATE_NODE_KIND(InfiniteForStatement)         \
+	BO_ENUMERATE_NODE_KIND(ForWithConditionStatement)    \
+	BO_ENUMERATE_NODE_KIND(ForWithRangeStatement)        \
+	BO_ENUMERATE_NODE_KIND(ReturnStatement)              \
+	BO_ENUMERATE_NODE_KIND(Type)                         \
+	BO_ENUMERATE_NODE_KIND(Program)
+
+// NOTE: The order of the kinds matters: expressions and statements are kept
+//       contiguous so that is_expression() and is_statement() are two compares.
+enum class Kind : std::uint8_t {
+#define BO_ENUMERATE_NODE_KIND(x) x,
+	_BO_ENUMERATE_NODE_KINDS
+#undef BO_ENUMERATE_NODE_KIND
+};
+
 class Node {
 public:
 	virtual ~Node() = default;
 
 	virtual void dump() const = 0;
-	virtual bool is_expression() const { return false; }
-	virtual bool is_statement() const { return false; }
 
+	bool is_expression() const { return m_kind >= Kind::ParenthesizedExpression && m_kind <= Kind::ArraySubscriptExpression; }
+	bool is_statement() const { return m_kind >= Kind::ExpressionStatement && m_kind <= Kind::ReturnStatement; }
+
+	Kind kind() const { return m_kind; }
 	Span span() const { return m_span; }
 
 protected:
-	explicit Node(Span span)
-	  : m_span(span) {}
+	explicit Node(Kind kind, Span span)
+	  : m_kind(kind), m_span(span) {}
 
+	Kind m_kind;
 	Span m_span;
 };
 
 class Expression : public Node {
 public:
-	virtual bool is_expression() const override { return true; }
-	virtual bool is_parenthesized_expression() const { return false; }
-	virtual bool is_integer_literal() const { return false; }
-	virtual bool is_char_literal() const { return false; }
-	virtual bool is_boolean_literal() const { return false; }
-	virtual bool is_identifier() const { return false; }
-	virtual bool is_binary_expression() const { return false; }
-	virtual bool is_unary_expression() const { return false; }
-	virtual bool is_assignment_expression() const { return false; }
-	virtual bool is_update_expression() const { return false; }
-	virtual bool is_pointer_dereference_expression() const { return false; }
-	virtual bool is_address_of_expression() const { return false; }
-	virtual bool is_range_expression() const { return false; }
-	virtual bool is_block_expression() const { return false; }
-	virtual bool is_if_expression() const { return false; }
-	virtual bool is_function_call_expression() const { return false; }
-	virtual bool is_array_expression() const { return false; }
-	virtual bool is_array_subscription_expression() const { return false; }
-	virtual bool has_block() const { return false; }
+	bool is_parenthesized_expression() const { return m_kind == Kind::ParenthesizedExpression; }
+	bool is_integer_literal() const { return m_kind == Kind::IntegerLiteral; }
+	bool is_char_literal() const { return m_kind == Kind::CharLiteral; }
+	bool is_boolean_literal() const { return m_kind == Kind::BooleanLiteral; }
+	bool is_identifier() const { return m_kind == Kind::Identifier; }
+	bool is_binary_expression() const { return m_kind == Kind::BinaryExpression; }
+	bool is_unary_expression() const { return m_kind == Kind::UnaryExpression; }
+	bool is_assignment_expression() const { return m_kind == Kind::AssignmentExpression; }
+	bool is_update_expression() const { return m_kind == Kind::UpdateExpression; }
+	bool is_pointer_dereference_expression() const { return m_kind == Kind::PointerDereferenceExpression; }
+	bool is_address_of_expression() const { return m_kind == Kind::AddressOfExpression; }
+	bool is_range_expression() const { return m_kind == Kind::RangeExpression; }
+	bool is_block_expression() const { return m_kind == Kind::BlockExpression; }
+	bool is_if_expression() const { return m_kind == Kind::IfExpression; }
+	bool is_function_call_expression() const { return m_kind == Kind::FunctionCallExpression; }
+	bool is_array_expression() const { return m_kind == Kind::ArrayExpression; }
+	bool is_array_subscription_expression() const { return m_kind == Kind::ArraySubscriptExpression; }
+	bool has_block() const { return m_kind == Kind::BlockExpression || m_kind == Kind::IfExpression; }
 
 protected:
-	explicit Expression(Span span)
-	  : Node(span) {}
+	explicit Expression(Kind kind, Span span)
+	  : Node(kind, span) {}
 };
 
 class Statement : public Node {
 public:
-	virtual bool is_statement() const override { return true; }
-	virtual bool is_expression_statement() const { return false; }
-	virtual bool is_variable_declaration() const { return false; }
-	virtual bool is_for_statement() const { return false; }
-	virtual bool is_return_statement() const { return false; }
+	bool is_expression_statement() const { return m_kind == Kind::ExpressionStatement; }
+	bool is_variable_declaration() const { return m_kind == Kind::VariableDeclarationStatement; }
+	bool is_for_statement() const { return m_kind >= Kind::InfiniteForStatement && m_kind <= Kind::ForWithRangeStatement; }
+	bool is_return_statement() const { return m_kind == Kind::ReturnStatement; }
 
 protected:
-	explicit Statement(Span span)
-	  : Node(span) {}
+	explicit Statement(Kind kind, Span span)
+	  : Node(kind, span) {}
 };
 
 #define _BO_ENUMERATE_TYPE_FLAGS             \
@@ -83,8 +122,8 @@ class Identifier;
 class IntegerLiteral;
 class Type : public Node {
 public:
-	explicit Type(std::shared_ptr<Type const> inner_type, std::shared_ptr<IntegerLiteral const> array_size, std::shared_ptr<Identifier const> name, int flags, Span span)
-	  : Node(span), m_inner_type(std::move(inner_type)), m_array_size(std::move(array_size)), m_name(std::move(name)), m_flags(flags) {}
+	explicit Type(Type const* inner_type, IntegerLiteral const* array_size, Identifier const* name, int flags, Span span)
+	  : Node(Kind::Type, span), m_inner_type(inner_type), m_array_size(array_size), m_name(name), m_flags(flags) {}
 
 	virtual void dump() const override;
 
@@ -97,29 +136,28 @@ public:
 	bool is_array() const { return m_flags & PF_IsArray; }
 	bool is_slice() const { return m_flags & PF_IsSlice; }
 
-	std::shared_ptr<Type const> inner_type() const { return m_inner_type; }
-	std::shared_ptr<IntegerLiteral const> array_size() const { return m_array_size; }
-	std::shared_ptr<Identifier const> name() const { return m_name; }
+	Type const* inner_type() const { return m_inner_type; }
+	IntegerLiteral const* array_size() const { return m_array_size; }
+	Identifier const* name() const { return m_name; }
 
 private:
-	std::shared_ptr<Type const> m_inner_type;
-	std::shared_ptr<IntegerLiteral const> m_array_size;
-	std::shared_ptr<Identifier const> m_name;
+	Type const* m_inner_type;
+	IntegerLiteral const* m_array_size;
+	Identifier const* m_name;
 	int m_flags;
 };
 
 class ParenthesizedExpression : public Expression {
 public:
-	explicit ParenthesizedExpression(std::shared_ptr<Expression const> expression, Span span)
-	  : Expression(span), m_expression(std::move(expression)) {}
+	explicit ParenthesizedExpression(Expression const* expression, Span span)
+	  : Expression(Kind::ParenthesizedExpression, span), m_expression(expression) {}
 
 	virtual void dump() const override;
-	virtual bool is_parenthesized_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> expression() const { return m_expression; }
+	Expression const* expression() const { return m_expression; }
 
 private:
-	std::shared_ptr<Expression const> m_expression;
+	Expression const* m_expression;
 };
 
 class IntegerLiteral : public Expression {
@@ -132,10 +170,9 @@ public:
 	};
 
 	explicit IntegerLiteral(std::string_view value, Type type, std::string_view suffix, Span span)
-	  : Expression(span), m_value(value), m_type(type), m_suffix(suffix) {}
+	  : Expression(Kind::IntegerLiteral, span), m_value(value), m_type(type), m_suffix(suffix) {}
 
 	virtual void dump() const override;
-	virtual bool is_integer_literal() const override { return true; }
 
 	std::string_view value() const { return m_value; }
 	Type type() const { return m_type; }
@@ -150,10 +187,9 @@ private:
 class CharLiteral : public Expression {
 public:
 	explicit CharLiteral(std::string_view value, Span span)
-	  : Expression(span), m_value(value) {}
+	  : Expression(Kind::CharLiteral, span), m_value(value) {}
 
 	virtual void dump() const override;
-	virtual bool is_char_literal() const override { return true; }
 
 	std::string_view value() const { return m_value; }
 
@@ -164,10 +200,9 @@ private:
 class BooleanLiteral : public Expression {
 public:
 	explicit BooleanLiteral(bool value, Span span)
-	  : Expression(span), m_value(value) {}
+	  : Expression(Kind::BooleanLiteral, span), m_value(value) {}
 
 	virtual void dump() const override;
-	virtual bool is_boolean_literal() const override { return true; }
 
 	bool value() const { return m_value; }
 
@@ -177,16 +212,16 @@ private:
 
 class Identifier : public Expression {
 public:
-	explicit Identifier(std::string_view id, Span span)
-	  : Expression(span), m_id(id) {}
+	explicit Identifier(Symbol symbol, Span span)
+	  : Expression(Kind::Identifier, span), m_symbol(symbol) {}
 
 	virtual void dump() const override;
-	virtual bool is_identifier() const override { return true; }
 
-	std::string_view id() const { return m_id; }
+	std::string_view id() const { return m_symbol.view(); }
+	Symbol symbol() const { return m_symbol; }
 
 private:
-	std::string_view m_id;
+	Symbol m_symbol;
 };
 
 #define _BO_ENUMERATE_BINARY_OPERATORS               \
@@ -217,19 +252,18 @@ enum class BinaryOperator {
 
 class BinaryExpression : public Expression {
 public:
-	explicit BinaryExpression(std::shared_ptr<Expression const> lhs, std::shared_ptr<Expression const> rhs, BinaryOperator op, Span span)
-	  : Expression(span), m_lhs(std::move(lhs)), m_rhs(std::move(rhs)), m_op(op) {}
+	explicit BinaryExpression(Expression const* lhs, Expression const* rhs, BinaryOperator op, Span span)
+	  : Expression(Kind::BinaryExpression, span), m_lhs(lhs), m_rhs(rhs), m_op(op) {}
 
 	virtual void dump() const override;
-	virtual bool is_binary_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> lhs() const { return m_lhs; }
-	std::shared_ptr<Expression const> rhs() const { return m_rhs; }
+	Expression const* lhs() const { return m_lhs; }
+	Expression const* rhs() const { return m_rhs; }
 	BinaryOperator op() const { return m_op; }
 
 private:
-	std::shared_ptr<Expression const> m_lhs;
-	std::shared_ptr<Expression const> m_rhs;
+	Expression const* m_lhs;
+	Expression const* m_rhs;
 	BinaryOperator m_op;
 };
 
@@ -247,17 +281,16 @@ enum class UnaryOperator {
 
 class UnaryExpression : public Expression {
 public:
-	explicit UnaryExpression(std::shared_ptr<Expression const> operand, UnaryOperator op, Span span)
-	  : Expression(span), m_operand(std::move(operand)), m_op(op) {}
+	explicit UnaryExpression(Expression const* operand, UnaryOperator op, Span span)
+	  : Expression(Kind::UnaryExpression, span), m_operand(operand), m_op(op) {}
 
 	virtual void dump() const override;
-	virtual bool is_unary_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> operand() const { return m_operand; }
+	Expression const* operand() const { return m_operand; }
 	UnaryOperator op() const { return m_op; }
 
 private:
-	std::shared_ptr<Expression const> m_operand;
+	Expression const* m_operand;
 	UnaryOperator m_op;
 };
 
@@ -284,19 +317,18 @@ enum class AssignmentOperator {
 
 class AssignmentExpression : public Expression {
 public:
-	explicit AssignmentExpression(std::shared_ptr<Expression const> lhs, std::shared_ptr<Expression const> rhs, AssignmentOperator op, Span span)
-	  : Expression(span), m_lhs(std::move(lhs)), m_rhs(std::move(rhs)), m_op(op) {}
+	explicit AssignmentExpression(Expression const* lhs, Expression const* rhs, AssignmentOperator op, Span span)
+	  : Expression(Kind::AssignmentExpression, span), m_lhs(lhs), m_rhs(rhs), m_op(op) {}
 
 	virtual void dump() const override;
-	virtual bool is_assignment_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> lhs() const { return m_lhs; }
-	std::shared_ptr<Expression const> rhs() const { return m_rhs; }
+	Expression const* lhs() const { return m_lhs; }
+	Expression const* rhs() const { return m_rhs; }
 	AssignmentOperator op() const { return m_op; }
 
 private:
-	std::shared_ptr<Expression const> m_lhs;
-	std::shared_ptr<Expression const> m_rhs;
+	Expression const* m_lhs;
+	Expression const* m_rhs;
 	AssignmentOperator m_op;
 };
 
@@ -312,295 +344,277 @@ enum class UpdateOperator {
 
 class UpdateExpression : public Expression {
 public:
-	explicit UpdateExpression(std::shared_ptr<Expression const> operand, UpdateOperator op, bool is_prefixed, Span span)
-	  : Expression(span), m_operand(std::move(operand)), m_op(op), m_is_prefixed(is_prefixed) {}
+	explicit UpdateExpression(Expression const* operand, UpdateOperator op, bool is_prefixed, Span span)
+	  : Expression(Kind::UpdateExpression, span), m_operand(operand), m_op(op), m_is_prefixed(is_prefixed) {}
 
 	virtual void dump() const override;
-	virtual bool is_update_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> operand() const { return m_operand; }
+	Expression const* operand() const { return m_operand; }
 	UpdateOperator op() const { return m_op; }
 	bool is_prefixed() const { return m_is_prefixed; }
 
 private:
-	std::shared_ptr<Expression const> m_operand;
+	Expression const* m_operand;
 	UpdateOperator m_op;
 	bool m_is_prefixed;
 };
 
 class PointerDereferenceExpression : public Expression {
 public:
-	explicit PointerDereferenceExpression(std::shared_ptr<Expression const> operand, Span span)
-	  : Expression(span), m_operand(std::move(operand)) {}
+	explicit PointerDereferenceExpression(Expression const* operand, Span span)
+	  : Expression(Kind::PointerDereferenceExpression, span), m_operand(operand) {}
 
 	virtual void dump() const override;
-	virtual bool is_pointer_dereference_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> operand() const { return m_operand; }
+	Expression const* operand() const { return m_operand; }
 
 private:
-	std::shared_ptr<Expression const> m_operand;
+	Expression const* m_operand;
 };
 
 class AddressOfExpression : public Expression {
 public:
-	explicit AddressOfExpression(std::shared_ptr<Expression const> operand, Span span)
-	  : Expression(span), m_operand(std::move(operand)) {}
+	explicit AddressOfExpression(Expression const* operand, Span span)
+	  : Expression(Kind::AddressOfExpression, span), m_operand(operand) {}
 
 	virtual void dump() const override;
-	virtual bool is_address_of_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> operand() const { return m_operand; }
+	Expression const* operand() const { return m_operand; }
 
 private:
-	std::shared_ptr<Expression const> m_operand;
+	Expression const* m_operand;
 };
 
 class RangeExpression : public Expression {
 public:
-	explicit RangeExpression(std::shared_ptr<Expression const> start, std::shared_ptr<Expression const> end, bool is_inclusive, Span span)
-	  : Expression(span), m_start(std::move(start)), m_end(std::move(end)), m_is_inclusive(is_inclusive) {}
+	explicit RangeExpression(Expression const* start, Expression const* end, bool is_inclusive, Span span)
+	  : Expression(Kind::RangeExpression, span), m_start(start), m_end(end), m_is_inclusive(is_inclusive) {}
 
 	virtual void dump() const override;
-	virtual bool is_range_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> start() const { return m_start; }
-	std::shared_ptr<Expression const> end() const { return m_end; }
+	Expression const* start() const { return m_start; }
+	Expression const* end() const { return m_end; }
 	bool is_inclusive() const { return m_is_inclusive; }
 
 private:
-	std::shared_ptr<Expression const> m_start;
-	std::shared_ptr<Expression const> m_end;
+	Expression const* m_start;
+	Expression const* m_end;
 	bool m_is_inclusive;
 };
 
 class BlockExpression : public Expression {
 public:
-	explicit BlockExpression(std::vector<std::shared_ptr<Statement const>> statements, Span span)
-	  : Expression(span), m_statements(std::move(statements)) {}
+	explicit BlockExpression(std::span<Statement const* const> statements, Span span)
+	  : Expression(Kind::BlockExpression, span), m_statements(statements) {}
 
 	virtual void dump() const override;
-	virtual bool is_block_expression() const override { return true; }
-	virtual bool has_block() const override { return true; }
 
-	std::vector<std::shared_ptr<Statement const>> const& statements() const { return m_statements; }
+	std::span<Statement const* const> statements() const { return m_statements; }
 
 private:
-	std::vector<std::shared_ptr<Statement const>> m_statements;
+	std::span<Statement const* const> m_statements;
 };
 
 class IfExpression : public Expression {
 public:
-	explicit IfExpression(std::shared_ptr<Expression const> condition, std::shared_ptr<BlockExpression const> then, std::shared_ptr<Expression const> else_, Span span)
-	  : Expression(span), m_condition(std::move(condition)), m_then(std::move(then)), m_else(std::move(else_)) {}
+	explicit IfExpression(Expression const* condition, BlockExpression const* then, Expression const* else_, Span span)
+	  : Expression(Kind::IfExpression, span), m_condition(condition), m_then(then), m_else(else_) {}
 
 	virtual void dump() const override;
-	virtual bool is_if_expression() const override { return true; }
-	virtual bool has_block() const override { return true; }
 
-	std::shared_ptr<Expression const> condition() const { return m_condition; }
-	std::shared_ptr<BlockExpression const> then() const { return m_then; }
-	std::shared_ptr<Expression const> else_() const { return m_else; }
+	Expression const* condition() const { return m_condition; }
+	BlockExpression const* then() const { return m_then; }
+	Expression const* else_() const { return m_else; }
 
 private:
-	std::shared_ptr<Expression const> m_condition;
-	std::shared_ptr<BlockExpression const> m_then;
-	std::shared_ptr<Expression const> m_else;
+	Expression const* m_condition;
+	BlockExpression const* m_then;
+	Expression const* m_else;
 };
 
 struct FunctionArgument {
-	std::shared_ptr<Identifier const> name;
-	std::shared_ptr<Expression const> value;
+	Identifier const* name;
+	Expression const* value;
 };
 
 class FunctionCallExpression : public Expression {
 public:
-	explicit FunctionCallExpression(std::shared_ptr<Identifier const> name, std::vector<FunctionArgument> arguments, Span span)
-	  : Expression(span), m_name(std::move(name)), m_arguments(std::move(arguments)) {}
+	explicit FunctionCallExpression(Identifier const* name, std::span<FunctionArgument const> arguments, Span span)
+	  : Expression(Kind::FunctionCallExpression, span), m_name(name), m_arguments(arguments) {}
 
 	virtual void dump() const override;
-	virtual bool is_function_call_expression() const override { return true; }
 
-	std::shared_ptr<Identifier const> name() const { return m_name; }
-	std::vector<FunctionArgument> const& arguments() const { return m_arguments; }
+	Identifier const* name() const { return m_name; }
+	std::span<FunctionArgument const> arguments() const { return m_arguments; }
 
 private:
-	std::shared_ptr<Identifier const> m_name;
-	std::vector<FunctionArgument> m_arguments;
+	Identifier const* m_name;
+	std::span<FunctionArgument const> m_arguments;
 };
 
 class ArrayExpression : public Expression {
 public:
-	explicit ArrayExpression(std::vector<std::shared_ptr<Expression const>> elements, Span span)
-	  : Expression(span), m_elements(std::move(elements)) {}
+	explicit ArrayExpression(std::span<Expression const* const> elements, Span span)
+	  : Expression(Kind::ArrayExpression, span), m_elements(elements) {}
 
 	virtual void dump() const override;
-	virtual bool is_array_expression() const override { return true; }
 
-	std::vector<std::shared_ptr<Expression const>> const& elements() const { return m_elements; }
+	std::span<Expression const* const> elements() const { return m_elements; }
 
 private:
-	std::vector<std::shared_ptr<Expression const>> m_elements;
+	std::span<Expression const* const> m_elements;
 };
 
 class ArraySubscriptExpression : public Expression {
 public:
-	explicit ArraySubscriptExpression(std::shared_ptr<Expression const> array, std::shared_ptr<Expression const> index, Span span)
-	  : Expression(span), m_array(std::move(array)), m_index(std::move(index)) {}
+	explicit ArraySubscriptExpression(Expression const* array, Expression const* index, Span span)
+	  : Expression(Kind::ArraySubscriptExpression, span), m_array(array), m_index(index) {}
 
 	virtual void dump() const override;
-	virtual bool is_array_subscription_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> array() const { return m_array; }
-	std::shared_ptr<Expression const> index() const { return m_index; }
+	Expression const* array() const { return m_array; }
+	Expression const* index() const { return m_index; }
 
 private:
-	std::shared_ptr<Expression const> m_array;
-	std::shared_ptr<Expression const> m_index;
+	Expression const* m_array;
+	Expression const* m_index;
 };
 
 class ExpressionStatement : public Statement {
 public:
-	explicit ExpressionStatement(std::shared_ptr<Expression const> expression, bool ends_with_semicolon, Span span)
-	  : Statement(span), m_expression(std::move(expression)), m_ends_with_semicolon(ends_with_semicolon) {}
+	explicit ExpressionStatement(Expression const* expression, bool ends_with_semicolon, Span span)
+	  : Statement(Kind::ExpressionStatement, span), m_expression(expression), m_ends_with_semicolon(ends_with_semicolon) {}
 
-	virtual bool is_expression_statement() const override { return true; }
 	virtual void dump() const override;
 
-	std::shared_ptr<Expression const> expression() const { return m_expression; }
+	Expression const* expression() const { return m_expression; }
 	bool ends_with_semicolon() const { return m_ends_with_semicolon; }
 
 private:
-	std::shared_ptr<Expression const> m_expression;
+	Expression const* m_expression;
 	bool m_ends_with_semicolon;
 };
 
 class VariableDeclarationStatement : public Statement {
 public:
-	explicit VariableDeclarationStatement(bool is_mutable, std::shared_ptr<Identifier const> identifier, std::shared_ptr<Type const> type, std::shared_ptr<Expression const> initializer, Span span)
-	  : Statement(span), m_is_mutable(is_mutable), m_identifier(std::move(identifier)), m_type(std::move(type)), m_initializer(std::move(initializer)) {}
+	explicit VariableDeclarationStatement(bool is_mutable, Identifier const* identifier, Type const* type, Expression const* initializer, Span span)
+	  : Statement(Kind::VariableDeclarationStatement, span), m_is_mutable(is_mutable), m_identifier(identifier), m_type(type), m_initializer(initializer) {}
 
 	virtual void dump() const override;
-	virtual bool is_variable_declaration() const override { return true; }
 
 	bool is_mutable() const { return m_is_mutable; }
-	std::shared_ptr<Identifier const> identifier() const { return m_identifier; }
-	std::shared_ptr<Type const> type() const { return m_type; }
-	std::shared_ptr<Expression const> initializer() const { return m_initializer; }
+	Identifier const* identifier() const { return m_identifier; }
+	Type const* type() const { return m_type; }
+	Expression const* initializer() const { return m_initializer; }
 
 private:
 	bool m_is_mutable;
-	std::shared_ptr<Identifier const> m_identifier;
-	std::shared_ptr<Type const> m_type;
-	std::shared_ptr<Expression const> m_initializer;
+	Identifier const* m_identifier;
+	Type const* m_type;
+	Expression const* m_initializer;
 };
 
 struct FunctionParameter {
-	std::shared_ptr<Identifier const> name;
-	std::shared_ptr<Type const> type;
+	Identifier const* name;
+	Type const* type;
 	bool is_anonymous;
 };
 
 class FunctionDeclarationStatement : public Statement {
 public:
-	explicit FunctionDeclarationStatement(std::shared_ptr<Identifier const> name, std::vector<FunctionParameter> parameters, std::shared_ptr<Type const> return_type, std::shared_ptr<BlockExpression const> body, Span span)
-	  : Statement(span), m_name(std::move(name)), m_parameters(std::move(parameters)), m_return_type(return_type), m_body(std::move(body)) {}
+	explicit FunctionDeclarationStatement(Identifier const* name, std::span<FunctionParameter const> parameters, Type const* return_type, BlockExpression const* body, Span span)
+	  : Statement(Kind::FunctionDeclarationStatement, span), m_name(name), m_parameters(parameters), m_return_type(return_type), m_body(body) {}
 
 	virtual void dump() const override;
 
-	std::shared_ptr<Identifier const> name() const { return m_name; }
-	std::vector<FunctionParameter> const& parameters() const { return m_parameters; }
-	std::shared_ptr<Type const> return_type() const { return m_return_type; }
-	std::shared_ptr<BlockExpression const> body() const { return m_body; }
+	Identifier const* name() const { return m_name; }
+	std::span<FunctionParameter const> parameters() const { return m_parameters; }
+	Type const* return_type() const { return m_return_type; }
+	BlockExpression const* body() const { return m_body; }
 
 private:
-	std::shared_ptr<Identifier const> m_name;
-	std::vector<FunctionParameter> m_parameters;
-	std::shared_ptr<Type const> m_return_type;
-	std::shared_ptr<BlockExpression const> m_body;
+	Identifier const* m_name;
+	std::span<FunctionParameter const> m_parameters;
+	Type const* m_return_type;
+	BlockExpression const* m_body;
 };
 
 class ForStatement : public Statement {
 public:
-	virtual bool is_for_statement() const override { return true; }
-	virtual bool is_infinite() const { return false; }
-	virtual bool is_with_condition() const { return false; }
-	virtual bool is_with_range() const { return false; }
+	bool is_infinite() const { return m_kind == Kind::InfiniteForStatement; }
+	bool is_with_condition() const { return m_kind == Kind::ForWithConditionStatement; }
+	bool is_with_range() const { return m_kind == Kind::ForWithRangeStatement; }
 
-	std::shared_ptr<BlockExpression const> body() const { return m_body; }
+	BlockExpression const* body() const { return m_body; }
 
 protected:
-	explicit ForStatement(std::shared_ptr<BlockExpression const> body, Span span)
-	  : Statement(span), m_body(std::move(body)) {}
+	explicit ForStatement(Kind kind, BlockExpression const* body, Span span)
+	  : Statement(kind, span), m_body(body) {}
 
-	std::shared_ptr<BlockExpression const> m_body;
+	BlockExpression const* m_body;
 };
 
 class InfiniteForStatement : public ForStatement {
 public:
-	explicit InfiniteForStatement(std::shared_ptr<BlockExpression const> body, Span span)
-	  : ForStatement(body, span) {}
+	explicit InfiniteForStatement(BlockExpression const* body, Span span)
+	  : ForStatement(Kind::InfiniteForStatement, body, span) {}
 
 	virtual void dump() const override;
-	virtual bool is_infinite() const override { return true; }
 };
 
 class ForWithConditionStatement : public ForStatement {
 public:
-	explicit ForWithConditionStatement(std::shared_ptr<Expression const> condition, std::shared_ptr<BlockExpression const> body, Span span)
-	  : ForStatement(body, span), m_condition(condition) {}
+	explicit ForWithConditionStatement(Expression const* condition, BlockExpression const* body, Span span)
+	  : ForStatement(Kind::ForWithConditionStatement, body, span), m_condition(condition) {}
 
 	virtual void dump() const override;
-	virtual bool is_with_condition() const override { return true; }
 
-	std::shared_ptr<Expression const> condition() const { return m_condition; }
+	Expression const* condition() const { return m_condition; }
 
 private:
-	std::shared_ptr<Expression const> m_condition;
+	Expression const* m_condition;
 };
 
 class ForWithRangeStatement : public ForStatement {
 public:
-	explicit ForWithRangeStatement(std::shared_ptr<Identifier const> range_variable, std::shared_ptr<Expression const> range_expression, std::shared_ptr<BlockExpression const> body, Span span)
-	  : ForStatement(body, span), m_range_variable(std::move(range_variable)), m_range_expression(std::move(range_expression)) {}
+	explicit ForWithRangeStatement(Identifier const* range_variable, Expression const* range_expression, BlockExpression const* body, Span span)
+	  : ForStatement(Kind::ForWithRangeStatement, body, span), m_range_variable(range_variable), m_range_expression(range_expression) {}
 
 	virtual void dump() const override;
-	virtual bool is_with_range() const override { return true; }
 
-	std::shared_ptr<Identifier const> range_variable() const { return m_range_variable; }
-	std::shared_ptr<Expression const> range_expression() const { return m_range_expression; }
+	Identifier const* range_variable() const { return m_range_variable; }
+	Expression const* range_expression() const { return m_range_expression; }
 
 private:
-	std::shared_ptr<Identifier const> m_range_variable;
-	std::shared_ptr<Expression const> m_range_expression;
+	Identifier const* m_range_variable;
+	Expression const* m_range_expression;
 };
 
 class ReturnStatement : public Statement {
 public:
-	explicit ReturnStatement(std::shared_ptr<Expression const> expression, Span span)
-	  : Statement(span), m_expression(std::move(expression)) {}
+	explicit ReturnStatement(Expression const* expression, Span span)
+	  : Statement(Kind::ReturnStatement, span), m_expression(expression) {}
 
 	virtual void dump() const override;
-	virtual bool is_return_statement() const override { return true; }
 
-	std::shared_ptr<Expression const> expression() const { return m_expression; }
+	Expression const* expression() const { return m_expression; }
 
 private:
-	std::shared_ptr<Expression const> m_expression;
+	Expression const* m_expression;
 };
 
 class Program : public Node {
 public:
-	explicit Program(std::vector<std::shared_ptr<FunctionDeclarationStatement const>> functions, Span span)
-	  : Node(span), m_functions(std::move(functions)) {}
+	explicit Program(std::span<FunctionDeclarationStatement const* const> functions, Span span)
+	  : Node(Kind::Program, span), m_functions(functions) {}
 
 	virtual void dump() const override;
 
-	std::vector<std::shared_ptr<FunctionDeclarationStatement const>> const& function_declarations() const { return m_functions; }
+	std::span<FunctionDeclarationStatement const* const> function_declarations() const { return m_functions; }
 
 private:
 	// FIXME: Change to a specific node which will contain all the top level statements
-	std::vector<std::shared_ptr<FunctionDeclarationStatement const>> m_functions;
+	std::span<FunctionDeclarationStatement const* const> m_functions;
 };
 
 }
@@ -0,0 +1,72 @@
+#include "AllocationCounter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace bo {
+
+namespace AllocationCounter {
+
+static std::atomic<bool> s_is_enabled { false };
+static std::atomic<std::size_t> s_allocations { 0 };
+static std::atomic<std::size_t> s_bytes { 0 };
+
+void enable() {
+	s_is_enabled.store(true, std::memory_order_relaxed);
+}
+
+Totals totals() {
+	return { s_allocations.load(std::memory_order_relaxed), s_bytes.load(std::memory_order_relaxed) };
+}
+
+static void count(std::size_t size) {
+	if (s_is_enabled.load(std::memory_order_relaxed)) [[unlikely]] {
+		s_allocations.fetch_add(1, std::memory_order_relaxed);
+		s_bytes.fetch_add(size, std::memory_order_relaxed);
+	}
+}
+
+}
+
+}
+
+// NOTE: The array and nothrow forms are defined by the standard library in
+//       terms of these, so replacing the plain and the aligned forms (and the
+//       matching deletes) is enough to see every allocation.
+void* operator new(std::size_t size) {
+	bo::AllocationCounter::count(size);
+	if (auto* memory = std::malloc(size == 0 ? 1 : size)) {
+		return memory;
+	}
+
+	throw std::bad_alloc {};
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	bo::AllocationCounter::count(size);
+	auto align = static_cast<std::size_t>(alignment);
+	auto rounded_size = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+	if (auto* memory = std::aligned_alloc(align, rounded_size)) {
+		return memory;
+	}
+
+	throw std::bad_alloc {};
+}
+
+void operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+	std::free(memory);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+namespace bo {
+
+// NOTE: boc replaces the global operator new to count heap allocations, for
+//       --time-report. Counting is off until enabled, which leaves a single
+//       relaxed load on the allocation path.
+namespace AllocationCounter {
+
+struct Totals {
+	std::size_t allocations { 0 };
+	std::size_t bytes { 0 };
+};
+
+void enable();
+Totals totals();
+
+}
+
+}
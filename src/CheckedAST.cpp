@@ -207,7 +207,7 @@ void FunctionCallExpression::dump(Program const& program) const {
 		auto const& argument = m_arguments[i];
 
 		fmt::print("{{");
-		fmt::print("\"name\":{:?}", argument.name);
+		fmt::print("\"name\":{:?}", argument.name.view());
 		fmt::print(",");
 		fmt::print("\"value\":");
 		argument.value->dump(program);
@@ -277,7 +277,7 @@ void Function::dump(Program const& program) const {
 	fmt::print(",\"type\":");
 	program.dump_type(type_id());
 	fmt::print(",\"span\":[{},{}]", span().start, span().end);
-	fmt::print(",\"name\":{:?}", m_name);
+	fmt::print(",\"name\":{:?}", m_name.view());
 	fmt::print(",\"return_type\":");
 	program.dump_type(m_return_type_id);
 	fmt::print(",\"parameters\":[");
@@ -352,57 +352,41 @@ void ReturnStatement::dump(Program const& program) const {
 Program::Program() {
 	using namespace std::literals;
 
-#define BO_ENUMERATE_BUILTIN_TYPE(klass_name, type_name) m_types.push_back(Types::Type::builtin_##type_name());
+#define BO_ENUMERATE_BUILTIN_TYPE(klass_name, type_name) find_or_add_type(Types::Type::builtin_##type_name());
 	_BO_ENUMERATE_BUILTIN_TYPES
 #undef BO_ENUMERATE_BUILTIN_TYPE
 
-#define BO_ENUMERATE_BUILTIN_TYPE(klass_name, type_name)                                                                                    \
-	if constexpr (#type_name != "unknown"sv) {                                                                                                \
-		auto scope_id = create_scope();                                                                                                         \
-		auto parameters = std::vector<FunctionParameter> { { Variable { Types::builtin_##type_name##_id, "value", Span(), scope_id }, true } }; \
-		m_functions.push_back(std::make_shared<Function const>("print", std::move(parameters), Types::builtin_void_id, nullptr, true, Span())); \
+	auto print = Symbol::intern("print");
+	auto value = Symbol::intern("value");
+#define BO_ENUMERATE_BUILTIN_TYPE(klass_name, type_name)                                                                                  \
+	if constexpr (#type_name != "unknown"sv) {                                                                                              \
+		auto scope_id = create_function_scope(m_functions.size());                                                                            \
+		auto parameters = std::vector<FunctionParameter> { { Variable { Types::builtin_##type_name##_id, value, Span(), scope_id }, true } }; \
+		m_functions.push_back(m_arena.make<Function>(print, m_arena.make_array(parameters), Types::builtin_void_id, nullptr, true, Span()));  \
+		index_function(m_functions.size() - 1);                                                                                               \
 	}
 	_BO_ENUMERATE_BUILTIN_TYPES
 #undef BO_ENUMERATE_BUILTIN_TYPE
 }
 
-Types::Id Program::find_or_add_type(Types::Type type) {
-	auto it = std::find(m_types.begin(), m_types.end(), type);
-
-	if (it != m_types.end()) {
-		return static_cast<Types::Id>(std::distance(m_types.begin(), it));
-	}
-
-	m_types.push_back(type);
-	return static_cast<Types::Id>(m_types.size() - 1);
+Types::Id Program::find_or_add_type(Types::Type const& type) {
+	return m_types.intern(type);
 }
 
 Types::Id Program::apply_mutability(Types::Id type_id, bool is_mutable) {
-	return find_or_add_type(Types::Type::apply_mutability(m_types[type_id], is_mutable));
-}
-
-Types::Type const& Program::get_type(Types::Id type_id) const {
-	return m_types[type_id];
+	return find_or_add_type(Types::Type::apply_mutability(m_types.get(type_id), is_mutable));
 }
 
-std::optional<std::size_t> Program::find_variable(std::string_view name, std::size_t scope_id) const {
-	for (std::size_t variable_id = 0; variable_id < m_variables.size(); ++variable_id) {
-		if (m_variables[variable_id].name != name) {
-			continue;
+std::optional<std::size_t> Program::find_variable(Symbol name, std::size_t scope_id) const {
+	auto const& locals = m_locals[function_of(scope_id)];
+	std::optional<std::size_t> current_scope_id = scope_id;
+	while (current_scope_id) {
+		auto const& scope = locals.scopes[local_index_of(*current_scope_id)];
+		if (auto variable_id = scope.find_variable(name)) {
+			return variable_id;
 		}
 
-		std::size_t current_scope_id = scope_id;
-		while (true) {
-			if (current_scope_id == m_variables[variable_id].owner_scope_id) {
-				return variable_id;
-			}
-
-			if (!m_scopes[current_scope_id].parent()) {
-				break;
-			}
-
-			current_scope_id = *m_scopes[current_scope_id].parent();
-		}
+		current_scope_id = scope.parent();
 	}
 
 	return std::nullopt;
@@ -410,57 +394,100 @@ std::optional<std::size_t> Program::find_variable(std::string_view name, std::si
 
 std::size_t Program::define_variable(Variable variable) {
 	assert(!find_variable(variable.name, variable.owner_scope_id));
-	m_variables.push_back(variable);
-	return m_variables.size() - 1;
+	auto function_id = function_of(variable.owner_scope_id);
+	auto& locals = m_locals[function_id];
+	auto variable_id = make_local_id(function_id, locals.variables.size());
+	locals.variables.push_back(variable);
+	locals.scopes[local_index_of(variable.owner_scope_id)].add_variable(variable.name, variable_id);
+	return variable_id;
 }
 
-std::size_t Program::create_scope(std::optional<std::size_t> parent) {
-	m_scopes.emplace_back(parent);
-	return m_scopes.size() - 1;
+std::size_t Program::create_function_scope(std::size_t function_id) {
+	if (m_locals.size() <= function_id) {
+		m_locals.resize(function_id + 1);
+	}
+
+	auto& scopes = m_locals[function_id].scopes;
+	scopes.emplace_back(std::nullopt);
+	return make_local_id(function_id, scopes.size() - 1);
 }
 
-std::optional<std::size_t> Program::find_function(std::string_view name, std::vector<Types::Id> const& signature) const {
-	for (std::size_t i = 0; i < m_functions.size(); ++i) {
-		if (m_functions[i]->name() != name) {
-			continue;
-		}
+std::size_t Program::create_scope(std::size_t parent) {
+	auto function_id = function_of(parent);
+	auto& scopes = m_locals[function_id].scopes;
+	scopes.emplace_back(parent);
+	return make_local_id(function_id, scopes.size() - 1);
+}
 
-		auto const& parameters = m_functions[i]->parameters();
+std::optional<std::size_t> Program::find_function(Symbol name, std::vector<Types::Id> const& signature) const {
+	auto overloads = m_function_overloads.find(name);
+	if (overloads == m_function_overloads.end() || signature.size() >= overloads->second.size()) {
+		return {};
+	}
 
-		if (parameters.size() != signature.size()) {
-			continue;
-		}
+	auto const& same_arity_overloads = overloads->second[signature.size()];
+	if (auto it = same_arity_overloads.find(signature); it != same_arity_overloads.end()) {
+		return it->second;
+	}
 
-		bool signature_match = true;
-		for (std::size_t j = 0; j < parameters.size(); ++j) {
-			if (parameters[j].variable.type_id != signature[j]) {
-				signature_match = false;
-				break;
-			}
-		}
+	return {};
+}
 
-		if (signature_match) {
-			return i;
-		}
+std::size_t Program::add_function(Function const* function) {
+	m_functions.push_back(function);
+	index_function(m_functions.size() - 1);
+	m_span = Span::merge(m_span, m_functions.back()->span());
+	return m_functions.size() - 1;
+}
+
+// NOTE: Only used to swap a signature-only function for its checked version,
+//       which keeps the same name and parameters.
+void Program::replace_function(std::size_t id, Function const* function) {
+	m_functions[id] = function;
+}
+
+Arena& Program::create_arena() {
+	m_worker_arenas.push_back(std::make_unique<Arena>());
+	return *m_worker_arenas.back();
+}
+
+std::size_t Program::node_count() const {
+	auto count = m_arena.object_count();
+	for (auto const& arena : m_worker_arenas) {
+		count += arena->object_count();
 	}
 
-	return {};
+	return count;
 }
 
-std::size_t Program::add_function(std::shared_ptr<Function const> function) {
+std::size_t Program::node_bytes() const {
+	auto bytes = m_arena.bytes_allocated();
+	for (auto const& arena : m_worker_arenas) {
+		bytes += arena->bytes_allocated();
+	}
+
+	return bytes;
+}
+
+void Program::index_function(std::size_t id) {
+	auto const& function = m_functions[id];
+
 	std::vector<Types::Id> signature;
 	for (auto const& parameter : function->parameters()) {
 		signature.push_back(parameter.variable.type_id);
 	}
 
-	assert(!find_function(function->name(), signature));
-	m_functions.push_back(std::move(function));
-	m_span = Span::merge(m_span, m_functions.back()->span());
-	return m_functions.size() - 1;
+	auto& overloads = m_function_overloads[function->name()];
+	if (overloads.size() <= signature.size()) {
+		overloads.resize(signature.size() + 1);
+	}
+
+	[[maybe_unused]] auto [_, inserted] = overloads[signature.size()].try_emplace(std::move(signature), id);
+	assert(inserted);
 }
 
 void Program::dump_type(Types::Id id) const {
-	auto const& type = m_types[id];
+	auto const& type = m_types.get(id);
 
 	if (type.is_builtin()) {
 #define BO_ENUMERATE_BUILTIN_TYPE(klass_name, type_name) \
@@ -503,7 +530,7 @@ void Program::dump_type(Types::Id id) const {
 
 void Program::dump_variable(Variable const& variable) const {
 	fmt::print("{{");
-	fmt::print("\"name\":{:?}", variable.name);
+	fmt::print("\"name\":{:?}", variable.name.view());
 	fmt::print(",\"type\":");
 	dump_type(variable.type_id);
 	fmt::print(",\"declaration_span\":[{},{}]", variable.declaration_span.start, variable.declaration_span.end);
@@ -2,9 +2,18 @@
 
 #include "AST.hpp"
 #include "Span.hpp"
+#include "Symbol.hpp"
 #include "Types.hpp"
+#include "utils/Arena.hpp"
+#include "utils/ConcurrentInterner.hpp"
+#include "utils/Hash.hpp"
 
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace bo {
@@ -18,17 +27,63 @@ public:
 
 	std::optional<std::size_t> parent() const { return m_parent; }
 
+	std::optional<std::size_t> find_variable(Symbol name) const {
+		auto it = m_variables.find(name);
+		if (it == m_variables.end()) {
+			return {};
+		}
+
+		return it->second;
+	}
+
+	void add_variable(Symbol name, std::size_t variable_id) { m_variables.emplace(name, variable_id); }
+
 private:
 	std::optional<std::size_t> m_parent;
+	std::unordered_map<Symbol, std::size_t> m_variables;
 };
 
 struct Variable {
 	Types::Id type_id;
-	std::string_view name;
+	Symbol name;
 	Span declaration_span;
 	std::size_t owner_scope_id;
 };
 
+#define _BO_ENUMERATE_CHECKED_NODE_KINDS               \
+	BO_ENUMERATE_NODE_KIND(ParenthesizedExpression)      \
+	BO_ENUMERATE_NODE_KIND(IntegerLiteral)               \
+	BO_ENUMERATE_NODE_KIND(CharLiteral)                  \
+	BO_ENUMERATE_NODE_KIND(BooleanLiteral)               \
+	BO_ENUMERATE_NODE_KIND(Identifier)                   \
+	BO_ENUMERATE_NODE_KIND(BinaryExpression)             \
+	BO_ENUMERATE_NODE_KIND(UnaryExpression)              \
+	BO_ENUMERATE_NODE_KIND(AssignmentExpression)         \
+	BO_ENUMERATE_NODE_KIND(UpdateExpression)             \
+	BO_ENUMERATE_NODE_KIND(PointerDereferenceExpression) \
+	BO_ENUMERATE_NODE_KIND(AddressOfExpression)          \
+	BO_ENUMERATE_NODE_KIND(RangeExpression)              \
+	BO_ENUMERATE_NODE_KIND(BlockExpression)              \
+	BO_ENUMERATE_NODE_KIND(IfExpression)                 \
+	BO_ENUMERATE_NODE_KIND(FunctionCallExpression)       \
+	BO_ENUMERATE_NODE_KIND(ArrayExpression)              \
+	BO_ENUMERATE_NODE_KIND(ArraySubscriptExpression)     \
+	BO_ENUMERATE_NODE_KIND(ExpressionStatement)          \
+	BO_ENUMERATE_NODE_KIND(VariableDeclarationStatement) \
+	BO_ENUMERATE_NODE_KIND(Function)                     \
+	BO_ENUMERATE_NODE_KIND(InfiniteForStatement)         \
+	BO_ENUMERATE_NODE_KIND(ForWithConditionStatement)    \
+	BO_ENUMERATE_NODE_KIND(ForWithRangeStatement)        \
+	BO_ENUMERATE_NODE_KIND(ReturnStatement)
+
+// NOTE: The order of the kinds matters: expressions and statements are kept
+//       contiguous so that is_expression() and is_statement() are two compares.
+enum class Kind : std::uint8_t {
+#define BO_ENUMERATE_NODE_KIND(x) x,
+	_BO_ENUMERATE_CHECKED_NODE_KINDS
+#undef BO_ENUMERATE_NODE_KIND
+};
+
 class Program;
 class Node {
 public:
@@ -36,72 +91,71 @@ public:
 
 	virtual void dump(Program const&) const = 0;
 
-	virtual bool is_expression() const { return false; }
-	virtual bool is_statement() const { return false; }
+	bool is_expression() const { return m_kind >= Kind::ParenthesizedExpression && m_kind <= Kind::ArraySubscriptExpression; }
+	bool is_statement() const { return m_kind >= Kind::ExpressionStatement && m_kind <= Kind::ReturnStatement; }
 
+	Kind kind() const { return m_kind; }
 	Types::Id type_id() const { return m_type_id; }
 	Span span() const { return m_span; }
 
 protected:
-	explicit Node(Types::Id type_id, Span span)
-	  : m_type_id(type_id), m_span(span) {}
+	explicit Node(Kind kind, Types::Id type_id, Span span)
+	  : m_kind(kind), m_type_id(type_id), m_span(span) {}
 
+	Kind m_kind;
 	Types::Id m_type_id;
 	Span m_span;
 };
 
 class Expression : public Node {
 public:
-	virtual bool is_expression() const override { return true; }
-	virtual bool is_parenthesized_expression() const { return false; }
-	virtual bool is_integer_literal() const { return false; }
-	virtual bool is_char_literal() const { return false; }
-	virtual bool is_boolean_literal() const { return false; }
-	virtual bool is_identifier() const { return false; }
-	virtual bool is_binary_expression() const { return false; }
-	virtual bool is_unary_expression() const { return false; }
-	virtual bool is_assignment_expression() const { return false; }
-	virtual bool is_update_expression() const { return false; }
-	virtual bool is_pointer_dereference_expression() const { return false; }
-	virtual bool is_address_of_expression() const { return false; }
-	virtual bool is_range_expression() const { return false; }
-	virtual bool is_block_expression() const { return false; }
-	virtual bool is_if_expression() const { return false; }
-	virtual bool is_function_call_expression() const { return false; }
-	virtual bool is_array_expression() const { return false; }
-	virtual bool is_array_subscription_expression() const { return false; }
-	virtual bool has_block() const { return false; }
+	bool is_parenthesized_expression() const { return m_kind == Kind::ParenthesizedExpression; }
+	bool is_integer_literal() const { return m_kind == Kind::IntegerLiteral; }
+	bool is_char_literal() const { return m_kind == Kind::CharLiteral; }
+	bool is_boolean_literal() const { return m_kind == Kind::BooleanLiteral; }
+	bool is_identifier() const { return m_kind == Kind::Identifier; }
+	bool is_binary_expression() const { return m_kind == Kind::BinaryExpression; }
+	bool is_unary_expression() const { return m_kind == Kind::UnaryExpression; }
+	bool is_assignment_expression() const { return m_kind == Kind::AssignmentExpression; }
+	bool is_update_expression() const { return m_kind == Kind::UpdateExpression; }
+	bool is_pointer_dereference_expression() const { return m_kind == Kind::PointerDereferenceExpression; }
+	bool is_address_of_expression() const { return m_kind == Kind::AddressOfExpression; }
+	bool is_range_expression() const { return m_kind == Kind::RangeExpression; }
+	bool is_block_expression() const { return m_kind == Kind::BlockExpression; }
+	bool is_if_expression() const { return m_kind == Kind::IfExpression; }
+	bool is_function_call_expression() const { return m_kind == Kind::FunctionCallExpression; }
+	bool is_array_expression() const { return m_kind == Kind::ArrayExpression; }
+	bool is_array_subscription_expression() const { return m_kind == Kind::ArraySubscriptExpression; }
+	bool has_block() const { return m_kind == Kind::BlockExpression || m_kind == Kind::IfExpression; }
 
 protected:
-	explicit Expression(Types::Id type_id, Span span)
-	  : Node(type_id, span) {}
+	explicit Expression(Kind kind, Types::Id type_id, Span span)
+	  : Node(kind, type_id, span) {}
 };
 
 class Statement : public Node {
 public:
-	virtual bool is_statement() const override { return true; }
-	virtual bool is_expression_statement() const { return false; }
-	virtual bool is_variable_declaration() const { return false; }
-	virtual bool is_for_statement() const { return false; }
-	virtual bool is_return_statement() const { return false; }
+	bool is_expression_statement() const { return m_kind == Kind::ExpressionStatement; }
+	bool is_variable_declaration() const { return m_kind == Kind::VariableDeclarationStatement; }
+	bool is_for_statement() const { return m_kind >= Kind::InfiniteForStatement && m_kind <= Kind::ForWithRangeStatement; }
+	bool is_return_statement() const { return m_kind == Kind::ReturnStatement; }
 
 protected:
-	explicit Statement(Types::Id type_id, Span span)
-	  : Node(type_id, span) {}
+	explicit Statement(Kind kind, Types::Id type_id, Span span)
+	  : Node(kind, type_id, span) {}
 };
 
 class ParenthesizedExpression : public Expression {
 public:
-	explicit ParenthesizedExpression(std::shared_ptr<Expression const> expression, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_expression(std::move(expression)) {}
+	explicit ParenthesizedExpression(Expression const* expression, Types::Id type_id, Span span)
+	  : Expression(Kind::ParenthesizedExpression, type_id, span), m_expression(expression) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_parenthesized_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> expression() const { return m_expression; }
+	Expression const* expression() const { return m_expression; }
 
 private:
-	std::shared_ptr<Expression const> m_expression;
+	Expression const* m_expression;
 };
 
 class IntegerLiteral : public Expression {
@@ -114,10 +168,9 @@ public:
 	};
 
 	explicit IntegerLiteral(std::string_view value, std::string_view suffix, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_value(value), m_suffix(suffix) {}
+	  : Expression(Kind::IntegerLiteral, type_id, span), m_value(value), m_suffix(suffix) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_integer_literal() const override { return true; }
 
 	std::string_view value() const { return m_value; }
 	std::string_view suffix() const { return m_suffix; }
@@ -130,10 +183,9 @@ private:
 class CharLiteral : public Expression {
 public:
 	explicit CharLiteral(std::string_view value, Span span)
-	  : Expression(Types::builtin_char_id, span), m_value(value) {}
+	  : Expression(Kind::CharLiteral, Types::builtin_char_id, span), m_value(value) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_char_literal() const override { return true; }
 
 	std::string_view value() const { return m_value; }
 
@@ -144,10 +196,9 @@ private:
 class BooleanLiteral : public Expression {
 public:
 	explicit BooleanLiteral(bool value, Span span)
-	  : Expression(Types::builtin_bool_id, span), m_value(value) {}
+	  : Expression(Kind::BooleanLiteral, Types::builtin_bool_id, span), m_value(value) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_boolean_literal() const override { return true; }
 
 	bool value() const { return m_value; }
 
@@ -158,10 +209,9 @@ private:
 class Identifier : public Expression {
 public:
 	explicit Identifier(std::size_t variable_id, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_variable_id(variable_id) {}
+	  : Expression(Kind::Identifier, type_id, span), m_variable_id(variable_id) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_identifier() const override { return true; }
 
 	std::size_t variable_id() const { return m_variable_id; }
 
@@ -171,239 +221,224 @@ private:
 
 class BinaryExpression : public Expression {
 public:
-	explicit BinaryExpression(std::shared_ptr<Expression const> lhs, std::shared_ptr<Expression const> rhs, AST::BinaryOperator op, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_lhs(std::move(lhs)), m_rhs(std::move(rhs)), m_op(op) {}
+	explicit BinaryExpression(Expression const* lhs, Expression const* rhs, AST::BinaryOperator op, Types::Id type_id, Span span)
+	  : Expression(Kind::BinaryExpression, type_id, span), m_lhs(lhs), m_rhs(rhs), m_op(op) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_binary_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> lhs() const { return m_lhs; }
-	std::shared_ptr<Expression const> rhs() const { return m_rhs; }
+	Expression const* lhs() const { return m_lhs; }
+	Expression const* rhs() const { return m_rhs; }
 	AST::BinaryOperator op() const { return m_op; }
 
 private:
-	std::shared_ptr<Expression const> m_lhs;
-	std::shared_ptr<Expression const> m_rhs;
+	Expression const* m_lhs;
+	Expression const* m_rhs;
 	AST::BinaryOperator m_op;
 };
 
 class UnaryExpression : public Expression {
 public:
-	explicit UnaryExpression(std::shared_ptr<Expression const> operand, AST::UnaryOperator op, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_operand(std::move(operand)), m_op(op) {}
+	explicit UnaryExpression(Expression const* operand, AST::UnaryOperator op, Types::Id type_id, Span span)
+	  : Expression(Kind::UnaryExpression, type_id, span), m_operand(operand), m_op(op) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_unary_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> operand() const { return m_operand; }
+	Expression const* operand() const { return m_operand; }
 	AST::UnaryOperator op() const { return m_op; }
 
 private:
-	std::shared_ptr<Expression const> m_operand;
+	Expression const* m_operand;
 	AST::UnaryOperator m_op;
 };
 
 class AssignmentExpression : public Expression {
 public:
-	explicit AssignmentExpression(std::shared_ptr<Expression const> lhs, std::shared_ptr<Expression const> rhs, AST::AssignmentOperator op, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_lhs(std::move(lhs)), m_rhs(std::move(rhs)), m_op(op) {}
+	explicit AssignmentExpression(Expression const* lhs, Expression const* rhs, AST::AssignmentOperator op, Types::Id type_id, Span span)
+	  : Expression(Kind::AssignmentExpression, type_id, span), m_lhs(lhs), m_rhs(rhs), m_op(op) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_assignment_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> lhs() const { return m_lhs; }
-	std::shared_ptr<Expression const> rhs() const { return m_rhs; }
+	Expression const* lhs() const { return m_lhs; }
+	Expression const* rhs() const { return m_rhs; }
 	AST::AssignmentOperator op() const { return m_op; }
 
 private:
-	std::shared_ptr<Expression const> m_lhs;
-	std::shared_ptr<Expression const> m_rhs;
+	Expression const* m_lhs;
+	Expression const* m_rhs;
 	AST::AssignmentOperator m_op;
 };
 
 class UpdateExpression : public Expression {
 public:
-	explicit UpdateExpression(std::shared_ptr<Expression const> operand, AST::UpdateOperator op, bool is_prefixed, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_operand(std::move(operand)), m_op(op), m_is_prefixed(is_prefixed) {}
+	explicit UpdateExpression(Expression const* operand, AST::UpdateOperator op, bool is_prefixed, Types::Id type_id, Span span)
+	  : Expression(Kind::UpdateExpression, type_id, span), m_operand(operand), m_op(op), m_is_prefixed(is_prefixed) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_update_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> operand() const { return m_operand; }
+	Expression const* operand() const { return m_operand; }
 	AST::UpdateOperator op() const { return m_op; }
 	bool is_prefixed() const { return m_is_prefixed; }
 
 private:
-	std::shared_ptr<Expression const> m_operand;
+	Expression const* m_operand;
 	AST::UpdateOperator m_op;
 	bool m_is_prefixed;
 };
 
 class PointerDereferenceExpression : public Expression {
 public:
-	explicit PointerDereferenceExpression(std::shared_ptr<Expression const> operand, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_operand(std::move(operand)) {}
+	explicit PointerDereferenceExpression(Expression const* operand, Types::Id type_id, Span span)
+	  : Expression(Kind::PointerDereferenceExpression, type_id, span), m_operand(operand) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_pointer_dereference_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> operand() const { return m_operand; }
+	Expression const* operand() const { return m_operand; }
 
 private:
-	std::shared_ptr<Expression const> m_operand;
+	Expression const* m_operand;
 };
 
 class AddressOfExpression : public Expression {
 public:
-	explicit AddressOfExpression(std::shared_ptr<Expression const> operand, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_operand(std::move(operand)) {}
+	explicit AddressOfExpression(Expression const* operand, Types::Id type_id, Span span)
+	  : Expression(Kind::AddressOfExpression, type_id, span), m_operand(operand) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_address_of_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> operand() const { return m_operand; }
+	Expression const* operand() const { return m_operand; }
 
 private:
-	std::shared_ptr<Expression const> m_operand;
+	Expression const* m_operand;
 };
 
 class RangeExpression : public Expression {
 public:
-	explicit RangeExpression(std::shared_ptr<Expression const> start, std::shared_ptr<Expression const> end, bool is_inclusive, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_start(std::move(start)), m_end(std::move(end)), m_is_inclusive(is_inclusive) {}
+	explicit RangeExpression(Expression const* start, Expression const* end, bool is_inclusive, Types::Id type_id, Span span)
+	  : Expression(Kind::RangeExpression, type_id, span), m_start(start), m_end(end), m_is_inclusive(is_inclusive) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_range_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> start() const { return m_start; }
-	std::shared_ptr<Expression const> end() const { return m_end; }
+	Expression const* start() const { return m_start; }
+	Expression const* end() const { return m_end; }
 	bool is_inclusive() const { return m_is_inclusive; }
 
 private:
-	std::shared_ptr<Expression const> m_start;
-	std::shared_ptr<Expression const> m_end;
+	Expression const* m_start;
+	Expression const* m_end;
 	bool m_is_inclusive;
 };
 
 class BlockExpression : public Expression {
 public:
-	explicit BlockExpression(std::vector<std::shared_ptr<Statement const>> statements, bool contains_return_statement, std::size_t scope_id, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_statements(std::move(statements)), m_contains_return_statement(contains_return_statement), m_scope_id(scope_id) {}
+	explicit BlockExpression(std::span<Statement const* const> statements, bool contains_return_statement, std::size_t scope_id, Types::Id type_id, Span span)
+	  : Expression(Kind::BlockExpression, type_id, span), m_statements(statements), m_contains_return_statement(contains_return_statement), m_scope_id(scope_id) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_block_expression() const override { return true; }
-	virtual bool has_block() const override { return true; }
 
-	std::vector<std::shared_ptr<Statement const>> const& statements() const { return m_statements; }
+	std::span<Statement const* const> statements() const { return m_statements; }
 	bool contains_return_statement() const { return m_contains_return_statement; }
 	std::size_t scope_id() const { return m_scope_id; }
 
 private:
-	std::vector<std::shared_ptr<Statement const>> m_statements;
+	std::span<Statement const* const> m_statements;
 	bool m_contains_return_statement;
 	std::size_t m_scope_id;
 };
 
 class IfExpression : public Expression {
 public:
-	explicit IfExpression(std::shared_ptr<Expression const> condition, std::shared_ptr<BlockExpression const> then, std::shared_ptr<Expression const> else_, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_condition(std::move(condition)), m_then(std::move(then)), m_else(std::move(else_)) {}
+	explicit IfExpression(Expression const* condition, BlockExpression const* then, Expression const* else_, Types::Id type_id, Span span)
+	  : Expression(Kind::IfExpression, type_id, span), m_condition(condition), m_then(then), m_else(else_) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_if_expression() const override { return true; }
-	virtual bool has_block() const override { return true; }
 
-	std::shared_ptr<Expression const> condition() const { return m_condition; }
-	std::shared_ptr<BlockExpression const> then() const { return m_then; }
-	std::shared_ptr<Expression const> else_() const { return m_else; }
+	Expression const* condition() const { return m_condition; }
+	BlockExpression const* then() const { return m_then; }
+	Expression const* else_() const { return m_else; }
 
 private:
-	std::shared_ptr<Expression const> m_condition;
-	std::shared_ptr<BlockExpression const> m_then;
-	std::shared_ptr<Expression const> m_else;
+	Expression const* m_condition;
+	BlockExpression const* m_then;
+	Expression const* m_else;
 };
 
 struct FunctionArgument {
-	std::string_view name;
-	std::shared_ptr<Expression const> value;
+	// NOTE: Empty for anonymous arguments.
+	Symbol name;
+	Expression const* value;
 };
 
 class FunctionCallExpression : public Expression {
 public:
-	explicit FunctionCallExpression(std::size_t function_id, std::vector<FunctionArgument> arguments, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_function_id(function_id), m_arguments(std::move(arguments)) {}
+	explicit FunctionCallExpression(std::size_t function_id, std::span<FunctionArgument const> arguments, Types::Id type_id, Span span)
+	  : Expression(Kind::FunctionCallExpression, type_id, span), m_function_id(function_id), m_arguments(arguments) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_function_call_expression() const override { return true; }
 
 	std::size_t function_id() const { return m_function_id; }
-	std::vector<FunctionArgument> const& arguments() const { return m_arguments; }
+	std::span<FunctionArgument const> arguments() const { return m_arguments; }
 
 private:
 	std::size_t m_function_id;
-	std::vector<FunctionArgument> m_arguments;
+	std::span<FunctionArgument const> m_arguments;
 };
 
 class ArrayExpression : public Expression {
 public:
-	explicit ArrayExpression(std::vector<std::shared_ptr<Expression const>> elements, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_elements(std::move(elements)) {}
+	explicit ArrayExpression(std::span<Expression const* const> elements, Types::Id type_id, Span span)
+	  : Expression(Kind::ArrayExpression, type_id, span), m_elements(elements) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_array_expression() const override { return true; }
 
-	std::vector<std::shared_ptr<Expression const>> const& elements() const { return m_elements; }
+	std::span<Expression const* const> elements() const { return m_elements; }
 
 private:
-	std::vector<std::shared_ptr<Expression const>> m_elements;
+	std::span<Expression const* const> m_elements;
 };
 
 class ArraySubscriptExpression : public Expression {
 public:
-	explicit ArraySubscriptExpression(std::shared_ptr<Expression const> array, std::shared_ptr<Expression const> index, Types::Id type_id, Span span)
-	  : Expression(type_id, span), m_array(std::move(array)), m_index(std::move(index)) {}
+	explicit ArraySubscriptExpression(Expression const* array, Expression const* index, Types::Id type_id, Span span)
+	  : Expression(Kind::ArraySubscriptExpression, type_id, span), m_array(array), m_index(index) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_array_subscription_expression() const override { return true; }
 
-	std::shared_ptr<Expression const> array() const { return m_array; }
-	std::shared_ptr<Expression const> index() const { return m_index; }
+	Expression const* array() const { return m_array; }
+	Expression const* index() const { return m_index; }
 
 private:
-	std::shared_ptr<Expression const> m_array;
-	std::shared_ptr<Expression const> m_index;
+	Expression const* m_array;
+	Expression const* m_index;
 };
 
 class ExpressionStatement : public Statement {
 public:
-	explicit ExpressionStatement(std::shared_ptr<Expression const> expression, bool ends_with_semicolon, Types::Id type_id, Span span)
-	  : Statement(type_id, span), m_expression(std::move(expression)), m_ends_with_semicolon(ends_with_semicolon) {}
+	explicit ExpressionStatement(Expression const* expression, bool ends_with_semicolon, Types::Id type_id, Span span)
+	  : Statement(Kind::ExpressionStatement, type_id, span), m_expression(expression), m_ends_with_semicolon(ends_with_semicolon) {}
 
-	virtual bool is_expression_statement() const override { return true; }
 	virtual void dump(Program const&) const override;
 
-	std::shared_ptr<Expression const> expression() const { return m_expression; }
+	Expression const* expression() const { return m_expression; }
 	bool ends_with_semicolon() const { return m_ends_with_semicolon; }
 
 private:
-	std::shared_ptr<Expression const> m_expression;
+	Expression const* m_expression;
 	bool m_ends_with_semicolon;
 };
 
 class VariableDeclarationStatement : public Statement {
 public:
-	explicit VariableDeclarationStatement(std::size_t variable_id, std::shared_ptr<Expression const> initializer, Span span)
-	  : Statement(Types::builtin_void_id, span), m_variable_id(variable_id), m_initializer(std::move(initializer)) {}
+	explicit VariableDeclarationStatement(std::size_t variable_id, Expression const* initializer, Span span)
+	  : Statement(Kind::VariableDeclarationStatement, Types::builtin_void_id, span), m_variable_id(variable_id), m_initializer(initializer) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_variable_declaration() const override { return true; }
 
 	std::size_t variable_id() const { return m_variable_id; }
-	std::shared_ptr<Expression const> initializer() const { return m_initializer; }
+	Expression const* initializer() const { return m_initializer; }
 
 private:
 	std::size_t m_variable_id;
-	std::shared_ptr<Expression const> m_initializer;
+	Expression const* m_initializer;
 };
 
 struct FunctionParameter {
@@ -413,125 +448,168 @@ struct FunctionParameter {
 
 class Function : public Statement {
 public:
-	explicit Function(std::string_view name, std::vector<FunctionParameter>&& parameters, Types::Id return_type_id, std::shared_ptr<BlockExpression const> body, bool is_builtin, Span span)
-	  : Statement(Types::builtin_void_id, span), m_name(name), m_parameters(std::move(parameters)), m_return_type_id(return_type_id), m_body(body), m_is_builtin(is_builtin) {}
+	explicit Function(Symbol name, std::span<FunctionParameter const> parameters, Types::Id return_type_id, BlockExpression const* body, bool is_builtin, Span span)
+	  : Statement(Kind::Function, Types::builtin_void_id, span), m_name(name), m_parameters(parameters), m_return_type_id(return_type_id), m_body(body), m_is_builtin(is_builtin) {}
 
 	virtual void dump(Program const&) const override;
 
-	std::string_view name() const { return m_name; }
-	std::vector<FunctionParameter> const& parameters() const { return m_parameters; }
+	Symbol name() const { return m_name; }
+	std::span<FunctionParameter const> parameters() const { return m_parameters; }
 	Types::Id return_type_id() const { return m_return_type_id; }
-	std::shared_ptr<BlockExpression const> body() const { return m_body; }
+	BlockExpression const* body() const { return m_body; }
 	bool is_builtin() const { return m_is_builtin; }
 
 private:
-	std::string_view m_name;
-	std::vector<FunctionParameter> m_parameters;
+	Symbol m_name;
+	std::span<FunctionParameter const> m_parameters;
 	Types::Id m_return_type_id;
-	std::shared_ptr<BlockExpression const> m_body;
+	BlockExpression const* m_body;
 	bool m_is_builtin;
 };
 
 class ForStatement : public Statement {
 public:
-	virtual bool is_for_statement() const override { return true; }
-	virtual bool is_infinite() const { return false; }
-	virtual bool is_with_condition() const { return false; }
-	virtual bool is_with_range() const { return false; }
+	bool is_infinite() const { return m_kind == Kind::InfiniteForStatement; }
+	bool is_with_condition() const { return m_kind == Kind::ForWithConditionStatement; }
+	bool is_with_range() const { return m_kind == Kind::ForWithRangeStatement; }
 
-	std::shared_ptr<BlockExpression const> body() const { return m_body; }
+	BlockExpression const* body() const { return m_body; }
 
 protected:
-	explicit ForStatement(std::shared_ptr<BlockExpression const> body, Span span)
-	  : Statement(Types::builtin_void_id, span), m_body(std::move(body)) {}
+	explicit ForStatement(Kind kind, BlockExpression const* body, Span span)
+	  : Statement(kind, Types::builtin_void_id, span), m_body(body) {}
 
-	std::shared_ptr<BlockExpression const> m_body;
+	BlockExpression const* m_body;
 };
 
 class InfiniteForStatement : public ForStatement {
 public:
-	explicit InfiniteForStatement(std::shared_ptr<BlockExpression const> body, Span span)
-	  : ForStatement(body, span) {}
+	explicit InfiniteForStatement(BlockExpression const* body, Span span)
+	  : ForStatement(Kind::InfiniteForStatement, body, span) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_infinite() const override { return true; }
 };
 
 class ForWithConditionStatement : public ForStatement {
 public:
-	explicit ForWithConditionStatement(std::shared_ptr<Expression const> condition, std::shared_ptr<BlockExpression const> body, Span span)
-	  : ForStatement(body, span), m_condition(condition) {}
+	explicit ForWithConditionStatement(Expression const* condition, BlockExpression const* body, Span span)
+	  : ForStatement(Kind::ForWithConditionStatement, body, span), m_condition(condition) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_with_condition() const override { return true; }
 
-	std::shared_ptr<Expression const> condition() const { return m_condition; }
+	Expression const* condition() const { return m_condition; }
 
 private:
-	std::shared_ptr<Expression const> m_condition;
+	Expression const* m_condition;
 };
 
 class ForWithRangeStatement : public ForStatement {
 public:
-	explicit ForWithRangeStatement(std::size_t range_variable_id, std::shared_ptr<Expression const> range_expression, std::shared_ptr<BlockExpression const> body, Span span)
-	  : ForStatement(body, span), m_range_variable_id(range_variable_id), m_range_expression(std::move(range_expression)) {}
+	explicit ForWithRangeStatement(std::size_t range_variable_id, Expression const* range_expression, BlockExpression const* body, Span span)
+	  : ForStatement(Kind::ForWithRangeStatement, body, span), m_range_variable_id(range_variable_id), m_range_expression(range_expression) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_with_range() const override { return true; }
 
 	std::size_t range_variable_id() const { return m_range_variable_id; }
-	std::shared_ptr<Expression const> range_expression() const { return m_range_expression; }
+	Expression const* range_expression() const { return m_range_expression; }
 
 private:
 	std::size_t m_range_variable_id;
-	std::shared_ptr<Expression const> m_range_expression;
+	Expression const* m_range_expression;
 };
 
 class ReturnStatement : public Statement {
 public:
-	explicit ReturnStatement(std::shared_ptr<Expression const> expression, Span span)
-	  : Statement(Types::builtin_void_id, span), m_expression(std::move(expression)) {}
+	explicit ReturnStatement(Expression const* expression, Span span)
+	  : Statement(Kind::ReturnStatement, Types::builtin_void_id, span), m_expression(expression) {}
 
 	virtual void dump(Program const&) const override;
-	virtual bool is_return_statement() const override { return true; }
 
-	std::shared_ptr<Expression const> expression() const { return m_expression; }
+	Expression const* expression() const { return m_expression; }
 
 private:
-	std::shared_ptr<Expression const> m_expression;
+	Expression const* m_expression;
+};
+
+struct SignatureHash {
+	std::size_t operator()(std::vector<Types::Id> const& signature) const {
+		std::size_t hash = signature.size();
+		for (auto type_id : signature) {
+			hash = hash_combine(hash, type_id);
+		}
+
+		return hash;
+	}
 };
 
 class Program {
 public:
 	explicit Program();
 
-	Types::Id find_or_add_type(Types::Type);
+	// NOTE: Types may be interned from several threads at once while function
+	//       bodies are being checked; everything else is only mutated by one
+	//       thread at a time, see Typechecker::check.
+	Types::Id find_or_add_type(Types::Type const&);
 	Types::Id apply_mutability(Types::Id, bool);
-	Types::Type const& get_type(Types::Id) const;
+	// NOTE: Inline, since the typechecker asks for the traits of a type on
+	//       almost every expression.
+	Types::Type const& get_type(Types::Id type_id) const { return m_types.get(type_id); }
 
-	std::optional<std::size_t> find_variable(std::string_view name, std::size_t scope_id) const;
-	Variable const& get_variable(std::size_t id) const { return m_variables[id]; }
+	std::optional<std::size_t> find_variable(Symbol name, std::size_t scope_id) const;
+	Variable const& get_variable(std::size_t id) const { return m_locals[function_of(id)].variables[local_index_of(id)]; }
 	std::size_t define_variable(Variable);
 
-	std::size_t create_scope(std::optional<std::size_t> parent = std::nullopt);
+	std::size_t create_function_scope(std::size_t function_id);
+	std::size_t create_scope(std::size_t parent);
 
-	std::vector<std::shared_ptr<Function const>> const& functions() const { return m_functions; }
-	std::shared_ptr<Function const> get_function(std::size_t id) const { return m_functions[id]; }
-	std::optional<std::size_t> find_function(std::string_view name, std::vector<Types::Id> const& signature) const;
-	std::size_t add_function(std::shared_ptr<Function const> function);
+	std::vector<Function const*> const& functions() const { return m_functions; }
+	Function const* get_function(std::size_t id) const { return m_functions[id]; }
+	std::optional<std::size_t> find_function(Symbol name, std::vector<Types::Id> const& signature) const;
+	std::size_t add_function(Function const* function);
+	void replace_function(std::size_t id, Function const* function);
+
+	Arena& arena() { return m_arena; }
+	Arena& create_arena();
+
+	// NOTE: Totals over every arena the program's nodes were allocated from.
+	std::size_t node_count() const;
+	std::size_t node_bytes() const;
+	std::size_t type_count() const { return m_types.size(); }
 
 	Span span() const { return m_span; }
 
 	void dump_type(Types::Id) const;
-	void dump_variable(std::size_t id) const { dump_variable(m_variables[id]); }
+	void dump_variable(std::size_t id) const { dump_variable(get_variable(id)); }
 	void dump_variable(Variable const&) const;
 	void dump() const;
 
 private:
-	std::vector<Types::Type> m_types;
-	std::vector<Variable> m_variables;
-	std::vector<Scope> m_scopes;
-	std::vector<std::shared_ptr<Function const>> m_functions;
+	void index_function(std::size_t id);
+
+	// NOTE: Variables and scopes belong to the function that declares them, so
+	//       that each body can be checked without touching the others. Their
+	//       ids hold the function id in the upper half and the index into that
+	//       function's tables in the lower half.
+	struct Locals {
+		std::vector<Variable> variables;
+		std::vector<Scope> scopes;
+	};
+
+	static constexpr std::size_t local_index_bits = 32;
+	static constexpr std::size_t make_local_id(std::size_t function_id, std::size_t index) { return (function_id << local_index_bits) | index; }
+	static constexpr std::size_t function_of(std::size_t id) { return id >> local_index_bits; }
+	static constexpr std::size_t local_index_of(std::size_t id) { return id & ((std::size_t(1) << local_index_bits) - 1); }
+
+	Arena m_arena;
+	std::vector<std::unique_ptr<Arena>> m_worker_arenas;
+
+	// NOTE: Overloads of a function are bucketed by arity and then looked up by their full signature.
+	using OverloadSet = std::vector<std::unordered_map<std::vector<Types::Id>, std::size_t, SignatureHash>>;
+
+	ConcurrentInterner<Types::Type> m_types;
+	std::vector<Locals> m_locals;
+	std::vector<Function const*> m_functions;
+	std::unordered_map<Symbol, OverloadSet> m_function_overloads;
 	Span m_span;
 };
 
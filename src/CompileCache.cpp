@@ -0,0 +1,241 @@
+#include "CompileCache.hpp"
+
+#include "SourceFile.hpp"
+#include "System.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <fcntl.h>
+#include <filesystem>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace bo {
+
+static Error filesystem_error(std::string_view what, std::string_view path, std::error_code const& error_code) {
+	return Error { fmt::format("couldn't {} '{}': {}", what, path, error_code.message()), Span { 0, 0 } };
+}
+
+Result<CompileCache, Error> CompileCache::open(std::string directory, std::uint64_t max_size) {
+	std::error_code error_code;
+	std::filesystem::create_directories(directory, error_code);
+	if (error_code) {
+		return filesystem_error("create directory", directory, error_code);
+	}
+
+	return CompileCache { std::move(directory), max_size };
+}
+
+std::string CompileCache::entry_path(std::string_view key, std::string_view kind) const {
+	return fmt::format("{}/{}/{}.{}", m_directory, key.substr(0, 2), key, kind);
+}
+
+Result<std::optional<std::string>, Error> CompileCache::find(std::string_view key, std::string_view kind) {
+	auto path = entry_path(key, kind);
+	// NOTE: Bumping the modification time doubles as the existence check.
+	auto is_hit = ::utimensat(AT_FDCWD, path.c_str(), nullptr, 0) == 0;
+	TRY(update_stats([&](Stats& stats) -> Result<void, Error> {
+		++(is_hit ? stats.hits : stats.misses);
+		return {};
+	}));
+
+	if (!is_hit) {
+		return std::optional<std::string> {};
+	}
+
+	return std::optional { std::move(path) };
+}
+
+std::string CompileCache::temporary_path() const {
+	static std::atomic<unsigned> counter { 0 };
+	return fmt::format("{}/tmp.{}.{}", m_directory, ::getpid(), counter.fetch_add(1, std::memory_order_relaxed));
+}
+
+Result<void, Error> CompileCache::insert(std::string_view key, std::string_view kind, std::string const& temporary_path) {
+	auto path = entry_path(key, kind);
+	auto directory = path.substr(0, path.rfind('/'));
+	if (::mkdir(directory.c_str(), 0777) < 0 && errno != EEXIST) {
+		auto error = system_error("create directory", directory);
+		::unlink(temporary_path.c_str());
+		return error;
+	}
+
+	struct stat status;
+	if (::stat(temporary_path.c_str(), &status) < 0 || ::rename(temporary_path.c_str(), path.c_str()) < 0) {
+		auto error = system_error("add to the cache", temporary_path);
+		::unlink(temporary_path.c_str());
+		return error;
+	}
+
+	return update_stats([&](Stats& stats) -> Result<void, Error> {
+		stats.size += static_cast<std::uint64_t>(status.st_size);
+		if (stats.size > m_max_size) {
+			TRY(evict(stats));
+		}
+
+		return {};
+	});
+}
+
+Result<void, Error> CompileCache::insert_copy(std::string_view key, std::string_view kind, std::string const& path) {
+	auto copy_path = temporary_path();
+	TRY(copy_file(path, copy_path));
+	return insert(key, kind, copy_path);
+}
+
+Result<CompileCache::Stats, Error> CompileCache::stats() const {
+	return read_stats();
+}
+
+Result<void, Error> CompileCache::clear() {
+	return update_stats([&](Stats& stats) -> Result<void, Error> {
+		std::error_code error_code;
+		for (auto const& entry : std::filesystem::directory_iterator { m_directory, error_code }) {
+			if (entry.is_directory()) {
+				std::filesystem::remove_all(entry.path(), error_code);
+				if (error_code) {
+					return filesystem_error("remove", entry.path().native(), error_code);
+				}
+			}
+		}
+
+		if (error_code) {
+			return filesystem_error("read directory", m_directory, error_code);
+		}
+
+		stats = {};
+		return {};
+	});
+}
+
+template<typename Update>
+Result<void, Error> CompileCache::update_stats(Update const& update) {
+	auto lock_path = fmt::format("{}/lock", m_directory);
+	auto fd = ::open(lock_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+	if (fd < 0) {
+		return system_error("open", lock_path);
+	}
+
+	while (::flock(fd, LOCK_EX) < 0) {
+		if (errno != EINTR) {
+			auto error = system_error("lock", lock_path);
+			::close(fd);
+			return error;
+		}
+	}
+
+	// NOTE: Closing the file releases the lock.
+	auto stats = read_stats();
+	if (stats.is_error()) {
+		::close(fd);
+		return stats.release_error();
+	}
+
+	if (auto updated = update(stats.value()); updated.is_error()) {
+		::close(fd);
+		return updated;
+	}
+
+	auto written = write_stats(stats.value());
+	::close(fd);
+	return written;
+}
+
+// NOTE: The statistics are kept as `<name> <value>` lines. A missing file is
+//       the same as a fresh cache.
+Result<CompileCache::Stats, Error> CompileCache::read_stats() const {
+	Stats stats;
+	auto file = SourceFile::open(fmt::format("{}/stats", m_directory));
+	if (file.is_error()) {
+		return stats;
+	}
+
+	auto contents = file.value().contents();
+	while (!contents.empty()) {
+		auto line = contents.substr(0, contents.find('\n'));
+		contents.remove_prefix(std::min(line.size() + 1, contents.size()));
+
+		auto space = line.find(' ');
+		if (space == std::string_view::npos) {
+			continue;
+		}
+
+		auto name = line.substr(0, space);
+		auto value = line.substr(space + 1);
+		std::uint64_t* field = name == "hits"      ? &stats.hits
+		                     : name == "misses"    ? &stats.misses
+		                     : name == "evictions" ? &stats.evictions
+		                     : name == "size"      ? &stats.size
+		                                           : nullptr;
+		if (field != nullptr) {
+			std::from_chars(value.data(), value.data() + value.size(), *field);
+		}
+	}
+
+	return stats;
+}
+
+Result<void, Error> CompileCache::write_stats(Stats const& stats) const {
+	auto contents = fmt::format("hits {}\nmisses {}\nevictions {}\nsize {}\n", stats.hits, stats.misses, stats.evictions, stats.size);
+	return write_file(fmt::format("{}/stats", m_directory), contents);
+}
+
+// NOTE: Called with the lock held. The running size is only an estimate, since
+//       entries can be overwritten or removed behind our back, so the actual
+//       total is measured while looking for the least recently used entries.
+//       Evicting down to 90% of the maximum avoids rescanning on every insert
+//       once the cache is full.
+Result<void, Error> CompileCache::evict(Stats& stats) const {
+	struct Entry {
+		std::filesystem::file_time_type last_used;
+		std::uint64_t size;
+		std::filesystem::path path;
+	};
+
+	std::vector<Entry> entries;
+	std::uint64_t total_size = 0;
+	std::error_code error_code;
+	for (auto const& directory : std::filesystem::directory_iterator { m_directory, error_code }) {
+		if (!directory.is_directory() || directory.path().filename().native().size() != 2) {
+			continue;
+		}
+
+		for (auto const& entry : std::filesystem::directory_iterator { directory.path(), error_code }) {
+			std::error_code entry_error_code;
+			auto last_used = entry.last_write_time(entry_error_code);
+			auto size = entry.file_size(entry_error_code);
+			if (!entry_error_code) {
+				entries.push_back({ last_used, size, entry.path() });
+				total_size += size;
+			}
+		}
+	}
+
+	if (error_code) {
+		return filesystem_error("read directory", m_directory, error_code);
+	}
+
+	std::ranges::sort(entries, {}, &Entry::last_used);
+	auto target_size = m_max_size / 10 * 9;
+	for (auto const& entry : entries) {
+		if (total_size <= target_size) {
+			break;
+		}
+
+		if (std::filesystem::remove(entry.path, error_code)) {
+			total_size -= entry.size;
+			++stats.evictions;
+		}
+	}
+
+	stats.size = total_size;
+	return {};
+}
+
+}
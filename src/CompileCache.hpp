@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "Error.hpp"
+#include "utils/Result.hpp"
+
+namespace bo {
+
+// NOTE: An on-disk cache of compilation results, addressed by a hash of
+//       everything that went into producing them. Entries are plain files laid
+//       out as `<directory>/<first two digits of the key>/<key>.<kind>`, so
+//       several boc processes can share a cache: entries are renamed into place
+//       whole, and the statistics are only updated under an exclusive lock.
+//       Looking an entry up bumps its modification time, which is what the
+//       least recently used eviction goes by once the total size of the
+//       entries grows past the configured maximum.
+class CompileCache {
+public:
+	struct Stats {
+		std::uint64_t hits { 0 };
+		std::uint64_t misses { 0 };
+		std::uint64_t evictions { 0 };
+		std::uint64_t size { 0 };
+	};
+
+	static constexpr std::uint64_t default_max_size = 1024 * 1024 * 1024;
+
+	static Result<CompileCache, Error> open(std::string directory, std::uint64_t max_size = default_max_size);
+
+	std::string_view directory() const { return m_directory; }
+	std::uint64_t max_size() const { return m_max_size; }
+
+	// NOTE: Returns the path of the entry, if there is one, and counts the
+	//       lookup as a hit or a miss.
+	Result<std::optional<std::string>, Error> find(std::string_view key, std::string_view kind);
+
+	// NOTE: A fresh path inside the cache to write a new entry to, which is
+	//       then handed to insert().
+	std::string temporary_path() const;
+
+	// NOTE: Moves a file written at temporary_path() into the cache.
+	Result<void, Error> insert(std::string_view key, std::string_view kind, std::string const& temporary_path);
+
+	// NOTE: Copies an existing file into the cache.
+	Result<void, Error> insert_copy(std::string_view key, std::string_view kind, std::string const& path);
+
+	Result<Stats, Error> stats() const;
+
+	// NOTE: Removes every entry and resets the statistics.
+	Result<void, Error> clear();
+
+private:
+	CompileCache(std::string&& directory, std::uint64_t max_size)
+	  : m_directory(std::move(directory)), m_max_size(max_size) {}
+
+	std::string entry_path(std::string_view key, std::string_view kind) const;
+
+	template<typename Update>
+	Result<void, Error> update_stats(Update const&);
+
+	Result<Stats, Error> read_stats() const;
+	Result<void, Error> write_stats(Stats const&) const;
+	Result<void, Error> evict(Stats&) const;
+
+	std::string m_directory;
+	std::uint64_t m_max_size;
+};
+
+}
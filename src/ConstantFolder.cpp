@@ -0,0 +1,753 @@
+#include "ConstantFolder.hpp"
+
+#include "Tracer.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bo {
+
+namespace {
+
+// NOTE: Integers are evaluated as the bits of their type zero extended to 64
+//       bits, so that every operation wraps like it does in the generated
+//       code once its result is truncated back to the width of its type.
+struct IntegerConstant {
+	std::uint64_t bits;
+	std::size_t size;
+	bool is_signed;
+};
+
+std::uint64_t truncate(std::uint64_t bits, std::size_t size) {
+	if (size >= sizeof(std::uint64_t)) {
+		return bits;
+	}
+
+	return bits & ((std::uint64_t(1) << (size * 8)) - 1);
+}
+
+std::int64_t sign_extend(std::uint64_t bits, std::size_t size) {
+	auto shift = (sizeof(std::uint64_t) - size) * 8;
+	return static_cast<std::int64_t>(bits << shift) >> shift;
+}
+
+// NOTE: The digits of a literal are kept as written, prefix included. Only
+//       folded literals can be negative, see make_integer_literal().
+std::optional<std::uint64_t> parse_integer_literal(std::string_view text) {
+	auto is_negative = text.starts_with('-');
+	if (is_negative) {
+		text.remove_prefix(1);
+	}
+
+	int base = 10;
+	if (text.size() > 2 && text[0] == '0') {
+		switch (text[1]) {
+		case 'b':
+			base = 2;
+			break;
+		case 'o':
+			base = 8;
+			break;
+		case 'x':
+			base = 16;
+			break;
+		}
+	}
+
+	if (base != 10) {
+		text.remove_prefix(2);
+	}
+
+	std::uint64_t value;
+	auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value, base);
+	if (error != std::errc() || end != text.data() + text.size()) {
+		return {};
+	}
+
+	return is_negative ? -value : value;
+}
+
+// NOTE: Char literals are kept as written, quotes included. The lexer only
+//       accepts escapes of ASCII characters.
+std::optional<int> parse_char_literal(std::string_view text) {
+	text = text.substr(1, text.size() - 2);
+	if (text.size() == 1) {
+		return text[0];
+	}
+
+	if (text.size() < 2 || text[0] != '\\') {
+		return {};
+	}
+
+	switch (text[1]) {
+	case '\'':
+		return '\'';
+	case '\\':
+		return '\\';
+	case 'n':
+		return '\n';
+	case 'r':
+		return '\r';
+	case 't':
+		return '\t';
+	case '0':
+		return '\0';
+	case 'x':
+		{
+			int value;
+			auto [end, error] = std::from_chars(text.data() + 2, text.data() + text.size(), value, 16);
+			if (error != std::errc() || end != text.data() + text.size()) {
+				return {};
+			}
+
+			return value;
+		}
+	}
+
+	return {};
+}
+
+bool is_literal(CheckedAST::Expression const* expression) {
+	return expression->is_integer_literal() || expression->is_char_literal() || expression->is_boolean_literal();
+}
+
+template<typename T>
+std::optional<bool> compare(AST::BinaryOperator op, T lhs, T rhs) {
+	switch (op) {
+	case AST::BinaryOperator::LessThan:
+		return lhs < rhs;
+	case AST::BinaryOperator::GreaterThan:
+		return lhs > rhs;
+	case AST::BinaryOperator::LessThanOrEqualTo:
+		return lhs <= rhs;
+	case AST::BinaryOperator::GreaterThanOrEqualTo:
+		return lhs >= rhs;
+	case AST::BinaryOperator::EqualTo:
+		return lhs == rhs;
+	case AST::BinaryOperator::NotEqualTo:
+		return lhs != rhs;
+	default:
+		return {};
+	}
+}
+
+// NOTE: The generated code does arithmetic on operands promoted to at least an
+//       int, which is signed for every type narrower than it, unsigned ones
+//       included. Overflowing a signed promoted type is undefined, whatever
+//       the result is truncated to afterwards.
+bool is_promoted_signed(IntegerConstant constant) {
+	return constant.is_signed || constant.size < sizeof(std::int32_t);
+}
+
+template<typename T>
+bool overflows(AST::BinaryOperator op, T lhs, T rhs) {
+	T result;
+	switch (op) {
+	case AST::BinaryOperator::Addition:
+		return __builtin_add_overflow(lhs, rhs, &result);
+	case AST::BinaryOperator::Subtraction:
+		return __builtin_sub_overflow(lhs, rhs, &result);
+	case AST::BinaryOperator::Multiplication:
+		return __builtin_mul_overflow(lhs, rhs, &result);
+	case AST::BinaryOperator::Division:
+	case AST::BinaryOperator::Modulo:
+		return lhs == std::numeric_limits<T>::min() && rhs == -1;
+	default:
+		return false;
+	}
+}
+
+// NOTE: Both operands have the same type for the operations that can
+//       overflow.
+bool overflows_promoted_type(AST::BinaryOperator op, IntegerConstant lhs, IntegerConstant rhs) {
+	if (!is_promoted_signed(lhs)) {
+		return false;
+	}
+
+	// NOTE: Narrower unsigned values are zero extended, and fit in an int.
+	auto lhs_value = lhs.is_signed ? sign_extend(lhs.bits, lhs.size) : static_cast<std::int64_t>(lhs.bits);
+	auto rhs_value = rhs.is_signed ? sign_extend(rhs.bits, rhs.size) : static_cast<std::int64_t>(rhs.bits);
+	if (lhs.size <= sizeof(std::int32_t)) {
+		return overflows<std::int32_t>(op, static_cast<std::int32_t>(lhs_value), static_cast<std::int32_t>(rhs_value));
+	}
+
+	return overflows<std::int64_t>(op, lhs_value, rhs_value);
+}
+
+// NOTE: Returns no value where the generated code would have undefined
+//       behavior, so that it is left to the program to run into it.
+std::optional<std::uint64_t> evaluate_integer_operation(AST::BinaryOperator op, IntegerConstant lhs, IntegerConstant rhs) {
+	if (overflows_promoted_type(op, lhs, rhs)) {
+		return {};
+	}
+
+	switch (op) {
+	case AST::BinaryOperator::Addition:
+		return lhs.bits + rhs.bits;
+	case AST::BinaryOperator::Subtraction:
+		return lhs.bits - rhs.bits;
+	case AST::BinaryOperator::Multiplication:
+		return lhs.bits * rhs.bits;
+	case AST::BinaryOperator::BitwiseAnd:
+		return lhs.bits & rhs.bits;
+	case AST::BinaryOperator::BitwiseXor:
+		return lhs.bits ^ rhs.bits;
+	case AST::BinaryOperator::BitwiseOr:
+		return lhs.bits | rhs.bits;
+	case AST::BinaryOperator::Division:
+	case AST::BinaryOperator::Modulo:
+		{
+			if (rhs.bits == 0) {
+				return {};
+			}
+
+			if (!lhs.is_signed) {
+				return op == AST::BinaryOperator::Division ? lhs.bits / rhs.bits : lhs.bits % rhs.bits;
+			}
+
+			auto dividend = sign_extend(lhs.bits, lhs.size);
+			auto divisor = sign_extend(rhs.bits, rhs.size);
+			return static_cast<std::uint64_t>(op == AST::BinaryOperator::Division ? dividend / divisor : dividend % divisor);
+		}
+	case AST::BinaryOperator::BitwiseLeftShift:
+	case AST::BinaryOperator::BitwiseRightShift:
+		{
+			// NOTE: The left operand is promoted to at least an int before being
+			//       shifted, and the amount of the shift must fit in it.
+			auto promoted_width = std::max<std::size_t>(lhs.size, sizeof(std::int32_t)) * 8;
+			if ((rhs.is_signed && sign_extend(rhs.bits, rhs.size) < 0) || rhs.bits >= promoted_width) {
+				return {};
+			}
+
+			if (op == AST::BinaryOperator::BitwiseLeftShift) {
+				return lhs.bits << rhs.bits;
+			}
+
+			return lhs.is_signed ? static_cast<std::uint64_t>(sign_extend(lhs.bits, lhs.size) >> rhs.bits) : lhs.bits >> rhs.bits;
+		}
+	default:
+		return {};
+	}
+}
+
+}
+
+void ConstantFolder::fold() {
+	TraceScope trace { "fold", "program" };
+	std::vector<std::size_t> function_ids;
+	for (std::size_t id = 0; id < m_program.functions().size(); ++id) {
+		if (!m_program.get_function(id)->is_builtin()) {
+			function_ids.push_back(id);
+		}
+	}
+
+	constexpr std::size_t minimum_bodies_per_worker = 16;
+	auto body_count = function_ids.size();
+	auto worker_count = std::clamp<std::size_t>(body_count / minimum_bodies_per_worker, 1, m_thread_count);
+	std::vector<ConstantFolder> workers;
+	workers.reserve(worker_count);
+	for (std::size_t i = 0; i < worker_count; ++i) {
+		workers.push_back(ConstantFolder { m_program, m_program.create_arena() });
+	}
+
+	std::vector<CheckedAST::Function const*> folded_functions(body_count, nullptr);
+	parallel_for(body_count, worker_count, [&](std::size_t worker, std::size_t i) {
+		folded_functions[i] = workers[worker].fold_function(m_program.get_function(function_ids[i]));
+	});
+
+	for (std::size_t i = 0; i < body_count; ++i) {
+		if (folded_functions[i] != m_program.get_function(function_ids[i])) {
+			m_program.replace_function(function_ids[i], folded_functions[i]);
+		}
+	}
+
+	for (auto const& worker : workers) {
+		m_folded_node_count += worker.m_folded_node_count;
+	}
+}
+
+// NOTE: Every fold_* function returns the node it was given when nothing in it
+//       changed, so that only the paths leading to folded nodes are copied.
+CheckedAST::Function const* ConstantFolder::fold_function(CheckedAST::Function const* function) {
+	TraceScope trace { "fold", function->name().view() };
+	auto body = fold_block_expression(function->body());
+	if (body == function->body()) {
+		return function;
+	}
+
+	return m_arena.make<CheckedAST::Function>(function->name(), function->parameters(), function->return_type_id(), body, function->is_builtin(), function->span());
+}
+
+CheckedAST::BlockExpression const* ConstantFolder::fold_block_expression(CheckedAST::BlockExpression const* block_expression) {
+	bool has_changed = false;
+	std::vector<CheckedAST::Statement const*> statements;
+	statements.reserve(block_expression->statements().size());
+	for (auto statement : block_expression->statements()) {
+		auto folded_statement = fold_statement(statement);
+		has_changed = has_changed || folded_statement != statement;
+		if (folded_statement) {
+			statements.push_back(folded_statement);
+		}
+	}
+
+	if (!has_changed) {
+		return block_expression;
+	}
+
+	return m_arena.make<CheckedAST::BlockExpression>(m_arena.make_array(statements), block_expression->contains_return_statement(), block_expression->scope_id(), block_expression->type_id(), block_expression->span());
+}
+
+CheckedAST::Statement const* ConstantFolder::fold_statement(CheckedAST::Statement const* statement) {
+	switch (statement->kind()) {
+	case CheckedAST::Kind::ExpressionStatement:
+		{
+			auto expression_statement = static_cast<CheckedAST::ExpressionStatement const*>(statement);
+			auto expression = fold_expression(expression_statement->expression());
+			if (expression == expression_statement->expression()) {
+				return statement;
+			}
+
+			// NOTE: What is left of an `if` whose branch was pruned.
+			if (expression->is_block_expression() && static_cast<CheckedAST::BlockExpression const*>(expression)->statements().empty()) {
+				return nullptr;
+			}
+
+			return m_arena.make<CheckedAST::ExpressionStatement>(expression, expression_statement->ends_with_semicolon(), expression_statement->type_id(), expression_statement->span());
+		}
+	case CheckedAST::Kind::VariableDeclarationStatement:
+		{
+			auto variable_declaration_statement = static_cast<CheckedAST::VariableDeclarationStatement const*>(statement);
+			if (!variable_declaration_statement->initializer()) {
+				return statement;
+			}
+
+			auto initializer = fold_expression(variable_declaration_statement->initializer());
+			if (initializer == variable_declaration_statement->initializer()) {
+				return statement;
+			}
+
+			return m_arena.make<CheckedAST::VariableDeclarationStatement>(variable_declaration_statement->variable_id(), initializer, variable_declaration_statement->span());
+		}
+	case CheckedAST::Kind::InfiniteForStatement:
+	case CheckedAST::Kind::ForWithConditionStatement:
+	case CheckedAST::Kind::ForWithRangeStatement:
+		return fold_for_statement(static_cast<CheckedAST::ForStatement const*>(statement));
+	case CheckedAST::Kind::ReturnStatement:
+		{
+			auto return_statement = static_cast<CheckedAST::ReturnStatement const*>(statement);
+			if (!return_statement->expression()) {
+				return statement;
+			}
+
+			auto expression = fold_expression(return_statement->expression());
+			if (expression == return_statement->expression()) {
+				return statement;
+			}
+
+			return m_arena.make<CheckedAST::ReturnStatement>(expression, return_statement->span());
+		}
+	default:
+		assert(false && "Statement not handled");
+	}
+}
+
+CheckedAST::Statement const* ConstantFolder::fold_for_statement(CheckedAST::ForStatement const* for_statement) {
+	auto body = fold_block_expression(for_statement->body());
+
+	if (for_statement->is_infinite()) {
+		if (body == for_statement->body()) {
+			return for_statement;
+		}
+
+		return m_arena.make<CheckedAST::InfiniteForStatement>(body, for_statement->span());
+	}
+
+	if (for_statement->is_with_condition()) {
+		auto for_with_condition = static_cast<CheckedAST::ForWithConditionStatement const*>(for_statement);
+		auto condition = fold_expression(for_with_condition->condition());
+		if (condition->is_boolean_literal()) {
+			++m_folded_node_count;
+			if (!static_cast<CheckedAST::BooleanLiteral const*>(condition)->value()) {
+				return nullptr;
+			}
+
+			return m_arena.make<CheckedAST::InfiniteForStatement>(body, for_statement->span());
+		}
+
+		if (condition == for_with_condition->condition() && body == for_statement->body()) {
+			return for_statement;
+		}
+
+		return m_arena.make<CheckedAST::ForWithConditionStatement>(condition, body, for_statement->span());
+	}
+
+	auto for_with_range = static_cast<CheckedAST::ForWithRangeStatement const*>(for_statement);
+	auto range_expression = fold_expression(for_with_range->range_expression());
+
+	// NOTE: A range only iterates by incrementing its start until it equals
+	//       the end converted to the type of the start, so only an exclusive
+	//       range whose bounds are equal is known to be empty: one that starts
+	//       after its end wraps around.
+	if (range_expression->is_range_expression()) {
+		auto range = static_cast<CheckedAST::RangeExpression const*>(range_expression);
+		if (!range->is_inclusive() && range->start()->is_integer_literal() && range->end()->is_integer_literal()) {
+			auto start = parse_integer_literal(static_cast<CheckedAST::IntegerLiteral const*>(range->start())->value());
+			auto end = parse_integer_literal(static_cast<CheckedAST::IntegerLiteral const*>(range->end())->value());
+			auto const& start_traits = m_program.get_type(range->start()->type_id()).traits();
+			auto const& end_traits = m_program.get_type(range->end()->type_id()).traits();
+			if (start && end) {
+				auto end_bits = truncate(*end, end_traits.size);
+				if (end_traits.is_signed) {
+					end_bits = static_cast<std::uint64_t>(sign_extend(end_bits, end_traits.size));
+				}
+
+				if (truncate(*start, start_traits.size) == truncate(end_bits, start_traits.size)) {
+					++m_folded_node_count;
+					return nullptr;
+				}
+			}
+		}
+	}
+
+	if (range_expression == for_with_range->range_expression() && body == for_statement->body()) {
+		return for_statement;
+	}
+
+	return m_arena.make<CheckedAST::ForWithRangeStatement>(for_with_range->range_variable_id(), range_expression, body, for_statement->span());
+}
+
+CheckedAST::Expression const* ConstantFolder::fold_expression(CheckedAST::Expression const* expression) {
+	switch (expression->kind()) {
+	case CheckedAST::Kind::ParenthesizedExpression:
+		{
+			auto parenthesized_expression = static_cast<CheckedAST::ParenthesizedExpression const*>(expression);
+			auto inner_expression = fold_expression(parenthesized_expression->expression());
+			if (is_literal(inner_expression)) {
+				return inner_expression;
+			}
+
+			if (inner_expression == parenthesized_expression->expression()) {
+				return expression;
+			}
+
+			return m_arena.make<CheckedAST::ParenthesizedExpression>(inner_expression, expression->type_id(), expression->span());
+		}
+	case CheckedAST::Kind::IntegerLiteral:
+	case CheckedAST::Kind::CharLiteral:
+	case CheckedAST::Kind::BooleanLiteral:
+	case CheckedAST::Kind::Identifier:
+		return expression;
+	case CheckedAST::Kind::BinaryExpression:
+		return fold_binary_expression(static_cast<CheckedAST::BinaryExpression const*>(expression));
+	case CheckedAST::Kind::UnaryExpression:
+		return fold_unary_expression(static_cast<CheckedAST::UnaryExpression const*>(expression));
+	case CheckedAST::Kind::AssignmentExpression:
+		{
+			auto assignment_expression = static_cast<CheckedAST::AssignmentExpression const*>(expression);
+			auto lhs = fold_expression(assignment_expression->lhs());
+			auto rhs = fold_expression(assignment_expression->rhs());
+			if (lhs == assignment_expression->lhs() && rhs == assignment_expression->rhs()) {
+				return expression;
+			}
+
+			return m_arena.make<CheckedAST::AssignmentExpression>(lhs, rhs, assignment_expression->op(), expression->type_id(), expression->span());
+		}
+	case CheckedAST::Kind::UpdateExpression:
+		{
+			auto update_expression = static_cast<CheckedAST::UpdateExpression const*>(expression);
+			auto operand = fold_expression(update_expression->operand());
+			if (operand == update_expression->operand()) {
+				return expression;
+			}
+
+			return m_arena.make<CheckedAST::UpdateExpression>(operand, update_expression->op(), update_expression->is_prefixed(), expression->type_id(), expression->span());
+		}
+	case CheckedAST::Kind::PointerDereferenceExpression:
+		{
+			auto pointer_dereference_expression = static_cast<CheckedAST::PointerDereferenceExpression const*>(expression);
+			auto operand = fold_expression(pointer_dereference_expression->operand());
+			if (operand == pointer_dereference_expression->operand()) {
+				return expression;
+			}
+
+			return m_arena.make<CheckedAST::PointerDereferenceExpression>(operand, expression->type_id(), expression->span());
+		}
+	case CheckedAST::Kind::AddressOfExpression:
+		{
+			auto address_of_expression = static_cast<CheckedAST::AddressOfExpression const*>(expression);
+			auto operand = fold_expression(address_of_expression->operand());
+			if (operand == address_of_expression->operand()) {
+				return expression;
+			}
+
+			return m_arena.make<CheckedAST::AddressOfExpression>(operand, expression->type_id(), expression->span());
+		}
+	case CheckedAST::Kind::RangeExpression:
+		{
+			auto range_expression = static_cast<CheckedAST::RangeExpression const*>(expression);
+			auto start = fold_expression(range_expression->start());
+			auto end = fold_expression(range_expression->end());
+			if (start == range_expression->start() && end == range_expression->end()) {
+				return expression;
+			}
+
+			return m_arena.make<CheckedAST::RangeExpression>(start, end, range_expression->is_inclusive(), expression->type_id(), expression->span());
+		}
+	case CheckedAST::Kind::BlockExpression:
+		return fold_block_expression(static_cast<CheckedAST::BlockExpression const*>(expression));
+	case CheckedAST::Kind::IfExpression:
+		return fold_if_expression(static_cast<CheckedAST::IfExpression const*>(expression));
+	case CheckedAST::Kind::FunctionCallExpression:
+		return fold_function_call_expression(static_cast<CheckedAST::FunctionCallExpression const*>(expression));
+	case CheckedAST::Kind::ArrayExpression:
+		return fold_array_expression(static_cast<CheckedAST::ArrayExpression const*>(expression));
+	case CheckedAST::Kind::ArraySubscriptExpression:
+		{
+			auto array_subscript_expression = static_cast<CheckedAST::ArraySubscriptExpression const*>(expression);
+			auto array = fold_expression(array_subscript_expression->array());
+			auto index = fold_expression(array_subscript_expression->index());
+			if (array == array_subscript_expression->array() && index == array_subscript_expression->index()) {
+				return expression;
+			}
+
+			return m_arena.make<CheckedAST::ArraySubscriptExpression>(array, index, expression->type_id(), expression->span());
+		}
+	default:
+		assert(false && "Expression not handled");
+	}
+}
+
+CheckedAST::Expression const* ConstantFolder::fold_binary_expression(CheckedAST::BinaryExpression const* binary_expression) {
+	auto lhs = fold_expression(binary_expression->lhs());
+	auto rhs = fold_expression(binary_expression->rhs());
+	if (auto result = evaluate_binary_expression(binary_expression, lhs, rhs)) {
+		++m_folded_node_count;
+		return result;
+	}
+
+	if (lhs == binary_expression->lhs() && rhs == binary_expression->rhs()) {
+		return binary_expression;
+	}
+
+	return m_arena.make<CheckedAST::BinaryExpression>(lhs, rhs, binary_expression->op(), binary_expression->type_id(), binary_expression->span());
+}
+
+CheckedAST::Expression const* ConstantFolder::fold_unary_expression(CheckedAST::UnaryExpression const* unary_expression) {
+	auto operand = fold_expression(unary_expression->operand());
+	if (auto result = evaluate_unary_expression(unary_expression, operand)) {
+		++m_folded_node_count;
+		return result;
+	}
+
+	if (operand == unary_expression->operand()) {
+		return unary_expression;
+	}
+
+	return m_arena.make<CheckedAST::UnaryExpression>(operand, unary_expression->op(), unary_expression->type_id(), unary_expression->span());
+}
+
+CheckedAST::Expression const* ConstantFolder::fold_if_expression(CheckedAST::IfExpression const* if_expression) {
+	auto condition = fold_expression(if_expression->condition());
+	auto then = fold_block_expression(if_expression->then());
+	auto else_ = if_expression->else_() ? fold_expression(if_expression->else_()) : nullptr;
+
+	// NOTE: Both branches have the type of the `if`, so the one taken can
+	//       stand in for it.
+	if (condition->is_boolean_literal()) {
+		++m_folded_node_count;
+		if (static_cast<CheckedAST::BooleanLiteral const*>(condition)->value()) {
+			return then;
+		}
+
+		if (else_) {
+			return else_;
+		}
+
+		std::vector<CheckedAST::Statement const*> no_statements;
+		return m_arena.make<CheckedAST::BlockExpression>(m_arena.make_array(no_statements), false, then->scope_id(), Types::builtin_void_id, if_expression->span());
+	}
+
+	// NOTE: An `else if` whose branch was pruned leaves nothing to do.
+	if (else_ != if_expression->else_() && else_->is_block_expression() && static_cast<CheckedAST::BlockExpression const*>(else_)->statements().empty()) {
+		else_ = nullptr;
+	}
+
+	if (condition == if_expression->condition() && then == if_expression->then() && else_ == if_expression->else_()) {
+		return if_expression;
+	}
+
+	return m_arena.make<CheckedAST::IfExpression>(condition, then, else_, if_expression->type_id(), if_expression->span());
+}
+
+CheckedAST::Expression const* ConstantFolder::fold_function_call_expression(CheckedAST::FunctionCallExpression const* function_call_expression) {
+	bool has_changed = false;
+	std::vector<CheckedAST::FunctionArgument> arguments;
+	arguments.reserve(function_call_expression->arguments().size());
+	for (auto const& argument : function_call_expression->arguments()) {
+		auto value = fold_expression(argument.value);
+		has_changed = has_changed || value != argument.value;
+		arguments.push_back({ argument.name, value });
+	}
+
+	if (!has_changed) {
+		return function_call_expression;
+	}
+
+	return m_arena.make<CheckedAST::FunctionCallExpression>(function_call_expression->function_id(), m_arena.make_array(arguments), function_call_expression->type_id(), function_call_expression->span());
+}
+
+CheckedAST::Expression const* ConstantFolder::fold_array_expression(CheckedAST::ArrayExpression const* array_expression) {
+	bool has_changed = false;
+	std::vector<CheckedAST::Expression const*> elements;
+	elements.reserve(array_expression->elements().size());
+	for (auto element : array_expression->elements()) {
+		auto folded_element = fold_expression(element);
+		has_changed = has_changed || folded_element != element;
+		elements.push_back(folded_element);
+	}
+
+	if (!has_changed) {
+		return array_expression;
+	}
+
+	return m_arena.make<CheckedAST::ArrayExpression>(m_arena.make_array(elements), array_expression->type_id(), array_expression->span());
+}
+
+CheckedAST::Expression const* ConstantFolder::evaluate_binary_expression(CheckedAST::BinaryExpression const* binary_expression, CheckedAST::Expression const* lhs, CheckedAST::Expression const* rhs) {
+	auto op = binary_expression->op();
+	auto span = binary_expression->span();
+
+	// NOTE: The right operand of a logical operator is only evaluated when the
+	//       left one doesn't decide the result, so it can go away along with
+	//       whatever it does.
+	if (op == AST::BinaryOperator::LogicalAnd || op == AST::BinaryOperator::LogicalOr) {
+		if (!lhs->is_boolean_literal()) {
+			return nullptr;
+		}
+
+		auto lhs_value = static_cast<CheckedAST::BooleanLiteral const*>(lhs)->value();
+		if (lhs_value == (op == AST::BinaryOperator::LogicalOr)) {
+			return make_boolean_literal(lhs_value, span);
+		}
+
+		return rhs;
+	}
+
+	if (lhs->is_boolean_literal() && rhs->is_boolean_literal()) {
+		auto result = compare(op, static_cast<CheckedAST::BooleanLiteral const*>(lhs)->value(), static_cast<CheckedAST::BooleanLiteral const*>(rhs)->value());
+		return result ? make_boolean_literal(*result, span) : nullptr;
+	}
+
+	if (lhs->is_char_literal() && rhs->is_char_literal()) {
+		auto lhs_value = parse_char_literal(static_cast<CheckedAST::CharLiteral const*>(lhs)->value());
+		auto rhs_value = parse_char_literal(static_cast<CheckedAST::CharLiteral const*>(rhs)->value());
+		if (!lhs_value || !rhs_value) {
+			return nullptr;
+		}
+
+		auto result = compare(op, *lhs_value, *rhs_value);
+		return result ? make_boolean_literal(*result, span) : nullptr;
+	}
+
+	if (!lhs->is_integer_literal() || !rhs->is_integer_literal()) {
+		return nullptr;
+	}
+
+	auto lhs_value = parse_integer_literal(static_cast<CheckedAST::IntegerLiteral const*>(lhs)->value());
+	auto rhs_value = parse_integer_literal(static_cast<CheckedAST::IntegerLiteral const*>(rhs)->value());
+	if (!lhs_value || !rhs_value) {
+		return nullptr;
+	}
+
+	// NOTE: A literal is converted to its type, wrapping if it doesn't fit.
+	auto const& lhs_traits = m_program.get_type(lhs->type_id()).traits();
+	auto const& rhs_traits = m_program.get_type(rhs->type_id()).traits();
+	auto lhs_constant = IntegerConstant { truncate(*lhs_value, lhs_traits.size), lhs_traits.size, lhs_traits.is_signed };
+	auto rhs_constant = IntegerConstant { truncate(*rhs_value, rhs_traits.size), rhs_traits.size, rhs_traits.is_signed };
+
+	// NOTE: Integers of different sizes can be compared as long as they have the
+	//       same signedness, which happens on their actual values.
+	if (binary_expression->type_id() == Types::builtin_bool_id) {
+		auto result = lhs_constant.is_signed ? compare(op, sign_extend(lhs_constant.bits, lhs_constant.size), sign_extend(rhs_constant.bits, rhs_constant.size)) : compare(op, lhs_constant.bits, rhs_constant.bits);
+		return result ? make_boolean_literal(*result, span) : nullptr;
+	}
+
+	auto result = evaluate_integer_operation(op, lhs_constant, rhs_constant);
+	if (!result) {
+		return nullptr;
+	}
+
+	return make_integer_literal(truncate(*result, lhs_constant.size), binary_expression->type_id(), span);
+}
+
+CheckedAST::Expression const* ConstantFolder::evaluate_unary_expression(CheckedAST::UnaryExpression const* unary_expression, CheckedAST::Expression const* operand) {
+	auto span = unary_expression->span();
+	if (operand->is_boolean_literal()) {
+		assert(unary_expression->op() == AST::UnaryOperator::LogicalNot);
+		return make_boolean_literal(!static_cast<CheckedAST::BooleanLiteral const*>(operand)->value(), span);
+	}
+
+	if (!operand->is_integer_literal()) {
+		return nullptr;
+	}
+
+	auto value = parse_integer_literal(static_cast<CheckedAST::IntegerLiteral const*>(operand)->value());
+	if (!value) {
+		return nullptr;
+	}
+
+	switch (unary_expression->op()) {
+	case AST::UnaryOperator::Positive:
+		return make_integer_literal(*value, unary_expression->type_id(), span);
+	case AST::UnaryOperator::Negative:
+		{
+			// NOTE: Negating overflows wherever subtracting from zero does.
+			auto const& traits = m_program.get_type(operand->type_id()).traits();
+			auto operand_constant = IntegerConstant { truncate(*value, traits.size), traits.size, traits.is_signed };
+			if (overflows_promoted_type(AST::BinaryOperator::Subtraction, { 0, traits.size, traits.is_signed }, operand_constant)) {
+				return nullptr;
+			}
+
+			return make_integer_literal(-*value, unary_expression->type_id(), span);
+		}
+	case AST::UnaryOperator::BitwiseNot:
+		return make_integer_literal(~*value, unary_expression->type_id(), span);
+	default:
+		return nullptr;
+	}
+}
+
+// NOTE: Folded integers are written in the unsuffixed form, which the
+//       transpiler casts to their type, so negative values read naturally.
+//       What doesn't fit in a signed 64-bit literal is written in hexadecimal,
+//       which C++ gives an unsigned type instead.
+CheckedAST::Expression const* ConstantFolder::make_integer_literal(std::uint64_t bits, Types::Id type_id, Span span) {
+	auto const& traits = m_program.get_type(type_id).traits();
+	bits = truncate(bits, traits.size);
+
+	std::string text;
+	if (traits.is_signed && sign_extend(bits, traits.size) != std::numeric_limits<std::int64_t>::min()) {
+		text = fmt::format("{}", sign_extend(bits, traits.size));
+	} else if (!traits.is_signed && bits <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+		text = fmt::format("{}", bits);
+	} else {
+		text = fmt::format("{:#x}", bits);
+	}
+
+	auto value = m_arena.make_array(std::span<char const> { text });
+	return m_arena.make<CheckedAST::IntegerLiteral>(std::string_view { value.data(), value.size() }, std::string_view {}, type_id, span);
+}
+
+CheckedAST::Expression const* ConstantFolder::make_boolean_literal(bool value, Span span) {
+	return m_arena.make<CheckedAST::BooleanLiteral>(value, span);
+}
+
+}
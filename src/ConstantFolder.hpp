@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CheckedAST.hpp"
+#include "utils/Arena.hpp"
+#include "utils/Parallel.hpp"
+
+#include <cstdint>
+
+namespace bo {
+
+// NOTE: Evaluates what can be known at compile time in a checked program:
+//       operators whose operands are literals are replaced by their result,
+//       truncated to its fixed-width integer type like in the generated code,
+//       `if`s with a literal condition are replaced by the branch they take,
+//       and loops that can't run are dropped. Expressions whose result depends
+//       on the platform or would be undefined in the generated code (a
+//       division by zero, an overflow of the signed type the operands are
+//       promoted to, a shift by more than the width of the operand, ...) are
+//       left for the program to evaluate.
+class ConstantFolder {
+public:
+	explicit ConstantFolder(CheckedAST::Program& program, std::size_t thread_count = default_thread_count())
+	  : m_program(program), m_arena(program.arena()), m_thread_count(std::max<std::size_t>(thread_count, 1)) {}
+
+	void fold();
+
+	// NOTE: Nodes replaced by a constant, plus branches and loops pruned.
+	std::size_t folded_node_count() const { return m_folded_node_count; }
+
+private:
+	// NOTE: Like the typechecker, function bodies are folded by worker
+	//       instances, each allocating the new nodes from its own arena.
+	explicit ConstantFolder(CheckedAST::Program& program, Arena& arena)
+	  : m_program(program), m_arena(arena) {}
+
+	CheckedAST::Function const* fold_function(CheckedAST::Function const*);
+	CheckedAST::BlockExpression const* fold_block_expression(CheckedAST::BlockExpression const*);
+	// NOTE: Returns nullptr for a statement that has nothing left to do.
+	CheckedAST::Statement const* fold_statement(CheckedAST::Statement const*);
+	CheckedAST::Statement const* fold_for_statement(CheckedAST::ForStatement const*);
+	CheckedAST::Expression const* fold_expression(CheckedAST::Expression const*);
+	CheckedAST::Expression const* fold_binary_expression(CheckedAST::BinaryExpression const*);
+	CheckedAST::Expression const* fold_unary_expression(CheckedAST::UnaryExpression const*);
+	CheckedAST::Expression const* fold_if_expression(CheckedAST::IfExpression const*);
+	CheckedAST::Expression const* fold_function_call_expression(CheckedAST::FunctionCallExpression const*);
+	CheckedAST::Expression const* fold_array_expression(CheckedAST::ArrayExpression const*);
+
+	CheckedAST::Expression const* evaluate_binary_expression(CheckedAST::BinaryExpression const*, CheckedAST::Expression const* lhs, CheckedAST::Expression const* rhs);
+	CheckedAST::Expression const* evaluate_unary_expression(CheckedAST::UnaryExpression const*, CheckedAST::Expression const* operand);
+
+	CheckedAST::Expression const* make_integer_literal(std::uint64_t bits, Types::Id, Span);
+	CheckedAST::Expression const* make_boolean_literal(bool, Span);
+
+	CheckedAST::Program& m_program;
+	Arena& m_arena;
+	std::size_t m_thread_count { 1 };
+	std::size_t m_folded_node_count { 0 };
+};
+
+}
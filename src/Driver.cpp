@@ -0,0 +1,203 @@
+#include "Driver.hpp"
+
+#include "ConstantFolder.hpp"
+#include "Parser.hpp"
+#include "Prelude.hpp"
+#include "System.hpp"
+#include "Tracer.hpp"
+#include "Typechecker.hpp"
+#include "utils/Hash.hpp"
+
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bo {
+
+static Result<void, Error> compile_to_cpp_uncached(SourceManager::File const& file, Transpiler::PreludeMode prelude_mode, OutputSink& sink, TimeReport& report) {
+	Arena arena;
+	report.start("parse");
+	auto parser = TRY(Parser::create(file.contents(), arena, file.base_offset()));
+	auto program = TRY(parser.parse_program());
+	report.add_count("AST nodes", arena.object_count());
+	report.add_count("AST bytes", arena.bytes_allocated());
+	report.start("typecheck");
+	Typechecker typechecker;
+	TRY(typechecker.check(program));
+	auto& checked_program = typechecker.program();
+	report.add_count("CheckedAST nodes", checked_program.node_count());
+	report.add_count("CheckedAST bytes", checked_program.node_bytes());
+	report.add_count("functions", checked_program.functions().size());
+	report.add_count("types", checked_program.type_count());
+	report.start("fold");
+	ConstantFolder folder { checked_program };
+	folder.fold();
+	report.add_count("folded nodes", folder.folded_node_count());
+	report.start("transpile");
+	Transpiler transpiler(checked_program);
+	transpiler.set_prelude_mode(prelude_mode);
+	TRY(transpiler.transpile(sink));
+	report.stop();
+	return {};
+}
+
+// NOTE: Bumped whenever the layout of cache entries changes.
+static constexpr std::string_view cache_format_version = "1";
+
+// NOTE: boc itself is identified by its executable, so that a rebuilt compiler
+//       never reuses output from the previous one.
+static std::string transpile_cache_key(SourceManager::File const& file, Transpiler::PreludeMode prelude_mode) {
+	ContentHasher hasher;
+	hasher.update_field(cache_format_version);
+	hasher.update_field(file_identity("/proc/self/exe"));
+	hasher.update_field(prelude_mode == Transpiler::PreludeMode::Include ? "include prelude" : "inline prelude");
+	hasher.update_field(file.contents());
+	return hasher.hex_digest();
+}
+
+Result<void, Error> compile_to_cpp(SourceManager::File const& file, Transpiler::PreludeMode prelude_mode, OutputSink& sink, TimeReport& report, CompileCache* cache) {
+	if (cache == nullptr) {
+		return compile_to_cpp_uncached(file, prelude_mode, sink, report);
+	}
+
+	report.start("C++ cache lookup");
+	auto key = transpile_cache_key(file, prelude_mode);
+	if (auto entry_path = TRY(cache->find(key, "cpp"))) {
+		auto entry = TRY(SourceFile::open(*entry_path));
+		auto contents = entry.contents();
+		TRY(sink.write(std::span { &contents, 1 }));
+		report.stop();
+		return {};
+	}
+
+	// NOTE: On a miss the output is also streamed into a new entry.
+	auto temporary_path = cache->temporary_path();
+	auto fd = ::open(temporary_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+	if (fd < 0) {
+		return system_error("open", temporary_path);
+	}
+
+	FileDescriptorSink entry_sink { fd };
+	TeeSink tee_sink { sink, entry_sink };
+	auto compiled = compile_to_cpp_uncached(file, prelude_mode, tee_sink, report);
+	auto closed = ::close(fd) == 0;
+	if (compiled.is_error() || !closed) {
+		auto error = compiled.is_error() ? compiled.release_error() : system_error("write", temporary_path);
+		::unlink(temporary_path.c_str());
+		return error;
+	}
+
+	return cache->insert(key, "cpp", temporary_path);
+}
+
+static std::string_view file_stem(std::string_view path) {
+	if (auto slash = path.rfind('/'); slash != std::string_view::npos) {
+		path.remove_prefix(slash + 1);
+	}
+
+	if (auto dot = path.rfind('.'); dot != std::string_view::npos && dot != 0) {
+		path.remove_suffix(path.size() - dot);
+	}
+
+	return path;
+}
+
+static std::string build_cache_key(SourceManager::File const& file, BuildOptions const& options, Transpiler::PreludeMode prelude_mode) {
+	ContentHasher hasher;
+	hasher.update_field(transpile_cache_key(file, prelude_mode));
+	hasher.update_field(options.compiler);
+	hasher.update_field(file_identity(find_program(options.compiler).value_or(options.compiler)));
+	for (auto const& flag : options.compiler_flags) {
+		hasher.update_field(flag);
+	}
+
+	return hasher.hex_digest();
+}
+
+Result<void, Error> build(BuildOptions const& options, SourceManager& sources, TimeReport& report) {
+	if (::mkdir(options.work_directory.c_str(), 0777) < 0 && errno != EEXIST) {
+		return system_error("create directory", options.work_directory);
+	}
+
+	std::optional<CompileCache> opened_cache;
+	if (options.cache_directory) {
+		opened_cache = TRY(CompileCache::open(*options.cache_directory, options.cache_max_size));
+	}
+
+	auto* cache = opened_cache ? &*opened_cache : nullptr;
+
+	report.start("read");
+	auto const& file = *TRY(sources.load(options.source_path));
+	auto prelude_mode = options.precompile_prelude ? Transpiler::PreludeMode::Include : Transpiler::PreludeMode::Inline;
+	// NOTE: Like rustc, the executable is named after the source by default.
+	auto output_path = options.output_path.empty() ? std::string { file_stem(options.source_path) } : options.output_path;
+
+	std::string key;
+	if (cache != nullptr) {
+		report.start("executable cache lookup");
+		key = build_cache_key(file, options, prelude_mode);
+		if (auto entry_path = TRY(cache->find(key, "exe"))) {
+			report.start("copy from cache");
+			TRY(copy_file(*entry_path, output_path, 0777));
+			report.stop();
+			return {};
+		}
+	}
+
+	if (options.precompile_prelude) {
+		report.start("precompile prelude");
+		TRY(write_precompiled_prelude(options.work_directory, options.compiler, options.compiler_flags));
+	}
+
+	auto cpp_path = fmt::format("{}/{}.cpp", options.work_directory, file_stem(options.source_path));
+	auto fd = ::open(cpp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+	if (fd < 0) {
+		return system_error("open", cpp_path);
+	}
+
+	FileDescriptorSink sink { fd };
+	auto compiled = compile_to_cpp(file, prelude_mode, sink, report, cache);
+	if (::close(fd) < 0 && compiled.is_value()) {
+		return system_error("write", cpp_path);
+	}
+
+	TRY(compiled);
+
+	// NOTE: The whole program is a single translation unit, so it's compiled
+	//       and linked by the same invocation.
+	std::vector<std::string> arguments { options.compiler };
+	arguments.insert(arguments.end(), options.compiler_flags.begin(), options.compiler_flags.end());
+	if (options.precompile_prelude) {
+		arguments.push_back(fmt::format("-I{}", options.work_directory));
+	}
+
+	arguments.insert(arguments.end(), { cpp_path, "-o", output_path });
+	if (options.verbose) {
+		fmt::print(stderr, "{}\n", fmt::join(arguments, " "));
+	}
+
+	report.start("compile");
+	int status;
+	{
+		TraceScope trace { "compile", options.compiler };
+		status = TRY(run_process(arguments));
+	}
+	report.stop();
+	if (status != 0) {
+		return Error { fmt::format("'{}' exited with status {} while compiling '{}'", options.compiler, status, cpp_path), Span { 0, 0 } };
+	}
+
+	if (cache != nullptr) {
+		report.start("store in cache");
+		TRY(cache->insert_copy(key, "exe", output_path));
+		report.stop();
+	}
+
+	return {};
+}
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CompileCache.hpp"
+#include "Error.hpp"
+#include "OutputSink.hpp"
+#include "SourceManager.hpp"
+#include "TimeReport.hpp"
+#include "Transpiler.hpp"
+#include "utils/Result.hpp"
+
+namespace bo {
+
+// NOTE: Runs every stage from parsing to transpiling on `file`, streaming the
+//       generated C++ into `sink`. With a cache, output generated earlier for
+//       the same source by the same boc is reused instead.
+Result<void, Error> compile_to_cpp(SourceManager::File const& file, Transpiler::PreludeMode, OutputSink& sink, TimeReport&, CompileCache* = nullptr);
+
+struct BuildOptions {
+	std::string source_path;
+	// NOTE: Defaults to the name of the source file without its extension.
+	std::string output_path;
+	// NOTE: Where the generated C++ and the precompiled prelude are kept.
+	std::string work_directory;
+	std::string compiler;
+	// NOTE: Passed to every compiler invocation, the precompiled prelude
+	//       included, which has to see the same flags to be usable.
+	std::vector<std::string> compiler_flags;
+	bool precompile_prelude { false };
+	// NOTE: Echo the compiler command line.
+	bool verbose { false };
+	bool time_report { false };
+	std::optional<std::string> cache_directory;
+	std::uint64_t cache_max_size { CompileCache::default_max_size };
+};
+
+// NOTE: Compiles a source file all the way to a native executable by handing
+//       the generated C++ to the host compiler. With a cache, an executable
+//       built earlier from the same source with the same compiler and flags is
+//       copied instead, skipping every stage. The source is loaded into
+//       `sources`, for errors to be reported against.
+Result<void, Error> build(BuildOptions const&, SourceManager& sources, TimeReport&);
+
+}
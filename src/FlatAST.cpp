@@ -0,0 +1,586 @@
+#include "FlatAST.hpp"
+
+#include <fmt/core.h>
+
+#include <array>
+#include <cassert>
+
+namespace bo {
+
+namespace FlatAST {
+
+NodeIndex Tree::add_node(AST::Kind kind, std::uint8_t flags, std::uint32_t lhs, std::uint32_t rhs, Span span) {
+	assert(m_kinds.size() < invalid_node);
+	m_kinds.push_back(kind);
+	m_flags.push_back(flags);
+	m_lhs.push_back(lhs);
+	m_rhs.push_back(rhs);
+	m_spans.push_back(span);
+	return static_cast<NodeIndex>(m_kinds.size() - 1);
+}
+
+std::uint32_t Tree::add_string(std::string_view string) {
+	m_strings.push_back(string);
+	return static_cast<std::uint32_t>(m_strings.size() - 1);
+}
+
+std::uint32_t Tree::add_extra(std::span<std::uint32_t const> values) {
+	auto start = static_cast<std::uint32_t>(m_extra.size());
+	m_extra.insert(m_extra.end(), values.begin(), values.end());
+	return start;
+}
+
+class Flattener {
+public:
+	explicit Flattener(Tree& tree)
+	  : m_tree(tree) {}
+
+	NodeIndex flatten_program(AST::Program const* program) {
+		std::vector<std::uint32_t> functions;
+		functions.reserve(program->function_declarations().size());
+		for (auto function : program->function_declarations()) {
+			functions.push_back(flatten_function(function));
+		}
+
+		auto start = m_tree.add_extra(functions);
+		return m_tree.add_node(AST::Kind::Program, 0, start, static_cast<std::uint32_t>(functions.size()), program->span());
+	}
+
+private:
+	NodeIndex flatten_optional_expression(AST::Expression const* expression) {
+		return expression ? flatten_expression(expression) : invalid_node;
+	}
+
+	NodeIndex flatten_optional_type(AST::Type const* type) {
+		return type ? flatten_type(type) : invalid_node;
+	}
+
+	NodeIndex flatten_identifier(AST::Identifier const* identifier) {
+		return m_tree.add_node(AST::Kind::Identifier, 0, m_tree.add_string(identifier->id()), 0, identifier->span());
+	}
+
+	NodeIndex flatten_type(AST::Type const* type) {
+		auto inner_type = flatten_optional_type(type->inner_type());
+		auto array_size = flatten_optional_expression(type->array_size());
+		auto name = type->name() ? flatten_identifier(type->name()) : invalid_node;
+		auto extra = m_tree.add_extra(std::array { array_size, name });
+		return m_tree.add_node(AST::Kind::Type, static_cast<std::uint8_t>(type->flags()), inner_type, extra, type->span());
+	}
+
+	NodeIndex flatten_function(AST::FunctionDeclarationStatement const* function) {
+		auto name = flatten_identifier(function->name());
+
+		std::vector<std::uint32_t> parameters;
+		parameters.reserve(function->parameters().size() * 3);
+		for (auto const& parameter : function->parameters()) {
+			parameters.push_back(flatten_identifier(parameter.name));
+			parameters.push_back(flatten_type(parameter.type));
+			parameters.push_back(parameter.is_anonymous);
+		}
+
+		auto return_type = flatten_type(function->return_type());
+		auto body = flatten_expression(function->body());
+		auto extra = m_tree.add_extra(std::array { return_type, body, static_cast<std::uint32_t>(function->parameters().size()) });
+		m_tree.add_extra(parameters);
+		return m_tree.add_node(AST::Kind::FunctionDeclarationStatement, 0, name, extra, function->span());
+	}
+
+	NodeIndex flatten_statement(AST::Statement const* statement) {
+		switch (statement->kind()) {
+		case AST::Kind::ExpressionStatement:
+			{
+				auto expression_statement = static_cast<AST::ExpressionStatement const*>(statement);
+				auto expression = flatten_expression(expression_statement->expression());
+				return m_tree.add_node(AST::Kind::ExpressionStatement, expression_statement->ends_with_semicolon(), expression, 0, statement->span());
+			}
+		case AST::Kind::VariableDeclarationStatement:
+			{
+				auto variable_declaration = static_cast<AST::VariableDeclarationStatement const*>(statement);
+				auto identifier = flatten_identifier(variable_declaration->identifier());
+				auto type = flatten_optional_type(variable_declaration->type());
+				auto initializer = flatten_optional_expression(variable_declaration->initializer());
+				auto extra = m_tree.add_extra(std::array { type, initializer });
+				return m_tree.add_node(AST::Kind::VariableDeclarationStatement, variable_declaration->is_mutable(), identifier, extra, statement->span());
+			}
+		case AST::Kind::InfiniteForStatement:
+			{
+				auto body = flatten_expression(static_cast<AST::InfiniteForStatement const*>(statement)->body());
+				return m_tree.add_node(AST::Kind::InfiniteForStatement, 0, body, 0, statement->span());
+			}
+		case AST::Kind::ForWithConditionStatement:
+			{
+				auto for_with_condition = static_cast<AST::ForWithConditionStatement const*>(statement);
+				auto condition = flatten_expression(for_with_condition->condition());
+				auto body = flatten_expression(for_with_condition->body());
+				return m_tree.add_node(AST::Kind::ForWithConditionStatement, 0, condition, body, statement->span());
+			}
+		case AST::Kind::ForWithRangeStatement:
+			{
+				auto for_with_range = static_cast<AST::ForWithRangeStatement const*>(statement);
+				auto range_variable = flatten_identifier(for_with_range->range_variable());
+				auto range_expression = flatten_expression(for_with_range->range_expression());
+				auto body = flatten_expression(for_with_range->body());
+				auto extra = m_tree.add_extra(std::array { range_expression, body });
+				return m_tree.add_node(AST::Kind::ForWithRangeStatement, 0, range_variable, extra, statement->span());
+			}
+		case AST::Kind::ReturnStatement:
+			{
+				auto expression = flatten_optional_expression(static_cast<AST::ReturnStatement const*>(statement)->expression());
+				return m_tree.add_node(AST::Kind::ReturnStatement, 0, expression, 0, statement->span());
+			}
+		default:
+			assert(false && "Statement not handled");
+			return invalid_node;
+		}
+	}
+
+	NodeIndex flatten_expression(AST::Expression const* expression) {
+		auto span = expression->span();
+		switch (expression->kind()) {
+		case AST::Kind::ParenthesizedExpression:
+			{
+				auto inner = flatten_expression(static_cast<AST::ParenthesizedExpression const*>(expression)->expression());
+				return m_tree.add_node(AST::Kind::ParenthesizedExpression, 0, inner, 0, span);
+			}
+		case AST::Kind::IntegerLiteral:
+			{
+				auto integer_literal = static_cast<AST::IntegerLiteral const*>(expression);
+				auto value = m_tree.add_string(integer_literal->value());
+				auto suffix = m_tree.add_string(integer_literal->suffix());
+				return m_tree.add_node(AST::Kind::IntegerLiteral, static_cast<std::uint8_t>(integer_literal->type()), value, suffix, span);
+			}
+		case AST::Kind::CharLiteral:
+			{
+				auto value = m_tree.add_string(static_cast<AST::CharLiteral const*>(expression)->value());
+				return m_tree.add_node(AST::Kind::CharLiteral, 0, value, 0, span);
+			}
+		case AST::Kind::BooleanLiteral:
+			return m_tree.add_node(AST::Kind::BooleanLiteral, static_cast<AST::BooleanLiteral const*>(expression)->value(), 0, 0, span);
+		case AST::Kind::Identifier:
+			return flatten_identifier(static_cast<AST::Identifier const*>(expression));
+		case AST::Kind::BinaryExpression:
+			{
+				auto binary_expression = static_cast<AST::BinaryExpression const*>(expression);
+				auto lhs = flatten_expression(binary_expression->lhs());
+				auto rhs = flatten_expression(binary_expression->rhs());
+				return m_tree.add_node(AST::Kind::BinaryExpression, static_cast<std::uint8_t>(binary_expression->op()), lhs, rhs, span);
+			}
+		case AST::Kind::UnaryExpression:
+			{
+				auto unary_expression = static_cast<AST::UnaryExpression const*>(expression);
+				auto operand = flatten_expression(unary_expression->operand());
+				return m_tree.add_node(AST::Kind::UnaryExpression, static_cast<std::uint8_t>(unary_expression->op()), operand, 0, span);
+			}
+		case AST::Kind::AssignmentExpression:
+			{
+				auto assignment_expression = static_cast<AST::AssignmentExpression const*>(expression);
+				auto lhs = flatten_expression(assignment_expression->lhs());
+				auto rhs = flatten_expression(assignment_expression->rhs());
+				return m_tree.add_node(AST::Kind::AssignmentExpression, static_cast<std::uint8_t>(assignment_expression->op()), lhs, rhs, span);
+			}
+		case AST::Kind::UpdateExpression:
+			{
+				auto update_expression = static_cast<AST::UpdateExpression const*>(expression);
+				auto operand = flatten_expression(update_expression->operand());
+				auto flags = static_cast<std::uint8_t>(update_expression->op());
+				if (update_expression->is_prefixed()) {
+					flags |= update_is_prefixed_flag;
+				}
+
+				return m_tree.add_node(AST::Kind::UpdateExpression, flags, operand, 0, span);
+			}
+		case AST::Kind::PointerDereferenceExpression:
+			{
+				auto operand = flatten_expression(static_cast<AST::PointerDereferenceExpression const*>(expression)->operand());
+				return m_tree.add_node(AST::Kind::PointerDereferenceExpression, 0, operand, 0, span);
+			}
+		case AST::Kind::AddressOfExpression:
+			{
+				auto operand = flatten_expression(static_cast<AST::AddressOfExpression const*>(expression)->operand());
+				return m_tree.add_node(AST::Kind::AddressOfExpression, 0, operand, 0, span);
+			}
+		case AST::Kind::RangeExpression:
+			{
+				auto range_expression = static_cast<AST::RangeExpression const*>(expression);
+				auto start = flatten_expression(range_expression->start());
+				auto end = flatten_expression(range_expression->end());
+				return m_tree.add_node(AST::Kind::RangeExpression, range_expression->is_inclusive(), start, end, span);
+			}
+		case AST::Kind::BlockExpression:
+			{
+				auto block_expression = static_cast<AST::BlockExpression const*>(expression);
+				std::vector<std::uint32_t> statements;
+				statements.reserve(block_expression->statements().size());
+				for (auto statement : block_expression->statements()) {
+					statements.push_back(flatten_statement(statement));
+				}
+
+				auto start = m_tree.add_extra(statements);
+				return m_tree.add_node(AST::Kind::BlockExpression, 0, start, static_cast<std::uint32_t>(statements.size()), span);
+			}
+		case AST::Kind::IfExpression:
+			{
+				auto if_expression = static_cast<AST::IfExpression const*>(expression);
+				auto condition = flatten_expression(if_expression->condition());
+				auto then = flatten_expression(if_expression->then());
+				auto else_ = flatten_optional_expression(if_expression->else_());
+				auto extra = m_tree.add_extra(std::array { then, else_ });
+				return m_tree.add_node(AST::Kind::IfExpression, 0, condition, extra, span);
+			}
+		case AST::Kind::FunctionCallExpression:
+			{
+				auto function_call = static_cast<AST::FunctionCallExpression const*>(expression);
+				auto name = flatten_identifier(function_call->name());
+
+				std::vector<std::uint32_t> arguments;
+				arguments.reserve(function_call->arguments().size() * 2 + 1);
+				arguments.push_back(static_cast<std::uint32_t>(function_call->arguments().size()));
+				for (auto const& argument : function_call->arguments()) {
+					arguments.push_back(argument.name ? flatten_identifier(argument.name) : invalid_node);
+					arguments.push_back(flatten_expression(argument.value));
+				}
+
+				auto extra = m_tree.add_extra(arguments);
+				return m_tree.add_node(AST::Kind::FunctionCallExpression, 0, name, extra, span);
+			}
+		case AST::Kind::ArrayExpression:
+			{
+				auto array_expression = static_cast<AST::ArrayExpression const*>(expression);
+				std::vector<std::uint32_t> elements;
+				elements.reserve(array_expression->elements().size());
+				for (auto element : array_expression->elements()) {
+					elements.push_back(flatten_expression(element));
+				}
+
+				auto start = m_tree.add_extra(elements);
+				return m_tree.add_node(AST::Kind::ArrayExpression, 0, start, static_cast<std::uint32_t>(elements.size()), span);
+			}
+		case AST::Kind::ArraySubscriptExpression:
+			{
+				auto array_subscript = static_cast<AST::ArraySubscriptExpression const*>(expression);
+				auto array = flatten_expression(array_subscript->array());
+				auto index = flatten_expression(array_subscript->index());
+				return m_tree.add_node(AST::Kind::ArraySubscriptExpression, 0, array, index, span);
+			}
+		default:
+			assert(false && "Expression not handled!");
+			return invalid_node;
+		}
+	}
+
+	Tree& m_tree;
+};
+
+Tree flatten(AST::Program const* program) {
+	Tree tree;
+	Flattener flattener { tree };
+	tree.set_root(flattener.flatten_program(program));
+	return tree;
+}
+
+void Tree::dump() const {
+	dump_node(m_root);
+}
+
+// NOTE: Mirrors the output of the AST::Node::dump() overloads, so that the two
+//       representations can be diffed against each other.
+void Tree::dump_node(NodeIndex node) const {
+	auto span = m_spans[node];
+	auto lhs = m_lhs[node];
+	auto rhs = m_rhs[node];
+	auto flags = m_flags[node];
+
+	auto dump_list = [&](std::span<std::uint32_t const> nodes) {
+		for (std::size_t i = 0; i < nodes.size(); ++i) {
+			dump_node(nodes[i]);
+			if (i != nodes.size() - 1) {
+				fmt::print(",");
+			}
+		}
+	};
+
+	switch (m_kinds[node]) {
+	case AST::Kind::Type:
+		{
+			fmt::print("{{\"node\":\"Type\",\"span\":[{},{}]", span.start, span.end);
+			if (lhs != invalid_node) {
+				fmt::print(",\"inner_type\":");
+				dump_node(lhs);
+			}
+
+			if (m_extra[rhs] != invalid_node) {
+				fmt::print(",\"array_size\":");
+				dump_node(m_extra[rhs]);
+			}
+
+			if (m_extra[rhs + 1] != invalid_node) {
+				fmt::print(",\"name\":");
+				dump_node(m_extra[rhs + 1]);
+			}
+
+			std::string type_flags;
+	#define BO_ENUMERATE_TYPE_FLAG(x, y)          \
+		if (flags & AST::PF_##x) {                  \
+			type_flags += fmt::format("\"{}\",", #x); \
+		}
+		_BO_ENUMERATE_TYPE_FLAGS
+#undef BO_ENUMERATE_TYPE_FLAG
+		if (!type_flags.empty()) {
+			type_flags.pop_back();
+		}
+
+		fmt::print(",\"flags\":[{}]", type_flags);
+		fmt::print("}}");
+		break;
+	}
+	case AST::Kind::ParenthesizedExpression:
+		fmt::print("{{\"node\":\"ParenthesizedExpression\",\"span\":[{},{}],", span.start, span.end);
+		fmt::print("\"expression\":");
+		dump_node(lhs);
+		fmt::print("}}");
+		break;
+	case AST::Kind::IntegerLiteral:
+		fmt::print("{{\"node\":\"IntegerLiteral\",\"span\":[{},{}],\"value\":{:?}}}", span.start, span.end, m_strings[lhs]);
+		break;
+	case AST::Kind::CharLiteral:
+		fmt::print("{{\"node\":\"CharLiteral\",\"span\":[{},{}],\"value\":{:?}}}", span.start, span.end, m_strings[lhs]);
+		break;
+	case AST::Kind::BooleanLiteral:
+		fmt::print("{{\"node\":\"BooleanLiteral\",\"span\":[{},{}],\"value\":{}}}", span.start, span.end, flags != 0);
+		break;
+	case AST::Kind::Identifier:
+		fmt::print("{{\"node\":\"Identifier\",\"span\":[{},{}],\"id\":{:?}}}", span.start, span.end, m_strings[lhs]);
+		break;
+	case AST::Kind::BinaryExpression:
+		fmt::print("{{\"node\":\"BinaryExpression\",\"span\":[{},{}],", span.start, span.end);
+		switch (static_cast<AST::BinaryOperator>(flags)) {
+#define BO_ENUMERATE_BINARY_OPERATOR(x)    \
+	case AST::BinaryOperator::x:             \
+		fmt::print("\"operator\":\"{}\"", #x); \
+		break;
+			_BO_ENUMERATE_BINARY_OPERATORS
+#undef BO_ENUMERATE_BINARY_OPERATOR
+		}
+		fmt::print(",\"lhs\":");
+		dump_node(lhs);
+		fmt::print(",\"rhs\":");
+		dump_node(rhs);
+		fmt::print("}}");
+		break;
+	case AST::Kind::UnaryExpression:
+		fmt::print("{{\"node\":\"UnaryExpression\",\"span\":[{},{}],", span.start, span.end);
+		switch (static_cast<AST::UnaryOperator>(flags)) {
+#define BO_ENUMERATE_UNARY_OPERATOR(x)     \
+	case AST::UnaryOperator::x:              \
+		fmt::print("\"operator\":\"{}\"", #x); \
+		break;
+			_BO_ENUMERATE_UNARY_OPERATORS
+#undef BO_ENUMERATE_UNARY_OPERATOR
+		}
+		fmt::print(",\"operand\":");
+		dump_node(lhs);
+		fmt::print("}}");
+		break;
+	case AST::Kind::AssignmentExpression:
+		fmt::print("{{\"node\":\"AssignmentExpression\",\"span\":[{},{}],", span.start, span.end);
+		switch (static_cast<AST::AssignmentOperator>(flags)) {
+#define BO_ENUMERATE_ASSIGNMENT_OPERATOR(x) \
+	case AST::AssignmentOperator::x:          \
+		fmt::print("\"operator\":\"{}\"", #x);  \
+		break;
+			_BO_ENUMERATE_ASSIGNMENT_OPERATORS
+#undef BO_ENUMERATE_ASSIGNMENT_OPERATOR
+		}
+		fmt::print(",\"lhs\":");
+		dump_node(lhs);
+		fmt::print(",\"rhs\":");
+		dump_node(rhs);
+		fmt::print("}}");
+		break;
+	case AST::Kind::UpdateExpression:
+		fmt::print("{{\"node\":\"UpdateExpression\",\"span\":[{},{}],", span.start, span.end);
+		switch (static_cast<AST::UpdateOperator>(flags & ~update_is_prefixed_flag)) {
+#define BO_ENUMERATE_UPDATE_OPERATOR(x)    \
+	case AST::UpdateOperator::x:             \
+		fmt::print("\"operator\":\"{}\"", #x); \
+		break;
+			_BO_ENUMERATE_UPDATE_OPERATORS
+#undef BO_ENUMERATE_UPDATE_OPERATOR
+		}
+		fmt::print(",\"is_prefixed\":{}", (flags & update_is_prefixed_flag) != 0);
+		fmt::print(",\"operand\":");
+		dump_node(lhs);
+		fmt::print("}}");
+		break;
+	case AST::Kind::PointerDereferenceExpression:
+		fmt::print("{{\"node\":\"PointerDereferenceExpression\",\"span\":[{},{}],", span.start, span.end);
+		fmt::print("\"operand\":");
+		dump_node(lhs);
+		fmt::print("}}");
+		break;
+	case AST::Kind::AddressOfExpression:
+		fmt::print("{{\"node\":\"AddressOfExpression\",\"span\":[{},{}],", span.start, span.end);
+		fmt::print("\"operand\":");
+		dump_node(lhs);
+		fmt::print("}}");
+		break;
+	case AST::Kind::RangeExpression:
+		fmt::print("{{\"node\":\"RangeExpression\",\"span\":[{},{}],", span.start, span.end);
+		fmt::print(",\"is_inclusive\":{}", flags != 0);
+		fmt::print("\"start\":");
+		dump_node(lhs);
+		fmt::print(",\"end\":");
+		dump_node(rhs);
+		fmt::print("}}");
+		break;
+	case AST::Kind::BlockExpression:
+		fmt::print("{{\"node\":\"BlockExpression\",\"span\":[{},{}],\"statements\":[", span.start, span.end);
+		dump_list(children(node));
+		fmt::print("]}}");
+		break;
+	case AST::Kind::IfExpression:
+		fmt::print("{{\"node\":\"IfExpression\",\"span\":[{},{}],", span.start, span.end);
+		fmt::print("\"condition\":");
+		dump_node(lhs);
+		fmt::print(",\"then_block\":");
+		dump_node(m_extra[rhs]);
+		if (m_extra[rhs + 1] != invalid_node) {
+			fmt::print(",\"else_block\":");
+			dump_node(m_extra[rhs + 1]);
+		}
+		fmt::print("}}");
+		break;
+	case AST::Kind::FunctionCallExpression:
+		{
+			fmt::print("{{\"node\":\"FunctionCallExpression\",\"span\":[{},{}],", span.start, span.end);
+			fmt::print("\"name\":");
+			dump_node(lhs);
+			fmt::print(",\"arguments\":[");
+			auto argument_count = m_extra[rhs];
+			for (std::uint32_t i = 0; i < argument_count; ++i) {
+				auto name = m_extra[rhs + 1 + 2 * i];
+				auto value = m_extra[rhs + 2 + 2 * i];
+
+				fmt::print("{{");
+				if (name != invalid_node) {
+					fmt::print("\"name\":");
+					dump_node(name);
+					fmt::print(",");
+				}
+				fmt::print("\"value\":");
+				dump_node(value);
+				fmt::print("}}");
+
+				if (i != argument_count - 1) {
+					fmt::print(",");
+				}
+			}
+			fmt::print("]}}");
+			break;
+		}
+	case AST::Kind::ArrayExpression:
+		fmt::print("{{\"node\":\"ArrayExpression\",\"span\":[{},{}],", span.start, span.end);
+		fmt::print("\"elements\":[");
+		dump_list(children(node));
+		fmt::print("]}}");
+		break;
+	case AST::Kind::ArraySubscriptExpression:
+		fmt::print("{{\"node\":\"ArraySubscriptExpression\",\"span\":[{},{}],", span.start, span.end);
+		fmt::print("\"array\":");
+		dump_node(lhs);
+		fmt::print(",\"index\":");
+		dump_node(rhs);
+		fmt::print("}}");
+		break;
+	case AST::Kind::ExpressionStatement:
+		fmt::print("{{\"node\":\"ExpressionStatement\",\"span\":[{},{}],\"ends_with_semicolon\":{},\"expression\":", span.start, span.end, flags != 0);
+		dump_node(lhs);
+		fmt::print("}}");
+		break;
+	case AST::Kind::VariableDeclarationStatement:
+		fmt::print("{{\"node\":\"VariableDeclarationStatement\",\"span\":[{},{}],", span.start, span.end);
+		fmt::print("\"is_mutable\":{}", flags != 0);
+		fmt::print(",\"identifier\":");
+		dump_node(lhs);
+		if (m_extra[rhs] != invalid_node) {
+			fmt::print(",\"type\":");
+			dump_node(m_extra[rhs]);
+		}
+
+		if (m_extra[rhs + 1] != invalid_node) {
+			fmt::print(",\"initializer\":");
+			dump_node(m_extra[rhs + 1]);
+		}
+
+		fmt::print("}}");
+		break;
+	case AST::Kind::FunctionDeclarationStatement:
+		{
+			fmt::print("{{\"node\":\"FunctionDeclarationStatement\",\"span\":[{},{}]", span.start, span.end);
+			fmt::print(",\"name\":");
+			dump_node(lhs);
+			fmt::print(",\"parameters\":[");
+			auto parameter_count = m_extra[rhs + 2];
+			for (std::uint32_t i = 0; i < parameter_count; ++i) {
+				auto parameter = rhs + 3 + 3 * i;
+				fmt::print("{{\"name\":");
+				dump_node(m_extra[parameter]);
+				fmt::print(",\"type\":");
+				dump_node(m_extra[parameter + 1]);
+				fmt::print(",\"anonymous\":{}}}", m_extra[parameter + 2] != 0);
+				if (i != parameter_count - 1) {
+					fmt::print(",");
+				}
+			}
+			fmt::print("]");
+			fmt::print(",\"return_type\":");
+			dump_node(m_extra[rhs]);
+			fmt::print(",\"body\":");
+			dump_node(m_extra[rhs + 1]);
+			fmt::print("}}");
+			break;
+		}
+	case AST::Kind::InfiniteForStatement:
+		fmt::print("{{\"node\":\"InfiniteForStatement\",\"span\":[{},{}],", span.start, span.end);
+		fmt::print("\"body\":");
+		dump_node(lhs);
+		fmt::print("}}");
+		break;
+	case AST::Kind::ForWithConditionStatement:
+		fmt::print("{{\"node\":\"ForWithConditionStatement\",\"span\":[{},{}],", span.start, span.end);
+		fmt::print("\"condition\":");
+		dump_node(lhs);
+		fmt::print(",\"body\":");
+		dump_node(rhs);
+		fmt::print("}}");
+		break;
+	case AST::Kind::ForWithRangeStatement:
+		fmt::print("{{\"node\":\"ForWithRangeStatement\",\"span\":[{},{}],", span.start, span.end);
+		fmt::print("\"range_variable\":");
+		dump_node(lhs);
+		fmt::print(",\"range_expression\":");
+		dump_node(m_extra[rhs]);
+		fmt::print(",\"body\":");
+		dump_node(m_extra[rhs + 1]);
+		fmt::print("}}");
+		break;
+	case AST::Kind::ReturnStatement:
+		fmt::print("{{\"node\":\"ReturnStatement\",\"span\":[{},{}],", span.start, span.end);
+		if (lhs != invalid_node) {
+			fmt::print("\"expression\":");
+			dump_node(lhs);
+		}
+		fmt::print("}}");
+		break;
+	case AST::Kind::Program:
+		fmt::print("{{\"node\":\"Program\",\"span\":[{},{}],", span.start, span.end);
+		fmt::print("\"functions\":[");
+		dump_list(children(node));
+		fmt::print("]}}");
+		break;
+	}
+}
+
+}
+
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "AST.hpp"
+#include "Span.hpp"
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace bo {
+
+namespace FlatAST {
+
+using NodeIndex = std::uint32_t;
+
+constexpr NodeIndex invalid_node = UINT32_MAX;
+
+constexpr std::uint8_t update_is_prefixed_flag = 1 << 7;
+
+// NOTE: An index-based alternative to the pointer AST. Every node is one entry
+//       in a set of parallel arrays: a kind tag, 8 bits of flags, two 32-bit
+//       operands and a span. Strings and variable length child lists live in
+//       side tables. Children are always emitted before their parent, so a
+//       forward walk over the arrays is a post-order traversal of the tree.
+//
+//       Operands by kind (`extra[i]` is an index into the extra table, `string`
+//       an index into the string table, `-` means unused):
+//
+//       Kind                         | flags                | lhs               | rhs
+//       -----------------------------+----------------------+-------------------+----------------------------------------------
+//       Type                         | TypeFlags            | inner type        | extra[array size, name]
+//       ParenthesizedExpression      | -                    | expression        | -
+//       IntegerLiteral               | IntegerLiteral::Type | string value      | string suffix
+//       CharLiteral                  | -                    | string value      | -
+//       BooleanLiteral               | value                | -                 | -
+//       Identifier                   | -                    | string id         | -
+//       BinaryExpression             | BinaryOperator       | lhs               | rhs
+//       UnaryExpression              | UnaryOperator        | operand           | -
+//       AssignmentExpression         | AssignmentOperator   | lhs               | rhs
+//       UpdateExpression             | UpdateOperator       | operand           | -
+//       PointerDereferenceExpression | -                    | operand           | -
+//       AddressOfExpression          | -                    | operand           | -
+//       RangeExpression              | is_inclusive         | start             | end
+//       BlockExpression              | -                    | extra start       | statement count
+//       IfExpression                 | -                    | condition         | extra[then, else]
+//       FunctionCallExpression       | -                    | name              | extra[count, (name, value)...]
+//       ArrayExpression              | -                    | extra start       | element count
+//       ArraySubscriptExpression     | -                    | array             | index
+//       ExpressionStatement          | ends_with_semicolon  | expression        | -
+//       VariableDeclarationStatement | is_mutable           | identifier        | extra[type, initializer]
+//       FunctionDeclarationStatement | -                    | name              | extra[return type, body, count, (name, type, is_anonymous)...]
+//       InfiniteForStatement         | -                    | body              | -
+//       ForWithConditionStatement    | -                    | condition         | body
+//       ForWithRangeStatement        | -                    | range variable    | extra[range expression, body]
+//       ReturnStatement              | -                    | expression        | -
+//       Program                      | -                    | extra start       | function count
+//
+//       UpdateExpression also stores is_prefixed in update_is_prefixed_flag.
+//       Optional children are stored as invalid_node.
+class Tree {
+public:
+	NodeIndex root() const { return m_root; }
+	std::size_t node_count() const { return m_kinds.size(); }
+
+	AST::Kind kind(NodeIndex node) const { return m_kinds[node]; }
+	std::uint8_t flags(NodeIndex node) const { return m_flags[node]; }
+	std::uint32_t lhs(NodeIndex node) const { return m_lhs[node]; }
+	std::uint32_t rhs(NodeIndex node) const { return m_rhs[node]; }
+	Span span(NodeIndex node) const { return m_spans[node]; }
+
+	std::string_view string(std::uint32_t index) const { return m_strings[index]; }
+	std::uint32_t extra(std::uint32_t index) const { return m_extra[index]; }
+	std::span<std::uint32_t const> extra(std::uint32_t start, std::uint32_t count) const { return std::span { m_extra }.subspan(start, count); }
+
+	// NOTE: Only meaningful for BlockExpression, ArrayExpression and Program,
+	//       whose children are a contiguous run of the extra table.
+	std::span<NodeIndex const> children(NodeIndex node) const { return extra(m_lhs[node], m_rhs[node]); }
+
+	NodeIndex add_node(AST::Kind kind, std::uint8_t flags, std::uint32_t lhs, std::uint32_t rhs, Span span);
+	std::uint32_t add_string(std::string_view string);
+	std::uint32_t add_extra(std::span<std::uint32_t const> values);
+	void set_root(NodeIndex root) { m_root = root; }
+
+	void dump() const;
+
+private:
+	void dump_node(NodeIndex node) const;
+
+	std::vector<AST::Kind> m_kinds;
+	std::vector<std::uint8_t> m_flags;
+	std::vector<std::uint32_t> m_lhs;
+	std::vector<std::uint32_t> m_rhs;
+	std::vector<Span> m_spans;
+
+	std::vector<std::string_view> m_strings;
+	std::vector<std::uint32_t> m_extra;
+
+	NodeIndex m_root { invalid_node };
+};
+
+// NOTE: The parser only builds the pointer AST, a flat tree is converted from
+//       it in a single post-order pass. Nothing in the compiler runs on the
+//       flat layout yet, so this stays off the default path. boc-bench times
+//       the conversion and walking either layout, and tests/ checks that both
+//       dump the same.
+Tree flatten(AST::Program const* program);
+
+}
+
+}
@@ -1,15 +1,136 @@
 #include "Lexer.hpp"
 
+#include "utils/Scan.hpp"
+
+#include <algorithm>
+#include <array>
 #include <cctype>
+#include <cstdint>
 #include <cstdlib>
+#include <optional>
 
 namespace bo {
 
-Lexer::Lexer(std::string_view source)
-  : m_source(source), m_current_character(-1), m_current_position(0) {
+// NOTE: Keywords are recognized with a perfect hash over the length and the
+//       first and last characters of an identifier, so classifying one costs a
+//       single probe and a single comparison. The table is built at compile
+//       time from _BO_ENUMERATE_KEYWORDS: if adding a keyword trips the
+//       static_assert below, pick new multipliers for keyword_hash.
+struct KeywordEntry {
+	std::string_view keyword;
+	Token::Type type { Token::Type::Identifier };
+};
+
+constexpr std::size_t keyword_table_size = 64;
+
+constexpr std::size_t keyword_hash(std::string_view value) {
+	auto first = static_cast<unsigned char>(value.front());
+	auto last = static_cast<unsigned char>(value.back());
+	return (value.size() + first * 2 + last * 23) % keyword_table_size;
+}
+
+constexpr auto keyword_table = [] {
+	std::array<KeywordEntry, keyword_table_size> table {};
+#define BO_ENUMERATE_KEYWORD(x) table[keyword_hash(#x##sv)] = KeywordEntry { #x##sv, Token::Type::KW_##x };
+	_BO_ENUMERATE_KEYWORDS
+#undef BO_ENUMERATE_KEYWORD
+	return table;
+}();
+
+constexpr bool keyword_table_has_no_collisions() {
+	std::size_t keyword_count = 0;
+#define BO_ENUMERATE_KEYWORD(x) ++keyword_count;
+	_BO_ENUMERATE_KEYWORDS
+#undef BO_ENUMERATE_KEYWORD
+
+	std::size_t used_slots = 0;
+	for (auto const& entry : keyword_table) {
+		used_slots += !entry.keyword.empty();
+	}
+
+	return used_slots == keyword_count;
+}
+
+static_assert(keyword_table_has_no_collisions(), "Keyword hash has collisions");
+
+// NOTE: Operators are recognized by a DFA generated at compile time from the
+//       spellings in _BO_ENUMERATE_TOKENS. Every byte is first mapped to a
+//       character class (0 for bytes that never appear in an operator), so the
+//       start state's row is the first-character dispatch and each further
+//       byte costs one transition lookup. Like the hand-written chain it
+//       replaces, lexing takes the longest spelling that matches.
+struct OperatorDfa {
+	static constexpr std::size_t max_states = 64;
+	static constexpr std::size_t max_classes = 32;
+	static constexpr std::uint8_t dead_state = 0;
+	static constexpr std::uint8_t start_state = 1;
+
+	constexpr std::uint8_t next(std::uint8_t state, char c) const {
+		return transitions[state][character_classes[static_cast<unsigned char>(c)]];
+	}
+
+	std::array<std::uint8_t, 256> character_classes {};
+	std::array<std::array<std::uint8_t, max_classes>, max_states> transitions {};
+	std::array<std::optional<Token::Type>, max_states> accepting_types {};
+	std::size_t state_count { 2 };
+	std::size_t class_count { 1 };
+};
+
+constexpr auto operator_dfa = [] {
+	OperatorDfa dfa;
+	auto add_operator = [&](std::string_view spelling, Token::Type type) {
+		auto state = OperatorDfa::start_state;
+		for (auto c : spelling) {
+			auto& character_class = dfa.character_classes[static_cast<unsigned char>(c)];
+			if (character_class == 0) {
+				character_class = static_cast<std::uint8_t>(dfa.class_count++);
+			}
+
+			auto& next_state = dfa.transitions[state][character_class];
+			if (next_state == OperatorDfa::dead_state) {
+				next_state = static_cast<std::uint8_t>(dfa.state_count++);
+			}
+
+			state = next_state;
+		}
+
+		dfa.accepting_types[state] = type;
+	};
+
+#define BO_ENUMERATE_KEYWORD(x)
+#define BO_ENUMERATE_OPERATOR(x, y) add_operator(y##sv, Token::Type::x);
+#define BO_ENUMERATE_TOKEN(x)
+	_BO_ENUMERATE_TOKENS
+#undef BO_ENUMERATE_TOKEN
+#undef BO_ENUMERATE_OPERATOR
+#undef BO_ENUMERATE_KEYWORD
+
+	return dfa;
+}();
+
+static_assert(operator_dfa.state_count <= OperatorDfa::max_states && operator_dfa.class_count <= OperatorDfa::max_classes);
+
+Lexer::Lexer(std::string_view source, std::uint32_t base_offset)
+  : m_source(source), m_base_offset(base_offset), m_current_character(-1), m_current_position(0) {
 	advance();
 }
 
+Result<TokenBuffer, Error> Lexer::tokenize(std::string_view source, std::uint32_t base_offset) {
+	Lexer lexer { source, base_offset };
+	TokenBuffer tokens { source, base_offset };
+	// NOTE: Dense code averages a bit over two bytes per token. Reserving for
+	//       one token every four bytes costs at most one regrowth there without
+	//       overcommitting much on comment-heavy sources.
+	tokens.reserve(source.size() / 4 + 1);
+	while (true) {
+		auto token = TRY(lexer.next_token());
+		tokens.append(token);
+		if (token.type() == Token::Type::EndOfFile) {
+			return tokens;
+		}
+	}
+}
+
 void Lexer::advance() {
 	if (m_current_position > m_source.size()) {
 		return;
@@ -19,6 +140,11 @@ void Lexer::advance() {
 	++m_current_position;
 }
 
+void Lexer::skip_to(std::size_t position) {
+	m_current_position = position;
+	advance();
+}
+
 bool Lexer::is_eof() const {
 	return m_current_character == -1;
 }
@@ -31,10 +157,6 @@ bool Lexer::is_block_comment_start() const {
 	return m_current_character == '/' && m_current_position < m_source.size() && m_source[m_current_position] == '*';
 }
 
-bool Lexer::is_block_comment_end() const {
-	return m_current_character == '*' && m_current_position < m_source.size() && m_source[m_current_position] == '/';
-}
-
 bool Lexer::is_identifier_start() const {
 	return std::isalpha(m_current_character) || m_current_character == '_' || m_current_character == '$';
 }
@@ -76,7 +198,7 @@ Result<Token::Type, Error> Lexer::lex_integer_literal() {
 	if (m_current_character == '_') {
 		advance();
 		if (!is_identifier_start()) {
-			return Error { "unexpected character while parsing integer literal suffix", Span { m_current_position - 1, m_current_position - 1 } };
+			return Error { "unexpected character while parsing integer literal suffix", make_span(m_current_position - 1, m_current_position - 1) };
 		}
 
 		lex_identifier();
@@ -92,15 +214,15 @@ Result<void, Error> Lexer::lex_char_literal() {
 	advance();
 
 	if (is_eof()) {
-		return Error { "unexpected end of file while parsing char literal", Span { token_start, m_current_position - 1 } };
+		return Error { "unexpected end of file while parsing char literal", make_span(token_start, m_current_position - 1) };
 	}
 
 	if (m_current_character == '\'') {
-		return Error { "empty char literals are not valid", Span { token_start, m_current_position - 1 } };
+		return Error { "empty char literals are not valid", make_span(token_start, m_current_position - 1) };
 	}
 
 	if (m_current_character == '\n' || m_current_character == '\r' || m_current_character == '\t') {
-		return Error { "unexpected character inside char literal", Span { token_start, m_current_position - 1 } };
+		return Error { "unexpected character inside char literal", make_span(token_start, m_current_position - 1) };
 	}
 
 	auto is_escape_sequence_next = m_current_character == '\\';
@@ -115,23 +237,23 @@ Result<void, Error> Lexer::lex_char_literal() {
 			advance();
 
 			if (m_current_character < '0' || m_current_character > '7') {
-				return Error { "invalid escape sequence inside char literal", Span { escape_sequence_start, m_current_position - 1 } };
+				return Error { "invalid escape sequence inside char literal", make_span(escape_sequence_start, m_current_position - 1) };
 			}
 
 			advance();
 
 			if (!std::isxdigit(m_current_character)) {
-				return Error { "invalid escape sequence inside char literal", Span { escape_sequence_start, m_current_position - 1 } };
+				return Error { "invalid escape sequence inside char literal", make_span(escape_sequence_start, m_current_position - 1) };
 			}
 
 			advance();
 		} else {
-			return Error { "invalid escape sequence inside char literal", Span { escape_sequence_start, m_current_position - 1 } };
+			return Error { "invalid escape sequence inside char literal", make_span(escape_sequence_start, m_current_position - 1) };
 		}
 	}
 
 	if (m_current_character != '\'') {
-		return Error { "missing closing single quote for char literal", Span { token_start, m_current_position - 1 } };
+		return Error { "missing closing single quote for char literal", make_span(token_start, m_current_position - 1) };
 	}
 	advance();
 
@@ -147,250 +269,50 @@ void Lexer::lex_identifier() {
 }
 
 Result<Token::Type, Error> Lexer::lex_operator() {
-	if (m_current_character == '&') {
-		advance();
-		if (m_current_character == '&') {
-			advance();
-			if (m_current_character == '=') {
-				advance();
-				return Token::Type::DoubleAmpersandEquals;
-			}
-			return Token::Type::DoubleAmpersand;
-		}
-		if (m_current_character == '=') {
-			advance();
-			return Token::Type::AmpersandEquals;
-		}
-		return Token::Type::Ampersand;
-	}
-
-	if (m_current_character == '*') {
-		advance();
-		if (m_current_character == '=') {
-			advance();
-			return Token::Type::AsteriskEquals;
-		}
-		return Token::Type::Asterisk;
-	}
-
-	if (m_current_character == '@') {
-		advance();
-		return Token::Type::At;
-	}
-
-	if (m_current_character == '^') {
-		advance();
-		if (m_current_character == '=') {
-			advance();
-			return Token::Type::CircumflexEquals;
-		}
-		return Token::Type::Circumflex;
-	}
-
-	if (m_current_character == ':') {
-		advance();
-		return Token::Type::Colon;
-	}
-
-	if (m_current_character == ',') {
-		advance();
-		return Token::Type::Comma;
-	}
-
-	if (m_current_character == '=') {
-		advance();
-		if (m_current_character == '=') {
-			advance();
-			return Token::Type::DoubleEquals;
-		}
-		return Token::Type::Equals;
-	}
-
-	if (m_current_character == '{') {
-		advance();
-		return Token::Type::LeftCurlyBracket;
-	}
-
-	if (m_current_character == '(') {
-		advance();
-		return Token::Type::LeftParenthesis;
-	}
-
-	if (m_current_character == '-') {
-		advance();
-		if (m_current_character == '-') {
-			advance();
-			return Token::Type::MinusMinus;
-		}
-		if (m_current_character == '=') {
-			advance();
-			return Token::Type::MinusEquals;
-		}
-		return Token::Type::Minus;
-	}
-
-	if (m_current_character == '%') {
-		advance();
-		if (m_current_character == '=') {
-			advance();
-			return Token::Type::PercentEquals;
-		}
-		return Token::Type::Percent;
-	}
-
-	if (m_current_character == '+') {
-		advance();
-		if (m_current_character == '+') {
-			advance();
-			return Token::Type::PlusPlus;
-		}
-		if (m_current_character == '=') {
-			advance();
-			return Token::Type::PlusEquals;
-		}
-		return Token::Type::Plus;
-	}
-
-	if (m_current_character == '}') {
-		advance();
-		return Token::Type::RightCurlyBracket;
-	}
-
-	if (m_current_character == ')') {
-		advance();
-		return Token::Type::RightParenthesis;
-	}
-
-	if (m_current_character == ';') {
-		advance();
-		return Token::Type::Semicolon;
-	}
-
-	if (m_current_character == '/') {
-		advance();
-		if (m_current_character == '=') {
-			advance();
-			return Token::Type::SolidusEquals;
-		}
-		return Token::Type::Solidus;
-	}
-
-	if (m_current_character == '!') {
-		advance();
-		if (m_current_character == '=') {
-			advance();
-			return Token::Type::ExclamationMarkEquals;
-		}
-		return Token::Type::ExclamationMark;
-	}
-
-	if (m_current_character == '~') {
-		advance();
-		return Token::Type::Tilde;
-	}
-
-	if (m_current_character == '<') {
-		advance();
-		if (m_current_character == '<') {
-			advance();
-			if (m_current_character == '=') {
-				advance();
-				return Token::Type::LeftShiftEquals;
-			}
-			return Token::Type::LeftShift;
-		}
-		if (m_current_character == '=') {
-			advance();
-			return Token::Type::LessThanEquals;
-		}
-		return Token::Type::LessThan;
-	}
-
-	if (m_current_character == '>') {
-		advance();
-		if (m_current_character == '>') {
-			advance();
-			if (m_current_character == '=') {
-				advance();
-				return Token::Type::RightShiftEquals;
-			}
-			return Token::Type::RightShift;
-		}
-		if (m_current_character == '=') {
-			advance();
-			return Token::Type::GreaterThanEquals;
-		}
-		return Token::Type::GreaterThan;
-	}
-
-	if (m_current_character == '|') {
-		advance();
-		if (m_current_character == '|') {
-			advance();
-			if (m_current_character == '=') {
-				advance();
-				return Token::Type::DoublePipeEquals;
-			}
-			return Token::Type::DoublePipe;
+	auto start = m_current_position - 1;
+	auto state = OperatorDfa::start_state;
+	std::optional<Token::Type> longest_match;
+	auto longest_match_end = start;
+	for (auto position = start; position < m_source.size(); ++position) {
+		state = operator_dfa.next(state, m_source[position]);
+		if (state == OperatorDfa::dead_state) {
+			break;
 		}
-		return Token::Type::Pipe;
-	}
 
-	if (m_current_character == '.' && m_current_position < m_source.size() && m_source[m_current_position] == '.') {
-		if (m_current_position + 1 < m_source.size() && m_source[m_current_position + 1] == '<') {
-			advance();
-			advance();
-			advance();
-			return Token::Type::DotDotLessThan;
-		} else if (m_current_position + 1 < m_source.size() && m_source[m_current_position + 1] == '=') {
-			advance();
-			advance();
-			advance();
-			return Token::Type::DotDotEquals;
+		if (auto type = operator_dfa.accepting_types[state]) {
+			longest_match = type;
+			longest_match_end = position + 1;
 		}
 	}
 
-	if (m_current_character == '[') {
-		advance();
-		return Token::Type::LeftSquareBracket;
-	}
-
-	if (m_current_character == ']') {
-		advance();
-		return Token::Type::RightSquareBracket;
+	if (!longest_match) {
+		return Error { "unexpected character while lexing", make_span(start, start) };
 	}
 
-	return Error { "unexpected character while lexing", Span { m_current_position - 1, m_current_position - 1 } };
+	skip_to(longest_match_end);
+	return *longest_match;
 }
 
 Result<Token, Error> Lexer::next_token() {
 	while (true) {
-		if (std::isspace(m_current_character)) {
-			do {
-				advance();
-			} while (std::isspace(m_current_character));
+		auto position = m_current_position - 1;
+		if (is_ascii_whitespace(m_current_character)) {
+			skip_to(find_non_whitespace(m_source, position));
 		} else if (is_line_comment_start()) {
-			advance();
-
-			do {
-				advance();
-			} while (!is_eof() && m_current_character != '\n');
+			skip_to(find_byte(m_source, position + 2, '\n'));
 		} else if (is_block_comment_start()) {
-			advance();
-
-			do {
-				advance();
-			} while (!is_eof() && !is_block_comment_end());
-
-			advance();
-			advance();
+			auto comment_end = find_block_comment_end(m_source, position + 2);
+			skip_to(std::min(comment_end + 2, m_source.size()));
 		} else {
 			break;
 		}
 	}
 
+	// NOTE: The end of file sits one past the last byte, the position its
+	//       SourceManager reserves for it. m_current_position is already past
+	//       it, which would be the start of the next file.
 	if (is_eof()) {
-		return Token { Token::Type::EndOfFile, ""sv, Span { m_current_position, m_current_position } };
+		return Token { Token::Type::EndOfFile, ""sv, make_span(m_source.size(), m_source.size()) };
 	}
 
 	Token::Type token_type;
@@ -410,16 +332,23 @@ Result<Token, Error> Lexer::next_token() {
 
 	auto token_value = m_source.substr(token_start, m_current_position - token_start - 1);
 
-	if (token_type == Token::Type::Identifier) {
-#define BO_ENUMERATE_KEYWORD(x)       \
-	if (token_value == #x##sv) {        \
-		token_type = Token::Type::KW_##x; \
+	if (token_type != Token::Type::Identifier) {
+		return Token { token_type, token_value, make_span(token_start, m_current_position - 2) };
 	}
-		_BO_ENUMERATE_KEYWORDS
-#undef BO_ENUMERATE_KEYWORD
+
+	auto const& entry = keyword_table[keyword_hash(token_value)];
+	if (entry.keyword == token_value) {
+		token_type = entry.type;
+	}
+
+	// NOTE: Keywords are interned too, since the parser accepts some of them as
+	//       identifiers, like the names of builtin types.
+	auto [it, is_new] = m_symbols.try_emplace(token_value);
+	if (is_new) {
+		it->second = Symbol::intern(token_value);
 	}
 
-	return Token { token_type, token_value, Span { token_start, m_current_position - 2 } };
+	return Token { token_type, token_value, make_span(token_start, m_current_position - 2), it->second };
 }
 
 }
@@ -1,26 +1,36 @@
 #pragma once
 
+#include <cstdint>
 #include <string_view>
+#include <unordered_map>
 
 #include "Error.hpp"
+#include "Symbol.hpp"
 #include "Token.hpp"
+#include "TokenBuffer.hpp"
 #include "utils/Result.hpp"
 
 namespace bo {
 
 class Lexer {
 public:
-	explicit Lexer(std::string_view source);
+	// NOTE: Positions in spans are offset by base_offset, where the source
+	//       starts in its SourceManager.
+	explicit Lexer(std::string_view source, std::uint32_t base_offset = 0);
+
+	static Result<TokenBuffer, Error> tokenize(std::string_view source, std::uint32_t base_offset = 0);
 
 	Result<Token, Error> next_token();
 
 private:
+	Span make_span(std::size_t start, std::size_t end) const { return Span { static_cast<std::uint32_t>(m_base_offset + start), static_cast<std::uint32_t>(m_base_offset + end) }; }
+
 	void advance();
+	void skip_to(std::size_t position);
 
 	bool is_eof() const;
 	bool is_line_comment_start() const;
 	bool is_block_comment_start() const;
-	bool is_block_comment_end() const;
 	bool is_identifier_start() const;
 	bool is_identifier_middle() const;
 
@@ -30,6 +40,10 @@ private:
 	Result<Token::Type, Error> lex_operator();
 
 	std::string_view m_source;
+	std::uint32_t m_base_offset;
+	// NOTE: The symbols of the names seen so far, so that each distinct name
+	//       only goes through the process-wide table once.
+	std::unordered_map<std::string_view, Symbol> m_symbols;
 	char m_current_character;
 	std::size_t m_current_position;
 };
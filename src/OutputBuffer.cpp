@@ -0,0 +1,42 @@
+#include "OutputBuffer.hpp"
+
+namespace bo {
+
+void OutputBuffer::clear() {
+	m_chunks.resize(std::min<std::size_t>(m_chunks.size(), 1));
+	m_current = m_chunks.empty() ? nullptr : m_chunks.front().get();
+	m_end = m_chunks.empty() ? nullptr : m_current + m_chunk_size;
+	m_size = 0;
+}
+
+Result<void, Error> OutputBuffer::flush_full_chunks(OutputSink& sink) {
+	if (m_chunks.size() < 2) {
+		return {};
+	}
+
+	auto full_chunk_count = m_chunks.size() - 1;
+	std::vector<std::string_view> blocks;
+	blocks.reserve(full_chunk_count);
+	for (std::size_t i = 0; i < full_chunk_count; ++i) {
+		blocks.push_back(chunk(i));
+	}
+
+	TRY(sink.write(blocks));
+	m_chunks.erase(m_chunks.begin(), m_chunks.begin() + static_cast<std::ptrdiff_t>(full_chunk_count));
+	m_size -= full_chunk_count * m_chunk_size;
+	return {};
+}
+
+Result<void, Error> OutputBuffer::flush(OutputSink& sink) {
+	std::vector<std::string_view> blocks;
+	blocks.reserve(m_chunks.size());
+	for (std::size_t i = 0; i < m_chunks.size(); ++i) {
+		blocks.push_back(chunk(i));
+	}
+
+	TRY(sink.write(blocks));
+	clear();
+	return {};
+}
+
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Error.hpp"
+#include "OutputSink.hpp"
+#include "utils/Result.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace bo {
+
+// NOTE: An append-only text buffer made of fixed-size chunks. Chunks are never
+//       moved or reallocated, so the buffer grows without copying what it
+//       already holds, and full chunks can be handed to an OutputSink as
+//       blocks and dropped while the rest is still being written.
+class OutputBuffer {
+public:
+	static constexpr std::size_t default_chunk_size = 64 * 1024;
+
+	explicit OutputBuffer(std::size_t chunk_size = default_chunk_size)
+	  : m_chunk_size(chunk_size) {}
+
+	OutputBuffer(OutputBuffer const&) = delete;
+	OutputBuffer& operator=(OutputBuffer const&) = delete;
+	OutputBuffer(OutputBuffer&&) = default;
+	OutputBuffer& operator=(OutputBuffer&&) = default;
+	~OutputBuffer() = default;
+
+	void append(std::string_view text) {
+		while (!text.empty()) {
+			if (m_current == m_end) [[unlikely]] {
+				add_chunk();
+			}
+
+			auto count = std::min(text.size(), static_cast<std::size_t>(m_end - m_current));
+			std::memcpy(m_current, text.data(), count);
+			m_current += count;
+			m_size += count;
+			text.remove_prefix(count);
+		}
+	}
+
+	void append(char c) {
+		if (m_current == m_end) [[unlikely]] {
+			add_chunk();
+		}
+
+		*m_current++ = c;
+		++m_size;
+	}
+
+	template<std::integral T>
+	void append_integer(T value) {
+		char digits[24];
+		auto [end, _] = std::to_chars(digits, digits + sizeof(digits), value);
+		append(std::string_view { digits, static_cast<std::size_t>(end - digits) });
+	}
+
+	OutputBuffer& operator<<(std::string_view text) {
+		append(text);
+		return *this;
+	}
+
+	OutputBuffer& operator<<(char c) {
+		append(c);
+		return *this;
+	}
+
+	template<std::integral T>
+	requires(!std::same_as<T, char> && !std::same_as<T, bool>)
+	OutputBuffer& operator<<(T value) {
+		append_integer(value);
+		return *this;
+	}
+
+	void append(OutputBuffer const& other) {
+		for (std::size_t i = 0; i < other.m_chunks.size(); ++i) {
+			append(other.chunk(i));
+		}
+	}
+
+	// NOTE: Number of bytes held, i.e. appended and not flushed yet.
+	std::size_t size() const { return m_size; }
+
+	// NOTE: Drops the contents but keeps the first chunk around for reuse.
+	void clear();
+
+	// NOTE: Writes out and drops every chunk that is full, keeping only the one
+	//       being appended to.
+	Result<void, Error> flush_full_chunks(OutputSink&);
+
+	// NOTE: Writes out everything and clears the buffer.
+	Result<void, Error> flush(OutputSink&);
+
+private:
+	std::string_view chunk(std::size_t index) const {
+		auto const* begin = m_chunks[index].get();
+		auto const* end = index + 1 == m_chunks.size() ? m_current : begin + m_chunk_size;
+		return { begin, static_cast<std::size_t>(end - begin) };
+	}
+
+	void add_chunk() {
+		m_chunks.push_back(std::make_unique_for_overwrite<char[]>(m_chunk_size));
+		m_current = m_chunks.back().get();
+		m_end = m_current + m_chunk_size;
+	}
+
+	std::size_t m_chunk_size;
+	std::vector<std::unique_ptr<char[]>> m_chunks;
+	char* m_current { nullptr };
+	char* m_end { nullptr };
+	std::size_t m_size { 0 };
+};
+
+}
@@ -0,0 +1,59 @@
+#include "OutputSink.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <sys/uio.h>
+#include <vector>
+
+namespace bo {
+
+Result<void, Error> FileDescriptorSink::write(std::span<std::string_view const> blocks) {
+	std::vector<iovec> iovecs;
+	iovecs.reserve(std::min<std::size_t>(blocks.size(), IOV_MAX));
+
+	while (!blocks.empty()) {
+		iovecs.clear();
+		for (auto block : blocks.first(std::min<std::size_t>(blocks.size(), IOV_MAX))) {
+			iovecs.push_back({ const_cast<char*>(block.data()), block.size() });
+		}
+
+		auto written = ::writev(m_fd, iovecs.data(), static_cast<int>(iovecs.size()));
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			return Error { fmt::format("couldn't write output: {}", std::strerror(errno)), Span { 0, 0 } };
+		}
+
+		// NOTE: A short write can stop in the middle of a block, whose rest is
+		//       written on its own before carrying on with the batch.
+		auto remaining = static_cast<std::size_t>(written);
+		while (!blocks.empty() && remaining >= blocks.front().size()) {
+			remaining -= blocks.front().size();
+			blocks = blocks.subspan(1);
+		}
+
+		if (remaining != 0) {
+			auto rest = blocks.front().substr(remaining);
+			TRY(write(std::span { &rest, 1 }));
+			blocks = blocks.subspan(1);
+		}
+	}
+
+	return {};
+}
+
+Result<void, Error> StringSink::write(std::span<std::string_view const> blocks) {
+	for (auto block : blocks) {
+		m_string += block;
+	}
+
+	return {};
+}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Error.hpp"
+#include "utils/Result.hpp"
+
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace bo {
+
+// NOTE: Receives generated code in order, a batch of blocks at a time. The
+//       views are only valid for the duration of the call.
+class OutputSink {
+public:
+	virtual ~OutputSink() = default;
+
+	virtual Result<void, Error> write(std::span<std::string_view const> blocks) = 0;
+};
+
+class FileDescriptorSink : public OutputSink {
+public:
+	explicit FileDescriptorSink(int fd)
+	  : m_fd(fd) {}
+
+	// NOTE: Writes every block with as few writev() calls as possible.
+	virtual Result<void, Error> write(std::span<std::string_view const> blocks) override;
+
+private:
+	int m_fd;
+};
+
+class StringSink : public OutputSink {
+public:
+	explicit StringSink(std::string& string)
+	  : m_string(string) {}
+
+	virtual Result<void, Error> write(std::span<std::string_view const> blocks) override;
+
+private:
+	std::string& m_string;
+};
+
+// NOTE: Forwards everything to two sinks, e.g. to keep a copy of the output.
+class TeeSink : public OutputSink {
+public:
+	TeeSink(OutputSink& first, OutputSink& second)
+	  : m_first(first), m_second(second) {}
+
+	virtual Result<void, Error> write(std::span<std::string_view const> blocks) override {
+		TRY(m_first.write(blocks));
+		return m_second.write(blocks);
+	}
+
+private:
+	OutputSink& m_first;
+	OutputSink& m_second;
+};
+
+}
@@ -1,16 +1,24 @@
 #include "Parser.hpp"
 
 #include "OperatorData.hpp"
+#include "Tracer.hpp"
 
 #include <fmt/core.h>
-#include <memory>
 
 namespace bo {
 
-Result<Parser, Error> Parser::create(std::string_view source) {
-	Lexer lexer { source };
-	auto current_token = TRY(lexer.next_token());
-	return Parser { std::move(lexer), std::move(current_token) };
+Result<Parser, Error> Parser::create(std::string_view source, Arena& arena, std::uint32_t base_offset, LexingMode lexing_mode) {
+	if (lexing_mode == LexingMode::Streaming) {
+		Lexer lexer { source, base_offset };
+		auto current_token = TRY(lexer.next_token());
+		return Parser { std::move(lexer), current_token, arena };
+	}
+
+	// NOTE: In batch mode the whole file is tokenized up front, so there's a
+	//       single event for it rather than one per declaration.
+	TraceScope trace { "lex", "tokenize" };
+	auto tokens = TRY(Lexer::tokenize(source, base_offset));
+	return Parser { std::move(tokens), arena };
 }
 
 template<typename Fn>
@@ -19,7 +27,7 @@ auto Parser::restrict(Fn fn, int restrictions) {
 	m_restrictions = restrictions;
 	auto result = fn();
 	m_restrictions = previous_restrictions;
-	return std::move(result);
+	return result;
 }
 
 Result<void, Error> Parser::consume(std::optional<Token::Type> token_type) {
@@ -27,22 +35,44 @@ Result<void, Error> Parser::consume(std::optional<Token::Type> token_type) {
 		return Error { fmt::format("Expected {:?}, got {:?}!", *token_type, m_current_token.type()), m_current_token.span() };
 	}
 
-	m_current_token = TRY(m_lexer.next_token());
+	if (auto* lexer = std::get_if<Lexer>(&m_tokens)) {
+		// NOTE: A scope per token would cost more than the lexing itself, so
+		//       the time is added up and recorded once per declaration, see
+		//       parse_function_declaration_statement().
+		if (Tracer::is_enabled()) [[unlikely]] {
+			auto start = Tracer::now();
+			m_current_token = TRY(lexer->next_token());
+			m_lex_time += Tracer::now() - start;
+		} else {
+			m_current_token = TRY(lexer->next_token());
+		}
+
+		return {};
+	}
+
+	// NOTE: The buffer always ends with an end of file token, which we never
+	//       move past.
+	auto const& tokens = std::get<TokenBuffer>(m_tokens);
+	if (m_current_index + 1 < tokens.size()) {
+		m_current_token = tokens.token(++m_current_index);
+	}
+
 	return {};
 }
 
-Result<std::shared_ptr<AST::Program const>, Error> Parser::parse_program() {
-	std::vector<std::shared_ptr<AST::FunctionDeclarationStatement const>> functions;
+Result<AST::Program const*, Error> Parser::parse_program() {
+	TraceScope trace { "parse", "program" };
+	std::vector<AST::FunctionDeclarationStatement const*> functions;
 
 	Span span { 0, 0 };
 	while (m_current_token.type() != Token::Type::EndOfFile) {
 		auto function_declaration = TRY(parse_function_declaration_statement());
 		span = Span::merge(span, function_declaration->span());
-		functions.push_back(std::move(function_declaration));
+		functions.push_back(function_declaration);
 	}
 
 	// FIXME: Should check if contains 'main' function
-	return std::make_shared<AST::Program const>(std::move(functions), span);
+	return m_arena.make<AST::Program>(m_arena.make_array(functions), span);
 }
 
 bool Parser::match_secondary_expression() const {
@@ -85,14 +115,14 @@ bool Parser::match_secondary_expression() const {
 	  || type == Token::Type::DoublePipeEquals;
 }
 
-Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_unary_expression() {
+Result<AST::Expression const*, Error> Parser::parse_unary_expression() {
 #define MAKE_UNARY_EXPRESSION(operator_)                                                                                                                           \
 	{                                                                                                                                                                \
 		auto span = m_current_token.span();                                                                                                                            \
 		TRY(consume());                                                                                                                                                \
 		auto operand = TRY(parse_primary_expression());                                                                                                                \
 		span = Span::merge(span, operand->span());                                                                                                                     \
-		return std::static_pointer_cast<AST::Expression const>(std::make_shared<AST::UnaryExpression const>(std::move(operand), AST::UnaryOperator::operator_, span)); \
+		return static_cast<AST::Expression const*>(m_arena.make<AST::UnaryExpression>(operand, AST::UnaryOperator::operator_, span)); \
 	}
 
 #define MAKE_UPDATE_EXPRESSION(operator_)                                                                                                                                  \
@@ -101,7 +131,7 @@ Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_unary_expres
 		TRY(consume());                                                                                                                                                        \
 		auto operand = TRY(parse_primary_expression());                                                                                                                        \
 		span = Span::merge(span, operand->span());                                                                                                                             \
-		return std::static_pointer_cast<AST::Expression const>(std::make_shared<AST::UpdateExpression const>(std::move(operand), AST::UpdateOperator::operator_, true, span)); \
+		return static_cast<AST::Expression const*>(m_arena.make<AST::UpdateExpression>(operand, AST::UpdateOperator::operator_, true, span)); \
 	}
 
 	switch (m_current_token.type()) {
@@ -123,7 +153,7 @@ Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_unary_expres
 			TRY(consume());
 			auto operand = TRY(parse_primary_expression());
 			span = Span::merge(span, operand->span());
-			return std::static_pointer_cast<AST::Expression const>(std::make_shared<AST::PointerDereferenceExpression const>(std::move(operand), span));
+			return static_cast<AST::Expression const*>(m_arena.make<AST::PointerDereferenceExpression>(operand, span));
 		}
 	case Token::Type::Ampersand:
 		{
@@ -131,7 +161,7 @@ Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_unary_expres
 			TRY(consume());
 			auto operand = TRY(parse_primary_expression());
 			span = Span::merge(span, operand->span());
-			return std::static_pointer_cast<AST::Expression const>(std::make_shared<AST::AddressOfExpression const>(std::move(operand), span));
+			return static_cast<AST::Expression const*>(m_arena.make<AST::AddressOfExpression>(operand, span));
 		}
 	default:
 		assert(false && "Should not be here!");
@@ -157,24 +187,24 @@ bool Parser::match_unary_expression() const {
 	}
 }
 
-Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_primary_expression() {
+Result<AST::Expression const*, Error> Parser::parse_primary_expression() {
 	if (match_unary_expression()) {
 		return TRY(parse_unary_expression());
 	}
 
 	switch (m_current_token.type()) {
 	case Token::Type::Identifier:
-		return std::static_pointer_cast<AST::Expression const>(TRY(parse_identifier()));
+		return static_cast<AST::Expression const*>(TRY(parse_identifier()));
 	case Token::Type::DecimalLiteral:
 	case Token::Type::BinaryLiteral:
 	case Token::Type::OctalLiteral:
 	case Token::Type::HexadecimalLiteral:
-		return std::static_pointer_cast<AST::Expression const>(TRY(parse_integer_literal()));
+		return static_cast<AST::Expression const*>(TRY(parse_integer_literal()));
 	case Token::Type::CharLiteral:
-		return std::static_pointer_cast<AST::Expression const>(TRY(parse_char_literal()));
+		return static_cast<AST::Expression const*>(TRY(parse_char_literal()));
 	case Token::Type::KW_true:
 	case Token::Type::KW_false:
-		return std::static_pointer_cast<AST::Expression const>(TRY(parse_boolean_literal()));
+		return static_cast<AST::Expression const*>(TRY(parse_boolean_literal()));
 	case Token::Type::LeftParenthesis:
 		{
 			auto span = m_current_token.span();
@@ -184,26 +214,26 @@ Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_primary_expr
 			span = Span::merge(span, m_current_token.span());
 			TRY(consume(Token::Type::RightParenthesis));
 
-			return std::static_pointer_cast<AST::Expression const>(std::make_shared<AST::ParenthesizedExpression const>(std::move(expression), span));
+			return static_cast<AST::Expression const*>(m_arena.make<AST::ParenthesizedExpression>(expression, span));
 		}
 	case Token::Type::LeftSquareBracket:
-		return std::static_pointer_cast<AST::Expression const>(TRY(parse_array_expression()));
+		return static_cast<AST::Expression const*>(TRY(parse_array_expression()));
 	case Token::Type::LeftCurlyBracket:
-		return std::static_pointer_cast<AST::Expression const>(TRY(parse_block_expression()));
+		return static_cast<AST::Expression const*>(TRY(parse_block_expression()));
 	case Token::Type::KW_if:
-		return std::static_pointer_cast<AST::Expression const>(TRY(parse_if_expression()));
+		return static_cast<AST::Expression const*>(TRY(parse_if_expression()));
 	default:
 		return Error { fmt::format("Expected primary expression, got {:?}!", m_current_token.type()), m_current_token.span() };
 	}
 }
 
-Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_secondary_expression(std::shared_ptr<AST::Expression const> lhs, unsigned minimum_precedence) {
+Result<AST::Expression const*, Error> Parser::parse_secondary_expression(AST::Expression const* lhs, unsigned minimum_precedence) {
 #define MAKE_BINARY_EXPRESSION(operator_)                                                                                                                                        \
 	{                                                                                                                                                                              \
 		TRY(consume());                                                                                                                                                              \
 		auto rhs = TRY(parse_expression_inner(minimum_precedence));                                                                                                                  \
 		auto span = Span::merge(lhs->span(), rhs->span());                                                                                                                           \
-		return std::static_pointer_cast<AST::Expression const>(std::make_shared<AST::BinaryExpression const>(std::move(lhs), std::move(rhs), AST::BinaryOperator::operator_, span)); \
+		return static_cast<AST::Expression const*>(m_arena.make<AST::BinaryExpression>(lhs, rhs, AST::BinaryOperator::operator_, span)); \
 	}
 
 #define MAKE_ASSIGNMENT_EXPRESSION(operator_)                                                                                                                                            \
@@ -211,7 +241,7 @@ Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_secondary_ex
 		TRY(consume());                                                                                                                                                                      \
 		auto rhs = TRY(parse_expression_inner(minimum_precedence));                                                                                                                          \
 		auto span = Span::merge(lhs->span(), rhs->span());                                                                                                                                   \
-		return std::static_pointer_cast<AST::Expression const>(std::make_shared<AST::AssignmentExpression const>(std::move(lhs), std::move(rhs), AST::AssignmentOperator::operator_, span)); \
+		return static_cast<AST::Expression const*>(m_arena.make<AST::AssignmentExpression>(lhs, rhs, AST::AssignmentOperator::operator_, span)); \
 	}
 
 #define MAKE_RANGE_EXPRESSION(is_inclusive)                                                                                                                     \
@@ -219,14 +249,14 @@ Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_secondary_ex
 		TRY(consume());                                                                                                                                             \
 		auto rhs = TRY(parse_expression_inner(minimum_precedence));                                                                                                 \
 		auto span = Span::merge(lhs->span(), rhs->span());                                                                                                          \
-		return std::static_pointer_cast<AST::Expression const>(std::make_shared<AST::RangeExpression const>(std::move(lhs), std::move(rhs), (is_inclusive), span)); \
+		return static_cast<AST::Expression const*>(m_arena.make<AST::RangeExpression>(lhs, rhs, (is_inclusive), span)); \
 	}
 
 #define MAKE_UPDATE_EXPRESSION(operator_)                                                                                                                               \
 	{                                                                                                                                                                     \
 		auto span = Span::merge(m_current_token.span(), lhs->span());                                                                                                       \
 		TRY(consume());                                                                                                                                                     \
-		return std::static_pointer_cast<AST::Expression const>(std::make_shared<AST::UpdateExpression const>(std::move(lhs), AST::UpdateOperator::operator_, false, span)); \
+		return static_cast<AST::Expression const*>(m_arena.make<AST::UpdateExpression>(lhs, AST::UpdateOperator::operator_, false, span)); \
 	}
 
 	switch (m_current_token.type()) {
@@ -250,8 +280,8 @@ Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_secondary_ex
 				return Error { "Expected identifier before function call", lhs->span() };
 			}
 
-			auto identifier = std::static_pointer_cast<AST::Identifier const>(lhs);
-			return std::static_pointer_cast<AST::Expression const>(TRY(parse_function_call_expression(std::move(identifier))));
+			auto identifier = static_cast<AST::Identifier const*>(lhs);
+			return static_cast<AST::Expression const*>(TRY(parse_function_call_expression(identifier)));
 		}
 	case Token::Type::LeftShift:
 		MAKE_BINARY_EXPRESSION(BitwiseLeftShift);
@@ -266,7 +296,7 @@ Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_secondary_ex
 			span = Span::merge(span, m_current_token.span());
 			TRY(consume(Token::Type::RightSquareBracket));
 
-			return std::static_pointer_cast<AST::Expression const>(std::make_shared<AST::ArraySubscriptExpression const>(std::move(lhs), std::move(subscript), span));
+			return static_cast<AST::Expression const*>(m_arena.make<AST::ArraySubscriptExpression>(lhs, subscript, span));
 		}
 	case Token::Type::RightShift:
 		MAKE_BINARY_EXPRESSION(BitwiseRightShift);
@@ -327,7 +357,7 @@ Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_secondary_ex
 	}
 }
 
-Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_expression_inner(unsigned minimum_precedence) {
+Result<AST::Expression const*, Error> Parser::parse_expression_inner(unsigned minimum_precedence) {
 	auto result = TRY(parse_primary_expression());
 
 	if (m_restrictions & R_NoExpressionsWithBlocks && result->has_block()) {
@@ -351,29 +381,29 @@ Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_expression_i
 			++operator_precedence;
 		}
 
-		result = TRY(parse_secondary_expression(std::move(result), operator_precedence));
+		result = TRY(parse_secondary_expression(result, operator_precedence));
 	}
 
 	return result;
 }
 
-Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_expression() {
+Result<AST::Expression const*, Error> Parser::parse_expression() {
 	return parse_expression_with_restrictions(R_None);
 }
 
-Result<std::shared_ptr<AST::Expression const>, Error> Parser::parse_expression_with_restrictions(int restrictions) {
+Result<AST::Expression const*, Error> Parser::parse_expression_with_restrictions(int restrictions) {
 	return restrict([this]() { return parse_expression_inner(0); }, restrictions);
 }
 
-Result<std::shared_ptr<AST::Statement const>, Error> Parser::parse_statement() {
+Result<AST::Statement const*, Error> Parser::parse_statement() {
 	switch (m_current_token.type()) {
 	case Token::Type::KW_var:
 	case Token::Type::KW_mut:
-		return std::static_pointer_cast<AST::Statement const>(TRY(parse_variable_declaration_statement()));
+		return static_cast<AST::Statement const*>(TRY(parse_variable_declaration_statement()));
 	case Token::Type::KW_for:
-		return std::static_pointer_cast<AST::Statement const>(TRY(parse_for_statement()));
+		return static_cast<AST::Statement const*>(TRY(parse_for_statement()));
 	case Token::Type::KW_return:
-		return std::static_pointer_cast<AST::Statement const>(TRY(parse_return_statement()));
+		return static_cast<AST::Statement const*>(TRY(parse_return_statement()));
 	default:
 		{
 			auto expression = TRY(parse_expression_with_restrictions(R_NoExpressionsWithBlocks));
@@ -381,11 +411,11 @@ Result<std::shared_ptr<AST::Statement const>, Error> Parser::parse_statement() {
 				auto span = Span::merge(m_current_token.span(), expression->span());
 				TRY(consume());
 
-				return std::static_pointer_cast<AST::Statement const>(std::make_shared<AST::ExpressionStatement const>(std::move(expression), true, span));
+				return static_cast<AST::Statement const*>(m_arena.make<AST::ExpressionStatement>(expression, true, span));
 			}
 
 			if (expression->has_block() || m_current_token.type() == Token::Type::RightCurlyBracket) {
-				return std::static_pointer_cast<AST::Statement const>(std::make_shared<AST::ExpressionStatement const>(std::move(expression), false, expression->span()));
+				return static_cast<AST::Statement const*>(m_arena.make<AST::ExpressionStatement>(expression, false, expression->span()));
 			}
 
 			return Error { "Expected semicolon after expression", expression->span() };
@@ -393,11 +423,11 @@ Result<std::shared_ptr<AST::Statement const>, Error> Parser::parse_statement() {
 	}
 }
 
-Result<std::shared_ptr<AST::BlockExpression const>, Error> Parser::parse_block_expression() {
+Result<AST::BlockExpression const*, Error> Parser::parse_block_expression() {
 	auto span = m_current_token.span();
 	TRY(consume(Token::Type::LeftCurlyBracket));
 
-	std::vector<std::shared_ptr<AST::Statement const>> statements;
+	std::vector<AST::Statement const*> statements;
 	while (m_current_token.type() != Token::Type::RightCurlyBracket) {
 		statements.push_back(TRY(parse_statement()));
 	}
@@ -405,10 +435,10 @@ Result<std::shared_ptr<AST::BlockExpression const>, Error> Parser::parse_block_e
 	span = Span::merge(span, m_current_token.span());
 	TRY(consume(Token::Type::RightCurlyBracket));
 
-	return std::make_shared<AST::BlockExpression const>(std::move(statements), span);
+	return m_arena.make<AST::BlockExpression>(m_arena.make_array(statements), span);
 }
 
-Result<std::shared_ptr<AST::IfExpression const>, Error> Parser::parse_if_expression() {
+Result<AST::IfExpression const*, Error> Parser::parse_if_expression() {
 	auto span = m_current_token.span();
 
 	TRY(consume(Token::Type::KW_if));
@@ -426,27 +456,27 @@ Result<std::shared_ptr<AST::IfExpression const>, Error> Parser::parse_if_express
 		if (m_current_token.type() == Token::Type::KW_if) {
 			auto else_if = TRY(parse_if_expression());
 			span = Span::merge(span, else_if->span());
-			return std::make_shared<AST::IfExpression const>(std::move(condition), std::move(then), std::move(else_if), span);
+			return m_arena.make<AST::IfExpression>(condition, then, else_if, span);
 		}
 
 		auto else_ = TRY(parse_block_expression());
 		span = Span::merge(span, else_->span());
-		return std::make_shared<AST::IfExpression const>(std::move(condition), std::move(then), std::move(else_), span);
+		return m_arena.make<AST::IfExpression>(condition, then, else_, span);
 	}
 
-	return std::make_shared<AST::IfExpression const>(std::move(condition), std::move(then), nullptr, span);
+	return m_arena.make<AST::IfExpression>(condition, then, nullptr, span);
 }
 
-Result<std::shared_ptr<AST::ArrayExpression const>, Error> Parser::parse_array_expression() {
+Result<AST::ArrayExpression const*, Error> Parser::parse_array_expression() {
 	auto span = m_current_token.span();
 	TRY(consume(Token::Type::LeftSquareBracket));
 
-	std::vector<std::shared_ptr<AST::Expression const>> elements;
+	std::vector<AST::Expression const*> elements;
 	while (m_current_token.type() != Token::Type::RightSquareBracket) {
 		auto element = TRY(parse_expression());
 		span = Span::merge(span, element->span());
 
-		elements.push_back(std::move(element));
+		elements.push_back(element);
 
 		if (m_current_token.type() != Token::Type::Comma) {
 			break;
@@ -459,10 +489,10 @@ Result<std::shared_ptr<AST::ArrayExpression const>, Error> Parser::parse_array_e
 	span = Span::merge(span, m_current_token.span());
 	TRY(consume(Token::Type::RightSquareBracket));
 
-	return std::make_shared<AST::ArrayExpression const>(std::move(elements), span);
+	return m_arena.make<AST::ArrayExpression>(m_arena.make_array(elements), span);
 }
 
-Result<std::shared_ptr<AST::FunctionCallExpression const>, Error> Parser::parse_function_call_expression(std::shared_ptr<AST::Identifier const> function_name) {
+Result<AST::FunctionCallExpression const*, Error> Parser::parse_function_call_expression(AST::Identifier const* function_name) {
 	auto span = Span::merge(function_name->span(), m_current_token.span());
 	TRY(consume(Token::Type::LeftParenthesis));
 
@@ -470,11 +500,11 @@ Result<std::shared_ptr<AST::FunctionCallExpression const>, Error> Parser::parse_
 	while (m_current_token.type() != Token::Type::RightParenthesis) {
 		auto argument = TRY(parse_expression());
 
-		std::shared_ptr<AST::Identifier const> argument_name = nullptr;
-		std::shared_ptr<AST::Expression const> argument_value = nullptr;
+		AST::Identifier const* argument_name = nullptr;
+		AST::Expression const* argument_value = nullptr;
 
 		if (argument->is_identifier()) {
-			argument_name = std::static_pointer_cast<AST::Identifier const>(argument);
+			argument_name = static_cast<AST::Identifier const*>(argument);
 
 			if (m_current_token.type() == Token::Type::Colon) {
 				TRY(consume());
@@ -497,10 +527,10 @@ Result<std::shared_ptr<AST::FunctionCallExpression const>, Error> Parser::parse_
 	span = Span::merge(span, m_current_token.span());
 	TRY(consume(Token::Type::RightParenthesis));
 
-	return std::make_shared<AST::FunctionCallExpression const>(std::move(function_name), std::move(arguments), span);
+	return m_arena.make<AST::FunctionCallExpression>(function_name, m_arena.make_array(arguments), span);
 }
 
-Result<std::shared_ptr<AST::ForStatement const>, Error> Parser::parse_for_statement() {
+Result<AST::ForStatement const*, Error> Parser::parse_for_statement() {
 	auto span = m_current_token.span();
 
 	TRY(consume(Token::Type::KW_for));
@@ -515,7 +545,7 @@ Result<std::shared_ptr<AST::ForStatement const>, Error> Parser::parse_for_statem
 				return Error { "Expected identifier in for-in loop!", condition->span() };
 			}
 
-			auto identifier = std::static_pointer_cast<AST::Identifier const>(condition);
+			auto identifier = static_cast<AST::Identifier const*>(condition);
 			auto range_expression = TRY(parse_expression());
 			span = Span::merge(span, range_expression->span());
 
@@ -523,25 +553,25 @@ Result<std::shared_ptr<AST::ForStatement const>, Error> Parser::parse_for_statem
 
 			auto body = TRY(parse_block_expression());
 			span = Span::merge(span, body->span());
-			return std::static_pointer_cast<AST::ForStatement const>(std::make_shared<AST::ForWithRangeStatement const>(std::move(identifier), std::move(range_expression), std::move(body), span));
+			return static_cast<AST::ForStatement const*>(m_arena.make<AST::ForWithRangeStatement>(identifier, range_expression, body, span));
 		}
 
 		TRY(consume(Token::Type::RightParenthesis));
 		auto body = TRY(parse_block_expression());
 		span = Span::merge(span, body->span());
-		return std::static_pointer_cast<AST::ForStatement const>(std::make_shared<AST::ForWithConditionStatement const>(std::move(condition), std::move(body), span));
+		return static_cast<AST::ForStatement const*>(m_arena.make<AST::ForWithConditionStatement>(condition, body, span));
 	}
 
 	auto body = TRY(parse_block_expression());
 	span = Span::merge(span, body->span());
-	return std::static_pointer_cast<AST::ForStatement const>(std::make_shared<AST::InfiniteForStatement const>(std::move(body), span));
+	return static_cast<AST::ForStatement const*>(m_arena.make<AST::InfiniteForStatement>(body, span));
 }
 
-Result<std::shared_ptr<AST::Type const>, Error> Parser::parse_type(bool allow_top_level_mut) {
+Result<AST::Type const*, Error> Parser::parse_type(bool allow_top_level_mut) {
 	auto span = m_current_token.span();
-	std::shared_ptr<AST::Type const> inner_type = nullptr;
-	std::shared_ptr<AST::IntegerLiteral const> array_size = nullptr;
-	std::shared_ptr<AST::Identifier const> name = nullptr;
+	AST::Type const* inner_type = nullptr;
+	AST::IntegerLiteral const* array_size = nullptr;
+	AST::Identifier const* name = nullptr;
 	int flags = 0;
 
 	if (m_current_token.type() == Token::Type::KW_mut) {
@@ -584,10 +614,10 @@ Result<std::shared_ptr<AST::Type const>, Error> Parser::parse_type(bool allow_to
 		span = Span::merge(span, name->span());
 	}
 
-	return std::make_shared<AST::Type const>(std::move(inner_type), std::move(array_size), std::move(name), flags, span);
+	return m_arena.make<AST::Type>(inner_type, array_size, name, flags, span);
 }
 
-Result<std::shared_ptr<AST::Identifier const>, Error> Parser::parse_identifier(bool allow_keywords) {
+Result<AST::Identifier const*, Error> Parser::parse_identifier(bool allow_keywords) {
 	// FIXME: Switch to something better
 	if (m_current_token.type() != Token::Type::Identifier && (!allow_keywords || !m_current_token.is_keyword())) {
 		if (!allow_keywords && m_current_token.is_keyword()) {
@@ -595,13 +625,14 @@ Result<std::shared_ptr<AST::Identifier const>, Error> Parser::parse_identifier(b
 		}
 	}
 
-	auto identifier_value = m_current_token.value();
+	// NOTE: Only identifiers and keywords are interned by the lexer.
+	auto identifier_symbol = m_current_token.symbol() != Symbol {} ? m_current_token.symbol() : Symbol::intern(m_current_token.value());
 	auto identifier_span = m_current_token.span();
 	TRY(consume());
-	return std::make_shared<AST::Identifier const>(identifier_value, identifier_span);
+	return m_arena.make<AST::Identifier>(identifier_symbol, identifier_span);
 }
 
-Result<std::shared_ptr<AST::IntegerLiteral const>, Error> Parser::parse_integer_literal() {
+Result<AST::IntegerLiteral const*, Error> Parser::parse_integer_literal() {
 	AST::IntegerLiteral::Type literal_type;
 	switch (m_current_token.type()) {
 	case Token::Type::DecimalLiteral:
@@ -628,10 +659,10 @@ Result<std::shared_ptr<AST::IntegerLiteral const>, Error> Parser::parse_integer_
 	auto literal_suffix = literal_suffix_start == std::string_view::npos ? ""sv : literal_value.substr(literal_suffix_start + 1);
 	literal_value = literal_value.substr(0, literal_suffix_start);
 
-	return std::make_shared<AST::IntegerLiteral const>(literal_value, literal_type, literal_suffix, literal_span);
+	return m_arena.make<AST::IntegerLiteral>(literal_value, literal_type, literal_suffix, literal_span);
 }
 
-Result<std::shared_ptr<AST::CharLiteral const>, Error> Parser::parse_char_literal() {
+Result<AST::CharLiteral const*, Error> Parser::parse_char_literal() {
 	if (m_current_token.type() != Token::Type::CharLiteral) {
 		return Error { fmt::format("Expected char literal, got {:?}!", m_current_token.value()), m_current_token.span() };
 	}
@@ -639,17 +670,17 @@ Result<std::shared_ptr<AST::CharLiteral const>, Error> Parser::parse_char_litera
 	auto literal_value = m_current_token.value();
 	auto literal_span = m_current_token.span();
 	TRY(consume());
-	return std::make_shared<AST::CharLiteral const>(literal_value, literal_span);
+	return m_arena.make<AST::CharLiteral>(literal_value, literal_span);
 }
 
-Result<std::shared_ptr<AST::BooleanLiteral const>, Error> Parser::parse_boolean_literal() {
+Result<AST::BooleanLiteral const*, Error> Parser::parse_boolean_literal() {
 	switch (m_current_token.type()) {
 	case Token::Type::KW_true:
 		TRY(consume());
-		return std::make_shared<AST::BooleanLiteral const>(true, m_current_token.span());
+		return m_arena.make<AST::BooleanLiteral>(true, m_current_token.span());
 	case Token::Type::KW_false:
 		TRY(consume());
-		return std::make_shared<AST::BooleanLiteral const>(false, m_current_token.span());
+		return m_arena.make<AST::BooleanLiteral>(false, m_current_token.span());
 	default:
 		return Error { fmt::format("Expected boolean literal, got {:?}!", m_current_token.value()), m_current_token.span() };
 	}
@@ -669,7 +700,7 @@ Result<std::vector<AST::FunctionParameter>, Error> Parser::parse_function_parame
 		auto parameter_name = TRY(parse_identifier());
 		TRY(consume(Token::Type::Colon));
 		auto parameter_type = TRY(parse_type());
-		parameters.emplace_back(std::move(parameter_name), std::move(parameter_type), is_anonymous);
+		parameters.emplace_back(parameter_name, parameter_type, is_anonymous);
 
 		if (m_current_token.type() != Token::Type::Comma) {
 			break;
@@ -682,11 +713,13 @@ Result<std::vector<AST::FunctionParameter>, Error> Parser::parse_function_parame
 	return parameters;
 }
 
-Result<std::shared_ptr<AST::FunctionDeclarationStatement const>, Error> Parser::parse_function_declaration_statement() {
+Result<AST::FunctionDeclarationStatement const*, Error> Parser::parse_function_declaration_statement() {
+	TraceScope trace { "parse" };
 	auto span = m_current_token.span();
 
 	TRY(consume(Token::Type::KW_fn));
 	auto function_name = TRY(parse_identifier());
+	trace.set_name(function_name->id());
 	auto function_parameters = TRY(parse_function_parameters());
 	TRY(consume(Token::Type::Colon));
 	auto function_return_type = TRY(parse_type(false));
@@ -694,10 +727,19 @@ Result<std::shared_ptr<AST::FunctionDeclarationStatement const>, Error> Parser::
 
 	span = Span::merge(span, m_current_token.span());
 
-	return std::make_shared<AST::FunctionDeclarationStatement const>(function_name, function_parameters, function_return_type, function_body, span);
+	// NOTE: Streamed lexing is interleaved with parsing, so its event only
+	//       tells how long it took: it ends here and lasts as long as the
+	//       lexing of the declaration's tokens added up to.
+	if (m_lex_time != 0) {
+		auto end = Tracer::now();
+		Tracer::record("lex", function_name->id(), end - m_lex_time, end);
+		m_lex_time = 0;
+	}
+
+	return m_arena.make<AST::FunctionDeclarationStatement>(function_name, m_arena.make_array(function_parameters), function_return_type, function_body, span);
 }
 
-Result<std::shared_ptr<AST::VariableDeclarationStatement const>, Error> Parser::parse_variable_declaration_statement() {
+Result<AST::VariableDeclarationStatement const*, Error> Parser::parse_variable_declaration_statement() {
 	auto span = m_current_token.span();
 
 	bool is_mutable = false;
@@ -709,8 +751,8 @@ Result<std::shared_ptr<AST::VariableDeclarationStatement const>, Error> Parser::
 	}
 
 	auto identifier = TRY(parse_identifier());
-	std::shared_ptr<AST::Type const> type = nullptr;
-	std::shared_ptr<AST::Expression const> initializer = nullptr;
+	AST::Type const* type = nullptr;
+	AST::Expression const* initializer = nullptr;
 
 	if (m_current_token.type() == Token::Type::Equals) {
 		TRY(consume());
@@ -729,17 +771,17 @@ Result<std::shared_ptr<AST::VariableDeclarationStatement const>, Error> Parser::
 
 	span = Span::merge(span, m_current_token.span());
 	TRY(consume(Token::Type::Semicolon));
-	return std::make_shared<AST::VariableDeclarationStatement const>(is_mutable, std::move(identifier), std::move(type), std::move(initializer), span);
+	return m_arena.make<AST::VariableDeclarationStatement>(is_mutable, identifier, type, initializer, span);
 }
 
-Result<std::shared_ptr<AST::ReturnStatement const>, Error> Parser::parse_return_statement() {
+Result<AST::ReturnStatement const*, Error> Parser::parse_return_statement() {
 	auto span = m_current_token.span();
 	TRY(consume(Token::Type::KW_return));
 
 	if (m_current_token.type() == Token::Type::Semicolon) {
 		span = Span::merge(span, m_current_token.span());
 		TRY(consume());
-		return std::make_shared<AST::ReturnStatement const>(nullptr, span);
+		return m_arena.make<AST::ReturnStatement>(nullptr, span);
 	}
 
 	auto expression = TRY(parse_expression());
@@ -748,7 +790,7 @@ Result<std::shared_ptr<AST::ReturnStatement const>, Error> Parser::parse_return_
 	span = Span::merge(span, m_current_token.span());
 	TRY(consume(Token::Type::Semicolon));
 
-	return std::make_shared<AST::ReturnStatement const>(std::move(expression), span);
+	return m_arena.make<AST::ReturnStatement>(expression, span);
 }
 
 }
@@ -2,18 +2,35 @@
 
 #include "AST.hpp"
 #include "Lexer.hpp"
+#include "TokenBuffer.hpp"
+#include "utils/Arena.hpp"
+
+#include <variant>
 
 namespace bo {
 
 class Parser {
 public:
-	static Result<Parser, Error> create(std::string_view source);
+	// NOTE: Streaming pulls each token from the lexer as it's consumed, Batch
+	//       lexes the whole source into a TokenBuffer first. Batch only pays
+	//       for itself with lookahead, which the grammar doesn't need yet, so
+	//       streaming is the default.
+	enum class LexingMode {
+		Streaming,
+		Batch,
+	};
+
+	// NOTE: See Lexer for base_offset.
+	static Result<Parser, Error> create(std::string_view source, Arena& arena, std::uint32_t base_offset = 0, LexingMode = LexingMode::Streaming);
 
-	Result<std::shared_ptr<AST::Program const>, Error> parse_program();
+	Result<AST::Program const*, Error> parse_program();
 
 private:
-	explicit Parser(Lexer&& lexer, Token&& current_token)
-	  : m_lexer(std::move(lexer)), m_current_token(std::move(current_token)) {}
+	explicit Parser(Lexer&& lexer, Token current_token, Arena& arena)
+	  : m_tokens(std::move(lexer)), m_current_token(current_token), m_arena(arena) {}
+
+	explicit Parser(TokenBuffer&& tokens, Arena& arena)
+	  : m_tokens(std::move(tokens)), m_current_token(std::get<TokenBuffer>(m_tokens).token(0)), m_arena(arena) {}
 
 	template<typename Fn>
 	auto restrict(Fn fn, int restrictions);
@@ -21,34 +38,40 @@ private:
 	bool match_unary_expression() const;
 	bool match_secondary_expression() const;
 
-	Result<std::shared_ptr<AST::Type const>, Error> parse_type(bool allow_top_level_mut = true);
-	Result<std::shared_ptr<AST::Identifier const>, Error> parse_identifier(bool allow_keywords = false);
-	Result<std::shared_ptr<AST::IntegerLiteral const>, Error> parse_integer_literal();
-	Result<std::shared_ptr<AST::CharLiteral const>, Error> parse_char_literal();
-	Result<std::shared_ptr<AST::BooleanLiteral const>, Error> parse_boolean_literal();
-
-	Result<std::shared_ptr<AST::Expression const>, Error> parse_unary_expression();
-	Result<std::shared_ptr<AST::Expression const>, Error> parse_primary_expression();
-	Result<std::shared_ptr<AST::Expression const>, Error> parse_secondary_expression(std::shared_ptr<AST::Expression const> lhs, unsigned minimum_precedence);
-	Result<std::shared_ptr<AST::Expression const>, Error> parse_expression_inner(unsigned minimum_precedence);
-	Result<std::shared_ptr<AST::Expression const>, Error> parse_expression();
-	Result<std::shared_ptr<AST::Expression const>, Error> parse_expression_with_restrictions(int restrictions);
-	Result<std::shared_ptr<AST::BlockExpression const>, Error> parse_block_expression();
-	Result<std::shared_ptr<AST::IfExpression const>, Error> parse_if_expression();
-	Result<std::shared_ptr<AST::ArrayExpression const>, Error> parse_array_expression();
-	Result<std::shared_ptr<AST::FunctionCallExpression const>, Error> parse_function_call_expression(std::shared_ptr<AST::Identifier const> function_name);
-
-	Result<std::shared_ptr<AST::Statement const>, Error> parse_statement();
-	Result<std::shared_ptr<AST::VariableDeclarationStatement const>, Error> parse_variable_declaration_statement();
-	Result<std::shared_ptr<AST::ForStatement const>, Error> parse_for_statement();
+	Result<AST::Type const*, Error> parse_type(bool allow_top_level_mut = true);
+	Result<AST::Identifier const*, Error> parse_identifier(bool allow_keywords = false);
+	Result<AST::IntegerLiteral const*, Error> parse_integer_literal();
+	Result<AST::CharLiteral const*, Error> parse_char_literal();
+	Result<AST::BooleanLiteral const*, Error> parse_boolean_literal();
+
+	Result<AST::Expression const*, Error> parse_unary_expression();
+	Result<AST::Expression const*, Error> parse_primary_expression();
+	Result<AST::Expression const*, Error> parse_secondary_expression(AST::Expression const* lhs, unsigned minimum_precedence);
+	Result<AST::Expression const*, Error> parse_expression_inner(unsigned minimum_precedence);
+	Result<AST::Expression const*, Error> parse_expression();
+	Result<AST::Expression const*, Error> parse_expression_with_restrictions(int restrictions);
+	Result<AST::BlockExpression const*, Error> parse_block_expression();
+	Result<AST::IfExpression const*, Error> parse_if_expression();
+	Result<AST::ArrayExpression const*, Error> parse_array_expression();
+	Result<AST::FunctionCallExpression const*, Error> parse_function_call_expression(AST::Identifier const* function_name);
+
+	Result<AST::Statement const*, Error> parse_statement();
+	Result<AST::VariableDeclarationStatement const*, Error> parse_variable_declaration_statement();
+	Result<AST::ForStatement const*, Error> parse_for_statement();
 	Result<std::vector<AST::FunctionParameter>, Error> parse_function_parameters();
-	Result<std::shared_ptr<AST::FunctionDeclarationStatement const>, Error> parse_function_declaration_statement();
-	Result<std::shared_ptr<AST::ReturnStatement const>, Error> parse_return_statement();
+	Result<AST::FunctionDeclarationStatement const*, Error> parse_function_declaration_statement();
+	Result<AST::ReturnStatement const*, Error> parse_return_statement();
 
 	Result<void, Error> consume(std::optional<Token::Type> = {});
 
-	Lexer m_lexer;
+	std::variant<Lexer, TokenBuffer> m_tokens;
+	// NOTE: Only used in batch mode.
+	std::size_t m_current_index { 0 };
+	// NOTE: Only used in streaming mode while tracing: the nanoseconds spent
+	//       lexing since the last function declaration was recorded.
+	std::uint64_t m_lex_time { 0 };
 	Token m_current_token;
+	Arena& m_arena;
 
 	enum Restrictions : int {
 		R_None = 0,
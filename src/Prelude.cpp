@@ -0,0 +1,155 @@
+#include "Prelude.hpp"
+
+#include "SourceFile.hpp"
+#include "System.hpp"
+#include "utils/Hash.hpp"
+
+#include <fmt/core.h>
+
+#include <cerrno>
+#include <filesystem>
+#include <sys/stat.h>
+#include <vector>
+
+namespace bo {
+
+std::string_view prelude() {
+	return R"(#include <cstdint>
+#include <array>
+#include <span>
+#include <print>
+
+using u8 = std::uint8_t;
+using u16 = std::uint16_t;
+using u32 = std::uint32_t;
+using u64 = std::uint64_t;
+using usize = std::uint64_t;
+using i8 = std::int8_t;
+using i16 = std::int16_t;
+using i32 = std::int32_t;
+using i64 = std::int64_t;
+using isize = std::int64_t;
+
+u8 operator""_u8(unsigned long long value) { return static_cast<u8>(value); }
+u16 operator""_u16(unsigned long long value) { return static_cast<u16>(value); }
+u32 operator""_u32(unsigned long long value) { return static_cast<u32>(value); }
+u64 operator""_u64(unsigned long long value) { return static_cast<u64>(value); }
+usize operator""_usize(unsigned long long value) { return static_cast<usize>(value); }
+i8 operator""_i8(unsigned long long value) { return static_cast<i8>(value); }
+i16 operator""_i16(unsigned long long value) { return static_cast<i16>(value); }
+i32 operator""_i32(unsigned long long value) { return static_cast<i32>(value); }
+i64 operator""_i64(unsigned long long value) { return static_cast<i64>(value); }
+isize operator""_isize(unsigned long long value) { return static_cast<isize>(value); }
+
+template<typename ElementType, bool is_inclusive>
+class bo_range {
+public:
+    struct iterator {
+        ElementType value;
+        constexpr iterator(ElementType value_):
+            value(value_) {}
+
+        constexpr ElementType operator*() { return value; }
+        constexpr bool operator==(iterator const& other) { return value == other.value; }
+        constexpr bool operator!=(iterator const& other) { return !(*this == other); }
+        constexpr void operator++() { ++value; }
+    };
+
+    constexpr bo_range(ElementType start, ElementType end):
+        m_start(start), m_end(end) {}
+
+    constexpr iterator begin() { return m_start; }
+    constexpr iterator end() {
+        if constexpr (is_inclusive) {
+            return m_end + 1;
+        } else {
+            return m_end;
+        }
+    }
+
+private:
+    ElementType m_start;
+    ElementType m_end;
+};
+
+template<typename T>
+void print(T value) {
+	std::print("{}", value);
+}
+
+)";
+}
+
+static bool is_newer_or_as_new(struct stat const& status, struct stat const& other) {
+	if (status.st_mtim.tv_sec != other.st_mtim.tv_sec) {
+		return status.st_mtim.tv_sec > other.st_mtim.tv_sec;
+	}
+
+	return status.st_mtim.tv_nsec >= other.st_mtim.tv_nsec;
+}
+
+// NOTE: A precompiled header is only used with the compiler and flags that
+//       built it, so each combination gets its own. GCC tries every file of a
+//       `.gch` directory and takes the first one that is valid.
+static std::string precompiled_header_name(std::string const& compiler, std::span<std::string const> flags) {
+	ContentHasher hasher;
+	hasher.update_field(compiler);
+	hasher.update_field(file_identity(find_program(compiler).value_or(compiler)));
+	for (auto const& flag : flags) {
+		hasher.update_field(flag);
+	}
+
+	return hasher.hex_digest() + ".gch";
+}
+
+Result<void, Error> write_precompiled_prelude(std::string const& directory, std::string const& compiler, std::span<std::string const> flags) {
+	if (::mkdir(directory.c_str(), 0777) < 0 && errno != EEXIST) {
+		return system_error("create directory", directory);
+	}
+
+	auto header_path = fmt::format("{}/{}", directory, prelude_header_name);
+	auto precompiled_headers_directory = header_path + ".gch";
+	auto precompiled_header_path = fmt::format("{}/{}", precompiled_headers_directory, precompiled_header_name(compiler, flags));
+	// NOTE: GCC warns about `#pragma once` in the file being precompiled, so
+	//       this uses a classic include guard.
+	auto header = fmt::format("#ifndef BO_PRELUDE_HPP\n#define BO_PRELUDE_HPP\n\n{}#endif\n", prelude());
+
+	// NOTE: The header is only rewritten when it changes, so that its
+	//       timestamp tells whether a precompiled header is stale. GCC doesn't
+	//       check precompiled headers against the header they came from, so
+	//       the ones of its previous contents are removed along with it, as is
+	//       the single `.gch` file earlier versions wrote instead of a
+	//       directory.
+	std::error_code error_code;
+	auto existing_header = SourceFile::open(header_path);
+	if (existing_header.is_error() || existing_header.value().contents() != header || !std::filesystem::is_directory(precompiled_headers_directory, error_code)) {
+		std::filesystem::remove_all(precompiled_headers_directory, error_code);
+		if (error_code) {
+			return Error { fmt::format("couldn't remove '{}': {}", precompiled_headers_directory, error_code.message()), Span { 0, 0 } };
+		}
+
+		TRY(write_file(header_path, header));
+	} else {
+		struct stat header_status;
+		struct stat precompiled_header_status;
+		if (::stat(header_path.c_str(), &header_status) == 0 && ::stat(precompiled_header_path.c_str(), &precompiled_header_status) == 0 && is_newer_or_as_new(precompiled_header_status, header_status)) {
+			return {};
+		}
+	}
+
+	if (::mkdir(precompiled_headers_directory.c_str(), 0777) < 0 && errno != EEXIST) {
+		return system_error("create directory", precompiled_headers_directory);
+	}
+
+	std::vector<std::string> arguments { compiler };
+	arguments.insert(arguments.end(), flags.begin(), flags.end());
+	arguments.insert(arguments.end(), { "-x", "c++-header", header_path, "-o", precompiled_header_path });
+	auto status = TRY(run_process(arguments));
+	if (status != 0) {
+		return Error { fmt::format("couldn't precompile '{}': '{}' exited with status {}", header_path, compiler, status), Span { 0, 0 } };
+	}
+
+	return {};
+}
+
+}
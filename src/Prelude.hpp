@@ -0,0 +1,31 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "Error.hpp"
+#include "utils/Result.hpp"
+
+namespace bo {
+
+// NOTE: The declarations every generated file relies on (integer aliases,
+//       literal operators, bo_range and print). They are either pasted at the
+//       top of each file or, since parsing <print> dominates the downstream
+//       compile, written once as a header that the host compiler precompiles.
+std::string_view prelude();
+
+constexpr std::string_view prelude_header_name = "bo_prelude.hpp";
+
+// NOTE: Writes prelude_header_name into `directory`, creating it if needed,
+//       and precompiles it with `compiler` into the `.gch` directory next to
+//       it, which GCC picks up for `#include "bo_prelude.hpp"` as long as
+//       `directory` is on the include path. Each compiler and set of `flags`
+//       gets its own precompiled header there, so different builds sharing
+//       `directory` don't overwrite each other's, and nothing is redone while
+//       the one for `flags` is up to date. The generated code has to be
+//       compiled with the same `flags`, otherwise the compiler silently falls
+//       back to parsing the header.
+Result<void, Error> write_precompiled_prelude(std::string const& directory, std::string const& compiler, std::span<std::string const> flags);
+
+}
@@ -0,0 +1,88 @@
+#include "SourceFile.hpp"
+
+#include "System.hpp"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace bo {
+
+Result<SourceFile, Error> SourceFile::open(std::string path) {
+	SourceFile file { std::move(path) };
+
+	auto fd = ::open(file.m_path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return system_error("open", file.m_path);
+	}
+
+	struct stat status;
+	if (::fstat(fd, &status) < 0) {
+		auto error = system_error("stat", file.m_path);
+		::close(fd);
+		return error;
+	}
+
+	// NOTE: mmap rejects empty mappings, and an empty file has nothing to map
+	//       anyway.
+	if (S_ISREG(status.st_mode) && status.st_size > 0) {
+		auto size = static_cast<std::size_t>(status.st_size);
+		auto* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping != MAP_FAILED) {
+			::close(fd);
+			// NOTE: Every stage walks the source front to back, so let the kernel
+			//       read ahead aggressively and drop pages behind us.
+			::madvise(mapping, size, MADV_SEQUENTIAL);
+			file.m_mapping = mapping;
+			file.m_mapping_size = size;
+			file.m_contents = { static_cast<char const*>(mapping), size };
+			return file;
+		}
+	}
+
+	char chunk[64 * 1024];
+	while (true) {
+		auto bytes_read = ::read(fd, chunk, sizeof(chunk));
+		if (bytes_read < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			auto error = system_error("read", file.m_path);
+			::close(fd);
+			return error;
+		}
+
+		if (bytes_read == 0) {
+			break;
+		}
+
+		file.m_buffer.append(chunk, static_cast<std::size_t>(bytes_read));
+	}
+
+	::close(fd);
+	file.m_contents = file.m_buffer;
+	return file;
+}
+
+SourceFile::SourceFile(SourceFile&& other)
+  : m_path(std::move(other.m_path)), m_contents(other.m_contents), m_mapping(std::exchange(other.m_mapping, nullptr)), m_mapping_size(std::exchange(other.m_mapping_size, 0)), m_buffer(std::move(other.m_buffer)) {
+	// NOTE: Small buffers live inside the string object, so the view has to be
+	//       rebuilt after moving.
+	if (m_mapping == nullptr) {
+		m_contents = m_buffer;
+	}
+
+	other.m_contents = {};
+}
+
+SourceFile::~SourceFile() {
+	if (m_mapping != nullptr) {
+		::munmap(m_mapping, m_mapping_size);
+	}
+}
+
+}
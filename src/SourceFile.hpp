@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "Error.hpp"
+#include "utils/Result.hpp"
+
+namespace bo {
+
+// NOTE: A source file mapped read-only into memory. Tokens and AST nodes keep
+//       string_views into contents(), so the file must outlive every stage of
+//       the compilation that reads from it. Inputs that can't be mapped (pipes,
+//       character devices, ...) are read into an owned buffer instead.
+class SourceFile {
+public:
+	static Result<SourceFile, Error> open(std::string path);
+
+	SourceFile(SourceFile const&) = delete;
+	SourceFile& operator=(SourceFile const&) = delete;
+	SourceFile(SourceFile&& other);
+	SourceFile& operator=(SourceFile&& other) = delete;
+	~SourceFile();
+
+	std::string_view path() const { return m_path; }
+	std::string_view contents() const { return m_contents; }
+	bool is_mapped() const { return m_mapping != nullptr; }
+
+private:
+	explicit SourceFile(std::string&& path)
+	  : m_path(std::move(path)) {}
+
+	std::string m_path;
+	std::string_view m_contents;
+	void* m_mapping { nullptr };
+	std::size_t m_mapping_size { 0 };
+	std::string m_buffer;
+};
+
+}
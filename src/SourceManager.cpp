@@ -0,0 +1,57 @@
+#include "SourceManager.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace bo {
+
+SourceManager::Location SourceManager::File::location(std::uint32_t position) const {
+	std::call_once(m_line_starts_flag, [this] {
+		auto source = contents();
+		m_line_starts.push_back(0);
+		for (auto newline = source.find('\n'); newline != std::string_view::npos; newline = source.find('\n', newline + 1)) {
+			m_line_starts.push_back(static_cast<std::uint32_t>(newline + 1));
+		}
+	});
+
+	auto offset = position - m_base_offset;
+	auto line = static_cast<std::size_t>(std::ranges::upper_bound(m_line_starts, offset) - m_line_starts.begin());
+	return Location { path(), line, offset - m_line_starts[line - 1] + 1 };
+}
+
+Result<SourceManager::File const*, Error> SourceManager::load(std::string path) {
+	auto file = TRY(SourceFile::open(std::move(path)));
+	// NOTE: Leaves room for the end of file position.
+	auto size = file.contents().size();
+	if (size >= std::numeric_limits<std::uint32_t>::max() - m_next_base_offset) {
+		return Error { fmt::format("'{}' doesn't fit in the source address space", file.path()), Span { 0, 0 } };
+	}
+
+	auto base_offset = m_next_base_offset;
+	m_next_base_offset += static_cast<std::uint32_t>(size) + 1;
+	m_files.push_back(std::make_unique<File>(std::move(file), base_offset));
+	return m_files.back().get();
+}
+
+SourceManager::File const* SourceManager::file_containing(std::uint32_t position) const {
+	// NOTE: Files are kept in the order of their base offsets.
+	auto it = std::ranges::upper_bound(m_files, position, {}, &File::base_offset);
+	if (it == m_files.begin() || !(*std::prev(it))->contains(position)) {
+		return nullptr;
+	}
+
+	return std::prev(it)->get();
+}
+
+std::optional<SourceManager::Location> SourceManager::resolve(std::uint32_t position) const {
+	auto const* file = file_containing(position);
+	if (file == nullptr) {
+		return {};
+	}
+
+	return file->location(position);
+}
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Error.hpp"
+#include "SourceFile.hpp"
+#include "Span.hpp"
+#include "utils/Result.hpp"
+
+namespace bo {
+
+// NOTE: Owns every source file of a compilation and lays them out one after
+//       the other in a single 32-bit address space, which is what Span
+//       positions are offsets into. Each file gets the positions from its base
+//       offset up to and including one past its last byte, where the end of
+//       file token sits. Position 0 is left out so that it can mean "nowhere".
+//       Lines and columns are only needed when reporting an error, so a file's
+//       line table is built the first time a position in it is resolved.
+class SourceManager {
+public:
+	struct Location {
+		std::string_view path;
+		// NOTE: Both start from 1, and columns count bytes.
+		std::size_t line;
+		std::size_t column;
+	};
+
+	class File {
+	public:
+		File(SourceFile&& file, std::uint32_t base_offset)
+		  : m_file(std::move(file)), m_base_offset(base_offset) {}
+
+		std::string_view path() const { return m_file.path(); }
+		std::string_view contents() const { return m_file.contents(); }
+		std::uint32_t base_offset() const { return m_base_offset; }
+		bool contains(std::uint32_t position) const { return position >= m_base_offset && position - m_base_offset <= contents().size(); }
+
+		Location location(std::uint32_t position) const;
+
+	private:
+		SourceFile m_file;
+		std::uint32_t m_base_offset;
+		mutable std::once_flag m_line_starts_flag;
+		mutable std::vector<std::uint32_t> m_line_starts;
+	};
+
+	SourceManager() = default;
+	SourceManager(SourceManager const&) = delete;
+	SourceManager& operator=(SourceManager const&) = delete;
+
+	// NOTE: The returned file stays valid for as long as the manager.
+	Result<File const*, Error> load(std::string path);
+
+	File const* file_containing(std::uint32_t position) const;
+	std::optional<Location> resolve(std::uint32_t position) const;
+
+private:
+	std::vector<std::unique_ptr<File>> m_files;
+	std::uint32_t m_next_base_offset { 1 };
+};
+
+}
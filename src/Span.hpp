@@ -1,13 +1,18 @@
 #pragma once
 
-#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <utility>
 
 namespace bo {
 
+// NOTE: A range of source positions, both ends included. Positions are offsets
+//       into a SourceManager's address space rather than into a single file,
+//       so a Span also tells which file it's in, and it's resolved to a line
+//       and a column only when it's reported.
 struct Span {
-	size_t start;
-	size_t end;
+	std::uint32_t start;
+	std::uint32_t end;
 
 	static Span merge(Span a, Span b) {
 		if (a.start > b.start) {
@@ -0,0 +1,29 @@
+#include "Symbol.hpp"
+
+#include "utils/ConcurrentInterner.hpp"
+
+#include <string>
+
+namespace bo {
+
+static ConcurrentInterner<std::string>& symbol_table() {
+	static auto* table = [] {
+		// NOTE: Never destroyed, so that symbols can still be read from other
+		//       static destructors.
+		auto* interner = new ConcurrentInterner<std::string>;
+		interner->intern("");
+		return interner;
+	}();
+
+	return *table;
+}
+
+Symbol Symbol::intern(std::string_view name) {
+	return Symbol { static_cast<std::uint32_t>(symbol_table().intern(std::string { name })) };
+}
+
+std::string_view Symbol::view() const {
+	return symbol_table().get(m_id);
+}
+
+}
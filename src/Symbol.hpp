@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace bo {
+
+// NOTE: An identifier interned into a process-wide table, so that names are
+//       compared and hashed as integers. Ids are dense and handed out in order
+//       of first appearance. The empty name is always 0, which is also what a
+//       default constructed Symbol is. The text of a symbol lives as long as
+//       the process, independently of the source it came from.
+class Symbol {
+public:
+	Symbol() = default;
+
+	// NOTE: Takes the table's lock, the Lexer keeps a cache of its own in front
+	//       of it so that each distinct name of a file only comes here once.
+	static Symbol intern(std::string_view name);
+
+	std::uint32_t id() const { return m_id; }
+	std::string_view view() const;
+
+	bool operator==(Symbol const&) const = default;
+
+private:
+	explicit Symbol(std::uint32_t id)
+	  : m_id(id) {}
+
+	std::uint32_t m_id { 0 };
+};
+
+}
+
+template<>
+struct std::hash<bo::Symbol> {
+	std::size_t operator()(bo::Symbol symbol) const { return symbol.id(); }
+};
@@ -0,0 +1,110 @@
+#include "System.hpp"
+
+#include "OutputSink.hpp"
+#include "SourceFile.hpp"
+
+#include <fmt/core.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+extern char** environ;
+
+namespace bo {
+
+Error system_error(std::string_view what, std::string_view path) {
+	return Error { fmt::format("couldn't {} '{}': {}", what, path, std::strerror(errno)), Span { 0, 0 } };
+}
+
+Result<void, Error> write_file(std::string const& path, std::string_view contents, unsigned mode) {
+	auto temporary_path = fmt::format("{}.tmp{}", path, ::getpid());
+	auto fd = ::open(temporary_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, mode);
+	if (fd < 0) {
+		return system_error("open", temporary_path);
+	}
+
+	FileDescriptorSink sink { fd };
+	auto written = sink.write(std::span { &contents, 1 });
+	auto closed = ::close(fd) == 0;
+	if (written.is_error() || !closed || ::rename(temporary_path.c_str(), path.c_str()) < 0) {
+		auto error = written.is_error() ? written.release_error() : system_error(closed ? "rename" : "write", temporary_path);
+		::unlink(temporary_path.c_str());
+		return error;
+	}
+
+	return {};
+}
+
+Result<void, Error> copy_file(std::string const& from, std::string const& to, unsigned mode) {
+	auto file = TRY(SourceFile::open(from));
+	return write_file(to, file.contents(), mode);
+}
+
+std::optional<std::string> find_program(std::string_view name) {
+	if (name.find('/') != std::string_view::npos) {
+		return std::string { name };
+	}
+
+	auto const* path = std::getenv("PATH");
+	std::string_view directories = path != nullptr ? path : "/usr/bin:/bin";
+	while (true) {
+		auto end = directories.find(':');
+		auto directory = directories.substr(0, end);
+		auto candidate = fmt::format("{}/{}", directory.empty() ? "." : directory, name);
+		if (::access(candidate.c_str(), X_OK) == 0) {
+			return candidate;
+		}
+
+		if (end == std::string_view::npos) {
+			return {};
+		}
+
+		directories.remove_prefix(end + 1);
+	}
+}
+
+std::string file_identity(std::string const& path) {
+	struct stat status;
+	if (::stat(path.c_str(), &status) < 0) {
+		return {};
+	}
+
+	return fmt::format("{}:{}:{}.{}", path, status.st_size, status.st_mtim.tv_sec, status.st_mtim.tv_nsec);
+}
+
+Result<int, Error> run_process(std::span<std::string const> arguments) {
+	std::vector<char*> argv;
+	argv.reserve(arguments.size() + 1);
+	for (auto const& argument : arguments) {
+		argv.push_back(const_cast<char*>(argument.c_str()));
+	}
+	argv.push_back(nullptr);
+
+	pid_t pid;
+	if (auto error = ::posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ); error != 0) {
+		errno = error;
+		return system_error("run", arguments[0]);
+	}
+
+	int status;
+	while (::waitpid(pid, &status, 0) < 0) {
+		if (errno != EINTR) {
+			return system_error("wait for", arguments[0]);
+		}
+	}
+
+	if (!WIFEXITED(status)) {
+		return Error { fmt::format("'{}' was terminated by signal {}", arguments[0], WTERMSIG(status)), Span { 0, 0 } };
+	}
+
+	return WEXITSTATUS(status);
+}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "Error.hpp"
+#include "utils/Result.hpp"
+
+namespace bo {
+
+// NOTE: Builds an error out of errno for a failed operation on a file.
+Error system_error(std::string_view what, std::string_view path);
+
+// NOTE: Replaces the file at `path` with one holding `contents`, creating it
+//       if needed. The new contents are written next to it and renamed into
+//       place, so readers never see a partially written file.
+Result<void, Error> write_file(std::string const& path, std::string_view contents, unsigned mode = 0666);
+
+// NOTE: Copies a file the same way write_file() writes one.
+Result<void, Error> copy_file(std::string const& from, std::string const& to, unsigned mode = 0666);
+
+// NOTE: Looks a program up in PATH like run_process() does. Names containing
+//       a slash are taken as paths.
+std::optional<std::string> find_program(std::string_view name);
+
+// NOTE: Identifies the current version of a file by its path, size and
+//       modification time, without reading it, or is empty if it can't be
+//       accessed.
+std::string file_identity(std::string const& path);
+
+// NOTE: Runs a program, looked up in PATH like a shell would, and waits for it
+//       to finish. arguments[0] is the program itself. Returns its exit
+//       status, or an error if it couldn't be started or didn't exit normally.
+Result<int, Error> run_process(std::span<std::string const> arguments);
+
+}
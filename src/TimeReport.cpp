@@ -0,0 +1,77 @@
+#include "TimeReport.hpp"
+
+#include "AllocationCounter.hpp"
+
+#include <fmt/core.h>
+
+#include <sys/resource.h>
+
+namespace bo {
+
+static TimeReport::Duration cpu_time(int who) {
+	rusage usage;
+	::getrusage(who, &usage);
+	auto to_duration = [](timeval time) { return std::chrono::seconds { time.tv_sec } + std::chrono::microseconds { time.tv_usec }; };
+	return to_duration(usage.ru_utime) + to_duration(usage.ru_stime);
+}
+
+TimeReport::Snapshot TimeReport::take_snapshot() {
+	auto allocations = AllocationCounter::totals();
+	return {
+		std::chrono::steady_clock::now(),
+		// NOTE: Includes the children that were waited for, i.e. the C++ compiler.
+		cpu_time(RUSAGE_SELF) + cpu_time(RUSAGE_CHILDREN),
+		allocations.allocations,
+		allocations.bytes,
+	};
+}
+
+void TimeReport::start(std::string_view name) {
+	stop();
+	m_current_name = name;
+	m_current_start = take_snapshot();
+	m_is_running = true;
+}
+
+void TimeReport::stop() {
+	if (!m_is_running) {
+		return;
+	}
+
+	auto end = take_snapshot();
+	rusage usage;
+	::getrusage(RUSAGE_SELF, &usage);
+	m_stages.push_back({
+		m_current_name,
+		end.wall_time - m_current_start.wall_time,
+		end.cpu_time - m_current_start.cpu_time,
+		end.allocations - m_current_start.allocations,
+		end.allocated_bytes - m_current_start.allocated_bytes,
+		// NOTE: ru_maxrss is in kilobytes on Linux.
+		static_cast<std::size_t>(usage.ru_maxrss) * 1024,
+	});
+	m_is_running = false;
+}
+
+void TimeReport::print(std::FILE* file) const {
+	constexpr double mebibyte = 1024.0 * 1024.0;
+
+	fmt::print(file, "{:<24} {:>12} {:>12} {:>12} {:>12} {:>15}\n", "stage", "wall (ms)", "cpu (ms)", "allocations", "alloc (MiB)", "peak RSS (MiB)");
+	Stage total { "total", {}, {}, 0, 0, 0 };
+	for (auto const& stage : m_stages) {
+		fmt::print(file, "{:<24} {:>12.3f} {:>12.3f} {:>12} {:>12.3f} {:>15.3f}\n", stage.name, stage.wall_time.count(), stage.cpu_time.count(), stage.allocations, static_cast<double>(stage.allocated_bytes) / mebibyte, static_cast<double>(stage.peak_rss_bytes) / mebibyte);
+		total.wall_time += stage.wall_time;
+		total.cpu_time += stage.cpu_time;
+		total.allocations += stage.allocations;
+		total.allocated_bytes += stage.allocated_bytes;
+		total.peak_rss_bytes = std::max(total.peak_rss_bytes, stage.peak_rss_bytes);
+	}
+
+	fmt::print(file, "{:<24} {:>12.3f} {:>12.3f} {:>12} {:>12.3f} {:>15.3f}\n", total.name, total.wall_time.count(), total.cpu_time.count(), total.allocations, static_cast<double>(total.allocated_bytes) / mebibyte, static_cast<double>(total.peak_rss_bytes) / mebibyte);
+
+	for (auto const& count : m_counts) {
+		fmt::print(file, "{:<24} {:>12}\n", count.name, count.value);
+	}
+}
+
+}
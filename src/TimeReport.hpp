@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+namespace bo {
+
+// NOTE: Records what each stage of a compilation cost. Starting a stage ends
+//       the one before it. CPU time covers every thread of the process and the
+//       programs it ran, so a parallel stage can report more CPU than wall
+//       time. The allocation figures are only collected once AllocationCounter
+//       is enabled, and the peak RSS is boc's own high-water mark as of the end
+//       of the stage.
+class TimeReport {
+public:
+	using Duration = std::chrono::duration<double, std::milli>;
+
+	struct Stage {
+		std::string_view name;
+		Duration wall_time;
+		Duration cpu_time;
+		std::size_t allocations;
+		std::size_t allocated_bytes;
+		std::size_t peak_rss_bytes;
+	};
+
+	struct Count {
+		std::string_view name;
+		std::size_t value;
+	};
+
+	void start(std::string_view name);
+	void stop();
+
+	// NOTE: Sizes of what the stages produced, e.g. node counts.
+	void add_count(std::string_view name, std::size_t value) { m_counts.push_back({ name, value }); }
+
+	std::vector<Stage> const& stages() const { return m_stages; }
+	std::vector<Count> const& counts() const { return m_counts; }
+
+	void print(std::FILE*) const;
+
+private:
+	struct Snapshot {
+		std::chrono::steady_clock::time_point wall_time;
+		Duration cpu_time;
+		std::size_t allocations;
+		std::size_t allocated_bytes;
+	};
+
+	static Snapshot take_snapshot();
+
+	std::vector<Stage> m_stages;
+	std::vector<Count> m_counts;
+	std::string_view m_current_name;
+	Snapshot m_current_start;
+	bool m_is_running { false };
+};
+
+}
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <string_view>
 
 #include "Span.hpp"
+#include "Symbol.hpp"
 
 using namespace std::literals;
 
@@ -33,80 +35,82 @@ using namespace std::literals;
 	BO_ENUMERATE_KEYWORD(var)    \
 	BO_ENUMERATE_KEYWORD(void)
 
-#define _BO_ENUMERATE_TOKENS                \
-	_BO_ENUMERATE_KEYWORDS                    \
-	BO_ENUMERATE_TOKEN(Ampersand)             \
-	BO_ENUMERATE_TOKEN(AmpersandEquals)       \
-	BO_ENUMERATE_TOKEN(Asterisk)              \
-	BO_ENUMERATE_TOKEN(AsteriskEquals)        \
-	BO_ENUMERATE_TOKEN(At)                    \
-	BO_ENUMERATE_TOKEN(BinaryLiteral)         \
-	BO_ENUMERATE_TOKEN(CharLiteral)           \
-	BO_ENUMERATE_TOKEN(Circumflex)            \
-	BO_ENUMERATE_TOKEN(CircumflexEquals)      \
-	BO_ENUMERATE_TOKEN(Colon)                 \
-	BO_ENUMERATE_TOKEN(Comma)                 \
-	BO_ENUMERATE_TOKEN(DecimalLiteral)        \
-	BO_ENUMERATE_TOKEN(DotDotEquals)          \
-	BO_ENUMERATE_TOKEN(DotDotLessThan)        \
-	BO_ENUMERATE_TOKEN(DoubleAmpersand)       \
-	BO_ENUMERATE_TOKEN(DoubleAmpersandEquals) \
-	BO_ENUMERATE_TOKEN(DoubleEquals)          \
-	BO_ENUMERATE_TOKEN(DoublePipe)            \
-	BO_ENUMERATE_TOKEN(DoublePipeEquals)      \
-	BO_ENUMERATE_TOKEN(EndOfFile)             \
-	BO_ENUMERATE_TOKEN(Equals)                \
-	BO_ENUMERATE_TOKEN(ExclamationMark)       \
-	BO_ENUMERATE_TOKEN(ExclamationMarkEquals) \
-	BO_ENUMERATE_TOKEN(GreaterThan)           \
-	BO_ENUMERATE_TOKEN(GreaterThanEquals)     \
-	BO_ENUMERATE_TOKEN(HexadecimalLiteral)    \
-	BO_ENUMERATE_TOKEN(Identifier)            \
-	BO_ENUMERATE_TOKEN(LeftCurlyBracket)      \
-	BO_ENUMERATE_TOKEN(LeftParenthesis)       \
-	BO_ENUMERATE_TOKEN(LeftShift)             \
-	BO_ENUMERATE_TOKEN(LeftShiftEquals)       \
-	BO_ENUMERATE_TOKEN(LeftSquareBracket)     \
-	BO_ENUMERATE_TOKEN(LessThan)              \
-	BO_ENUMERATE_TOKEN(LessThanEquals)        \
-	BO_ENUMERATE_TOKEN(Minus)                 \
-	BO_ENUMERATE_TOKEN(MinusEquals)           \
-	BO_ENUMERATE_TOKEN(MinusMinus)            \
-	BO_ENUMERATE_TOKEN(OctalLiteral)          \
-	BO_ENUMERATE_TOKEN(Percent)               \
-	BO_ENUMERATE_TOKEN(PercentEquals)         \
-	BO_ENUMERATE_TOKEN(Pipe)                  \
-	BO_ENUMERATE_TOKEN(PipeEquals)            \
-	BO_ENUMERATE_TOKEN(Plus)                  \
-	BO_ENUMERATE_TOKEN(PlusEquals)            \
-	BO_ENUMERATE_TOKEN(PlusPlus)              \
-	BO_ENUMERATE_TOKEN(RightCurlyBracket)     \
-	BO_ENUMERATE_TOKEN(RightParenthesis)      \
-	BO_ENUMERATE_TOKEN(RightShift)            \
-	BO_ENUMERATE_TOKEN(RightShiftEquals)      \
-	BO_ENUMERATE_TOKEN(RightSquareBracket)    \
-	BO_ENUMERATE_TOKEN(Semicolon)             \
-	BO_ENUMERATE_TOKEN(Solidus)               \
-	BO_ENUMERATE_TOKEN(SolidusEquals)         \
-	BO_ENUMERATE_TOKEN(Tilde)
+#define _BO_ENUMERATE_TOKENS                          \
+	_BO_ENUMERATE_KEYWORDS                              \
+	BO_ENUMERATE_OPERATOR(Ampersand, "&")               \
+	BO_ENUMERATE_OPERATOR(AmpersandEquals, "&=")        \
+	BO_ENUMERATE_OPERATOR(Asterisk, "*")                \
+	BO_ENUMERATE_OPERATOR(AsteriskEquals, "*=")         \
+	BO_ENUMERATE_OPERATOR(At, "@")                      \
+	BO_ENUMERATE_TOKEN(BinaryLiteral)                   \
+	BO_ENUMERATE_TOKEN(CharLiteral)                     \
+	BO_ENUMERATE_OPERATOR(Circumflex, "^")              \
+	BO_ENUMERATE_OPERATOR(CircumflexEquals, "^=")       \
+	BO_ENUMERATE_OPERATOR(Colon, ":")                   \
+	BO_ENUMERATE_OPERATOR(Comma, ",")                   \
+	BO_ENUMERATE_TOKEN(DecimalLiteral)                  \
+	BO_ENUMERATE_OPERATOR(DotDotEquals, "..=")          \
+	BO_ENUMERATE_OPERATOR(DotDotLessThan, "..<")        \
+	BO_ENUMERATE_OPERATOR(DoubleAmpersand, "&&")        \
+	BO_ENUMERATE_OPERATOR(DoubleAmpersandEquals, "&&=") \
+	BO_ENUMERATE_OPERATOR(DoubleEquals, "==")           \
+	BO_ENUMERATE_OPERATOR(DoublePipe, "||")             \
+	BO_ENUMERATE_OPERATOR(DoublePipeEquals, "||=")      \
+	BO_ENUMERATE_TOKEN(EndOfFile)                       \
+	BO_ENUMERATE_OPERATOR(Equals, "=")                  \
+	BO_ENUMERATE_OPERATOR(ExclamationMark, "!")         \
+	BO_ENUMERATE_OPERATOR(ExclamationMarkEquals, "!=")  \
+	BO_ENUMERATE_OPERATOR(GreaterThan, ">")             \
+	BO_ENUMERATE_OPERATOR(GreaterThanEquals, ">=")      \
+	BO_ENUMERATE_TOKEN(HexadecimalLiteral)              \
+	BO_ENUMERATE_TOKEN(Identifier)                      \
+	BO_ENUMERATE_OPERATOR(LeftCurlyBracket, "{")        \
+	BO_ENUMERATE_OPERATOR(LeftParenthesis, "(")         \
+	BO_ENUMERATE_OPERATOR(LeftShift, "<<")              \
+	BO_ENUMERATE_OPERATOR(LeftShiftEquals, "<<=")       \
+	BO_ENUMERATE_OPERATOR(LeftSquareBracket, "[")       \
+	BO_ENUMERATE_OPERATOR(LessThan, "<")                \
+	BO_ENUMERATE_OPERATOR(LessThanEquals, "<=")         \
+	BO_ENUMERATE_OPERATOR(Minus, "-")                   \
+	BO_ENUMERATE_OPERATOR(MinusEquals, "-=")            \
+	BO_ENUMERATE_OPERATOR(MinusMinus, "--")             \
+	BO_ENUMERATE_TOKEN(OctalLiteral)                    \
+	BO_ENUMERATE_OPERATOR(Percent, "%")                 \
+	BO_ENUMERATE_OPERATOR(PercentEquals, "%=")          \
+	BO_ENUMERATE_OPERATOR(Pipe, "|")                    \
+	BO_ENUMERATE_OPERATOR(PipeEquals, "|=")             \
+	BO_ENUMERATE_OPERATOR(Plus, "+")                    \
+	BO_ENUMERATE_OPERATOR(PlusEquals, "+=")             \
+	BO_ENUMERATE_OPERATOR(PlusPlus, "++")               \
+	BO_ENUMERATE_OPERATOR(RightCurlyBracket, "}")       \
+	BO_ENUMERATE_OPERATOR(RightParenthesis, ")")        \
+	BO_ENUMERATE_OPERATOR(RightShift, ">>")             \
+	BO_ENUMERATE_OPERATOR(RightShiftEquals, ">>=")      \
+	BO_ENUMERATE_OPERATOR(RightSquareBracket, "]")      \
+	BO_ENUMERATE_OPERATOR(Semicolon, ";")               \
+	BO_ENUMERATE_OPERATOR(Solidus, "/")                 \
+	BO_ENUMERATE_OPERATOR(SolidusEquals, "/=")          \
+	BO_ENUMERATE_OPERATOR(Tilde, "~")
 
 namespace bo {
 
 class Token {
 public:
-	enum class Type {
+	enum class Type : std::uint8_t {
 #define BO_ENUMERATE_KEYWORD(x) BO_ENUMERATE_TOKEN(KW_##x)
+#define BO_ENUMERATE_OPERATOR(x, y) BO_ENUMERATE_TOKEN(x)
 #define BO_ENUMERATE_TOKEN(x) x,
 		_BO_ENUMERATE_TOKENS
 #undef BO_ENUMERATE_TOKEN
+#undef BO_ENUMERATE_OPERATOR
 #undef BO_ENUMERATE_KEYWORD
 		  __COUNT
 	};
 
 	static constexpr std::size_t count() { return static_cast<std::size_t>(Token::Type::__COUNT); }
 
-	explicit Token(Type type, std::string_view value, Span span)
-	  : m_type(type), m_value(value), m_span(span) {}
+	explicit Token(Type type, std::string_view value, Span span, Symbol symbol = {})
+	  : m_type(type), m_value(value), m_span(span), m_symbol(symbol) {}
 
 	inline bool is_keyword() const {
 		switch (m_type) {
@@ -144,11 +148,14 @@ public:
 	Type type() const { return m_type; }
 	std::string_view value() const { return m_value; }
 	Span span() const { return m_span; }
+	// NOTE: The interned value of identifiers and keywords.
+	Symbol symbol() const { return m_symbol; }
 
 private:
 	Type m_type;
 	std::string_view m_value;
 	Span m_span;
+	Symbol m_symbol;
 };
 
 auto format_as(Token::Type) -> std::string;
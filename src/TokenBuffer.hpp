@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Span.hpp"
+#include "Token.hpp"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace bo {
+
+// NOTE: The whole token stream of a source, stored as parallel arrays so that
+//       the Parser can walk (and look ahead in) it by index. Values are not
+//       stored: they are slices of the source, rebuilt from start and length.
+class TokenBuffer {
+public:
+	explicit TokenBuffer(std::string_view source, std::uint32_t base_offset)
+	  : m_source(source), m_base_offset(base_offset) {}
+
+	void reserve(std::size_t count) {
+		m_types.reserve(count);
+		m_starts.reserve(count);
+		m_lengths.reserve(count);
+		m_symbols.reserve(count);
+	}
+
+	void append(Token const& token) {
+		m_types.push_back(token.type());
+		m_starts.push_back(token.span().start);
+		m_lengths.push_back(static_cast<std::uint32_t>(token.value().size()));
+		m_symbols.push_back(token.symbol());
+	}
+
+	std::size_t size() const { return m_types.size(); }
+
+	Token::Type type(std::size_t index) const { return m_types[index]; }
+
+	std::string_view value(std::size_t index) const {
+		// NOTE: The end of file token starts past the end of the source.
+		return m_lengths[index] != 0 ? m_source.substr(m_starts[index] - m_base_offset, m_lengths[index]) : ""sv;
+	}
+
+	Span span(std::size_t index) const {
+		auto start = m_starts[index];
+		auto length = m_lengths[index];
+		return Span { start, length != 0 ? start + length - 1 : start };
+	}
+
+	Token token(std::size_t index) const { return Token { type(index), value(index), span(index), m_symbols[index] }; }
+
+private:
+	std::string_view m_source;
+	std::uint32_t m_base_offset;
+	std::vector<Token::Type> m_types;
+	std::vector<std::uint32_t> m_starts;
+	std::vector<std::uint32_t> m_lengths;
+	std::vector<Symbol> m_symbols;
+};
+
+}
@@ -0,0 +1,122 @@
+#include "Tracer.hpp"
+
+#include "System.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <unistd.h>
+#include <vector>
+
+namespace bo {
+
+namespace {
+
+struct Event {
+	std::uint64_t start;
+	std::uint64_t duration;
+	char const* category;
+	std::uint8_t name_size;
+	char name[39];
+};
+
+// NOTE: Grows on demand up to its capacity and then wraps around, so that an
+//       idle worker thread doesn't cost a full buffer.
+struct ThreadBuffer {
+	static constexpr std::size_t capacity = 64 * 1024;
+
+	std::vector<Event> events;
+	std::size_t next { 0 };
+	std::size_t dropped { 0 };
+	std::uint32_t thread_id;
+};
+
+std::mutex s_buffers_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+thread_local ThreadBuffer* t_buffer { nullptr };
+
+ThreadBuffer& thread_buffer() {
+	if (t_buffer == nullptr) [[unlikely]] {
+		std::scoped_lock lock { s_buffers_mutex };
+		s_buffers.push_back(std::make_unique<ThreadBuffer>());
+		t_buffer = s_buffers.back().get();
+		t_buffer->thread_id = static_cast<std::uint32_t>(s_buffers.size());
+	}
+
+	return *t_buffer;
+}
+
+}
+
+std::uint64_t Tracer::now() {
+	static auto const epoch = std::chrono::steady_clock::now();
+	// NOTE: Offset by one so that no event starts at 0, which TraceScope uses
+	//       to mean "not recording".
+	return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count()) + 1;
+}
+
+void Tracer::record(char const* category, std::string_view name, std::uint64_t start, std::uint64_t end) {
+	Event event;
+	event.start = start;
+	event.duration = end - start;
+	event.category = category;
+	event.name_size = static_cast<std::uint8_t>(std::min(name.size(), sizeof(event.name)));
+	std::memcpy(event.name, name.data(), event.name_size);
+
+	auto& buffer = thread_buffer();
+	if (buffer.events.size() < ThreadBuffer::capacity) {
+		buffer.events.push_back(event);
+		return;
+	}
+
+	buffer.events[buffer.next] = event;
+	buffer.next = (buffer.next + 1) % ThreadBuffer::capacity;
+	++buffer.dropped;
+}
+
+static void append_json_string(std::string& json, std::string_view string) {
+	json += '"';
+	for (auto c : string) {
+		if (c == '"' || c == '\\') {
+			json += '\\';
+			json += c;
+		} else if (static_cast<unsigned char>(c) < 0x20) {
+			fmt::format_to(std::back_inserter(json), "\\u{:04x}", c);
+		} else {
+			json += c;
+		}
+	}
+	json += '"';
+}
+
+Result<void, Error> Tracer::write(std::string const& path) {
+	std::scoped_lock lock { s_buffers_mutex };
+
+	auto pid = ::getpid();
+	std::size_t dropped = 0;
+	std::string json = "{\"traceEvents\":[\n";
+	bool is_first = true;
+	for (auto const& buffer : s_buffers) {
+		dropped += buffer->dropped;
+		for (auto const& event : buffer->events) {
+			json += is_first ? "" : ",\n";
+			is_first = false;
+			json += "{\"name\":";
+			append_json_string(json, { event.name, event.name_size });
+			json += ",\"cat\":";
+			append_json_string(json, event.category);
+			// NOTE: Timestamps are in microseconds.
+			fmt::format_to(std::back_inserter(json), ",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":{},\"tid\":{}}}", static_cast<double>(event.start) / 1000.0, static_cast<double>(event.duration) / 1000.0, pid, buffer->thread_id);
+		}
+	}
+
+	fmt::format_to(std::back_inserter(json), "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{{\"droppedEvents\":{}}}}}\n", dropped);
+	return write_file(path, json);
+}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "Error.hpp"
+#include "utils/Result.hpp"
+
+namespace bo {
+
+// NOTE: Records scoped events in Chrome's Trace Event Format, to be loaded into
+//       chrome://tracing or Perfetto. Every thread appends to its own ring
+//       buffer, so recording never takes a lock after a thread's first event,
+//       and when tracing is off a TraceScope costs a single relaxed load. Once
+//       a buffer is full its oldest events are overwritten.
+class Tracer {
+public:
+	static void enable() { s_is_enabled.store(true, std::memory_order_relaxed); }
+	static bool is_enabled() { return s_is_enabled.load(std::memory_order_relaxed); }
+
+	// NOTE: Nanoseconds on a monotonic clock.
+	static std::uint64_t now();
+
+	// NOTE: The category must be a string literal, the name is copied (and
+	//       truncated if it's very long).
+	static void record(char const* category, std::string_view name, std::uint64_t start, std::uint64_t end);
+
+	// NOTE: Must only be called once every traced thread is done, e.g. at the
+	//       end of the compilation.
+	static Result<void, Error> write(std::string const& path);
+
+private:
+	static inline std::atomic<bool> s_is_enabled { false };
+};
+
+class TraceScope {
+public:
+	explicit TraceScope(char const* category, std::string_view name = {})
+	  : m_category(category), m_name(name), m_start(Tracer::is_enabled() ? Tracer::now() : 0) {}
+
+	TraceScope(TraceScope const&) = delete;
+	TraceScope& operator=(TraceScope const&) = delete;
+
+	~TraceScope() {
+		if (m_start != 0) {
+			Tracer::record(m_category, m_name, m_start, Tracer::now());
+		}
+	}
+
+	// NOTE: For scopes whose name is only known partway through, like the
+	//       parsing of a function declaration.
+	void set_name(std::string_view name) { m_name = name; }
+
+private:
+	char const* m_category;
+	std::string_view m_name;
+	std::uint64_t m_start;
+};
+
+}
@@ -1,91 +1,148 @@
 #include "Transpiler.hpp"
 
+#include "Prelude.hpp"
+#include "Tracer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <utility>
+
 namespace bo {
 
 Result<std::string, Error> Transpiler::transpile() {
+	std::string code;
+	StringSink sink { code };
+	TRY(transpile(sink));
+	return code;
+}
+
+Result<void, Error> Transpiler::transpile(OutputSink& sink) {
+	TraceScope trace { "transpile", "program" };
+	std::vector<CheckedAST::Function const*> functions;
+	std::ranges::copy_if(m_program.functions(), std::back_inserter(functions), [](auto function) { return !function->is_builtin(); });
+
+	// NOTE: Functions are emitted in parallel, each into its worker's buffer,
+	//       and then appended to m_code in declaration order, so the output is
+	//       the same as a single pass: the indent level and the temporary
+	//       counter are back to zero at the end of each function. A function
+	//       that finishes before the ones preceding it is parked until they are
+	//       done, and whenever m_code fills up a chunk it's handed to the sink,
+	//       so memory stays bounded by the functions in flight rather than by
+	//       the whole module.
+	// NOTE: Since the output is streamed, whatever precedes a function that
+	//       fails to transpile has already been written when the error is
+	//       returned.
+	struct FinishedFunction {
+		OutputBuffer code;
+		std::optional<Error> error;
+	};
+
+	auto function_count = functions.size();
+	std::vector<std::optional<FinishedFunction>> parked_functions(function_count);
+	std::atomic<std::size_t> first_failed_function { function_count };
+	std::mutex output_mutex;
+	std::size_t next_function = 0;
+	std::optional<Error> error;
+
+	m_code.clear();
 	add_prelude();
-	for (auto function : m_program.functions()) {
-		if (!function->is_builtin()) {
-			TRY(transpile_function(function));
+
+	// NOTE: Must be called with output_mutex held.
+	auto flush_finished_functions = [&]() -> Result<void, Error> {
+		for (; next_function < function_count && parked_functions[next_function]; ++next_function) {
+			auto& function = *parked_functions[next_function];
+			if (function.error) {
+				return std::move(*function.error);
+			}
+
+			m_code.append(function.code);
+			parked_functions[next_function].reset();
+			TRY(m_code.flush_full_chunks(sink));
+		}
+
+		return {};
+	};
+
+	constexpr std::size_t minimum_functions_per_worker = 16;
+	auto worker_count = std::clamp<std::size_t>(function_count / minimum_functions_per_worker, 1, m_thread_count);
+	std::vector<Transpiler> workers;
+	workers.reserve(worker_count);
+	for (std::size_t i = 0; i < worker_count; ++i) {
+		workers.emplace_back(m_program, 1);
+	}
+
+	parallel_for(function_count, worker_count, [&](std::size_t worker, std::size_t i) {
+		if (i > first_failed_function.load(std::memory_order_relaxed)) {
+			return;
 		}
+
+		auto& transpiler = workers[worker];
+		transpiler.m_code.clear();
+		auto result = transpiler.transpile_function(functions[i]);
+
+		std::scoped_lock lock { output_mutex };
+		if (error) {
+			return;
+		}
+
+		if (result.is_error()) {
+			parked_functions[i] = FinishedFunction { OutputBuffer {}, result.release_error() };
+			auto first_failed = first_failed_function.load(std::memory_order_relaxed);
+			while (i < first_failed && !first_failed_function.compare_exchange_weak(first_failed, i, std::memory_order_relaxed)) {}
+		} else if (i == next_function) {
+			// NOTE: This is the common case, which doesn't need to park a copy.
+			m_code.append(transpiler.m_code);
+			++next_function;
+			if (auto flushed = m_code.flush_full_chunks(sink); flushed.is_error()) {
+				error = flushed.release_error();
+				first_failed_function.store(0, std::memory_order_relaxed);
+				return;
+			}
+		} else {
+			parked_functions[i] = FinishedFunction { std::exchange(transpiler.m_code, OutputBuffer {}), {} };
+		}
+
+		if (auto flushed = flush_finished_functions(); flushed.is_error()) {
+			error = flushed.release_error();
+			first_failed_function.store(0, std::memory_order_relaxed);
+		}
+	});
+
+	if (error) {
+		return std::move(*error);
 	}
 
-	return m_code.str();
+	return m_code.flush(sink);
 }
 
 void Transpiler::add_new_line() {
-	m_code << "\n";
-	for (int i = 0; i < m_indent_level; ++i) {
-		m_code << "    ";
+	// NOTE: The newline and the indentation are appended as a single slice of
+	//       this string, so deep nesting doesn't cost a call per level.
+	static constexpr std::string_view new_line_and_indentation = "\n                                                                ";
+	constexpr std::size_t indentation_width = 4;
+	constexpr std::size_t max_indent_level = (new_line_and_indentation.size() - 1) / indentation_width;
+
+	auto remaining_levels = static_cast<std::size_t>(m_indent_level);
+	auto levels = std::min(remaining_levels, max_indent_level);
+	m_code << new_line_and_indentation.substr(0, 1 + levels * indentation_width);
+	for (remaining_levels -= levels; remaining_levels > 0; remaining_levels -= levels) {
+		levels = std::min(remaining_levels, max_indent_level);
+		m_code << new_line_and_indentation.substr(1, levels * indentation_width);
 	}
 }
 
 void Transpiler::add_prelude() {
 	// FIXME: Add suffixes, arguments array to main
-	m_code << R"(#include <cstdint>
-#include <array>
-#include <span>
-#include <print>
-
-using u8 = std::uint8_t;
-using u16 = std::uint16_t;
-using u32 = std::uint32_t;
-using u64 = std::uint64_t;
-using usize = std::uint64_t;
-using i8 = std::int8_t;
-using i16 = std::int16_t;
-using i32 = std::int32_t;
-using i64 = std::int64_t;
-using isize = std::int64_t;
-
-u8 operator""_u8(unsigned long long value) { return static_cast<u8>(value); }
-u16 operator""_u16(unsigned long long value) { return static_cast<u16>(value); }
-u32 operator""_u32(unsigned long long value) { return static_cast<u32>(value); }
-u64 operator""_u64(unsigned long long value) { return static_cast<u64>(value); }
-usize operator""_usize(unsigned long long value) { return static_cast<usize>(value); }
-i8 operator""_i8(unsigned long long value) { return static_cast<i8>(value); }
-i16 operator""_i16(unsigned long long value) { return static_cast<i16>(value); }
-i32 operator""_i32(unsigned long long value) { return static_cast<i32>(value); }
-i64 operator""_i64(unsigned long long value) { return static_cast<i64>(value); }
-isize operator""_isize(unsigned long long value) { return static_cast<isize>(value); }
-
-template<typename ElementType, bool is_inclusive>
-class bo_range {
-public:
-    struct iterator {
-        ElementType value;
-        constexpr iterator(ElementType value_):
-            value(value_) {}
-
-        constexpr ElementType operator*() { return value; }
-        constexpr bool operator==(iterator const& other) { return value == other.value; }
-        constexpr bool operator!=(iterator const& other) { return !(*this == other); }
-        constexpr void operator++() { ++value; }
-    };
-
-    constexpr bo_range(ElementType start, ElementType end):
-        m_start(start), m_end(end) {}
-
-    constexpr iterator begin() { return m_start; }
-    constexpr iterator end() {
-        if constexpr (is_inclusive) {
-            return m_end + 1;
-        } else {
-            return m_end;
-        }
-    }
-
-private:
-    ElementType m_start;
-    ElementType m_end;
-};
-
-template<typename T>
-void print(T value) {
-	std::print("{}", value);
-}
-
-void bo_main();
+	if (m_prelude_mode == PreludeMode::Include) {
+		m_code << "#include \"" << prelude_header_name << "\"\n\n";
+	} else {
+		m_code << prelude();
+	}
+
+	m_code << R"(void bo_main();
 int main(int argc, char** argv) {
     (void) argc;
     (void) argv;
@@ -278,40 +335,47 @@ void Transpiler::transpile_update_operator(AST::UpdateOperator op) {
 	}
 }
 
-Result<void, Error> Transpiler::transpile_statement(std::shared_ptr<CheckedAST::Statement const> statement) {
-	if (statement->is_expression_statement()) {
-		auto expression_statement = std::static_pointer_cast<CheckedAST::ExpressionStatement const>(statement);
-		TRY(transpile_expression(expression_statement->expression()));
-		m_code << ";";
-		return {};
-	}
-
-	if (statement->is_variable_declaration()) {
-		auto variable_declaration_statement = std::static_pointer_cast<CheckedAST::VariableDeclarationStatement const>(statement);
-		TRY(transpile_variable_declaration_statement(variable_declaration_statement));
-		return {};
-	}
-
-	if (statement->is_for_statement()) {
-		auto for_statement = std::static_pointer_cast<CheckedAST::ForStatement const>(statement);
-		TRY(transpile_for_statement(for_statement));
-		return {};
-	}
-
-	if (statement->is_return_statement()) {
-		auto return_statement = std::static_pointer_cast<CheckedAST::ReturnStatement const>(statement);
-		TRY(transpile_return_statement(return_statement));
-		return {};
+Result<void, Error> Transpiler::transpile_statement(CheckedAST::Statement const* statement) {
+	switch (statement->kind()) {
+	case CheckedAST::Kind::ExpressionStatement:
+		{
+			auto expression_statement = static_cast<CheckedAST::ExpressionStatement const*>(statement);
+			TRY(transpile_expression(expression_statement->expression()));
+			m_code << ";";
+			return {};
+		}
+	case CheckedAST::Kind::VariableDeclarationStatement:
+		{
+			auto variable_declaration_statement = static_cast<CheckedAST::VariableDeclarationStatement const*>(statement);
+			TRY(transpile_variable_declaration_statement(variable_declaration_statement));
+			return {};
+		}
+	case CheckedAST::Kind::InfiniteForStatement:
+	case CheckedAST::Kind::ForWithConditionStatement:
+	case CheckedAST::Kind::ForWithRangeStatement:
+		{
+			auto for_statement = static_cast<CheckedAST::ForStatement const*>(statement);
+			TRY(transpile_for_statement(for_statement));
+			return {};
+		}
+	case CheckedAST::Kind::ReturnStatement:
+		{
+			auto return_statement = static_cast<CheckedAST::ReturnStatement const*>(statement);
+			TRY(transpile_return_statement(return_statement));
+			return {};
+		}
+	default:
+		break;
 	}
 
 	assert(false && "Statement not handled");
 }
 
-Result<void, Error> Transpiler::transpile_variable_declaration_statement(std::shared_ptr<CheckedAST::VariableDeclarationStatement const> variable_declaration_statement) {
+Result<void, Error> Transpiler::transpile_variable_declaration_statement(CheckedAST::VariableDeclarationStatement const* variable_declaration_statement) {
 	auto const& variable = m_program.get_variable(variable_declaration_statement->variable_id());
 	TRY(transpile_type(variable.type_id));
 	m_code << " ";
-	m_code << variable.name;
+	m_code << variable.name.view();
 	if (variable_declaration_statement->initializer()) {
 		m_code << " = ";
 		TRY(transpile_expression(variable_declaration_statement->initializer()));
@@ -320,8 +384,9 @@ Result<void, Error> Transpiler::transpile_variable_declaration_statement(std::sh
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_function(std::shared_ptr<CheckedAST::Function const> function) {
-	if (function->name() == "main") {
+Result<void, Error> Transpiler::transpile_function(CheckedAST::Function const* function) {
+	TraceScope trace { "transpile", function->name().view() };
+	if (function->name().view() == "main") {
 		if (!m_program.get_type(function->return_type_id()).is<Types::Void>() && !function->parameters().empty()) {
 			return Error { "Main function must have no parameters and return void", {} };
 		}
@@ -335,13 +400,13 @@ Result<void, Error> Transpiler::transpile_function(std::shared_ptr<CheckedAST::F
 
 	TRY(transpile_type(function->return_type_id(), IgnoreFirstQualifier::Yes));
 	m_code << " ";
-	m_code << function->name();
+	m_code << function->name().view();
 	m_code << "(";
 	for (std::size_t i = 0; i < function->parameters().size(); ++i) {
 		auto const& parameter = function->parameters()[i];
 		TRY(transpile_type(parameter.variable.type_id));
 		m_code << " ";
-		m_code << parameter.variable.name;
+		m_code << parameter.variable.name.view();
 
 		if (i < function->parameters().size() - 1) {
 			m_code << ", ";
@@ -354,40 +419,50 @@ Result<void, Error> Transpiler::transpile_function(std::shared_ptr<CheckedAST::F
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_for_statement(std::shared_ptr<CheckedAST::ForStatement const> for_statement) {
-	if (for_statement->is_infinite()) {
-		auto infinite_for_statement = std::static_pointer_cast<CheckedAST::InfiniteForStatement const>(for_statement);
-		m_code << "for (;;)";
-		add_new_line();
-		TRY(transpile_block_expression(infinite_for_statement->body(), LastBlockStatementTreatment::Ignore));
-	} else if (for_statement->is_with_condition()) {
-		auto for_with_condition_statement = std::static_pointer_cast<CheckedAST::ForWithConditionStatement const>(for_statement);
-		m_code << "for (;";
-		TRY(transpile_expression(for_with_condition_statement->condition()));
-		m_code << ";)";
-		add_new_line();
-		TRY(transpile_block_expression(for_with_condition_statement->body(), LastBlockStatementTreatment::Ignore));
-	} else if (for_statement->is_with_range()) {
-		auto for_with_range_statement = std::static_pointer_cast<CheckedAST::ForWithRangeStatement const>(for_statement);
-		auto const& range_variable = m_program.get_variable(for_with_range_statement->range_variable_id());
-
-		m_code << "for (";
-		TRY(transpile_type(range_variable.type_id));
-		m_code << " ";
-		m_code << range_variable.name;
-		m_code << " : ";
-		TRY(transpile_expression(for_with_range_statement->range_expression()));
-		m_code << ")";
-		add_new_line();
-		TRY(transpile_block_expression(for_with_range_statement->body(), LastBlockStatementTreatment::Ignore));
-	} else {
+Result<void, Error> Transpiler::transpile_for_statement(CheckedAST::ForStatement const* for_statement) {
+	switch (for_statement->kind()) {
+	case CheckedAST::Kind::InfiniteForStatement:
+		{
+			auto infinite_for_statement = static_cast<CheckedAST::InfiniteForStatement const*>(for_statement);
+			m_code << "for (;;)";
+			add_new_line();
+			TRY(transpile_block_expression(infinite_for_statement->body(), LastBlockStatementTreatment::Ignore));
+			break;
+		}
+	case CheckedAST::Kind::ForWithConditionStatement:
+		{
+			auto for_with_condition_statement = static_cast<CheckedAST::ForWithConditionStatement const*>(for_statement);
+			m_code << "for (;";
+			TRY(transpile_expression(for_with_condition_statement->condition()));
+			m_code << ";)";
+			add_new_line();
+			TRY(transpile_block_expression(for_with_condition_statement->body(), LastBlockStatementTreatment::Ignore));
+			break;
+		}
+	case CheckedAST::Kind::ForWithRangeStatement:
+		{
+			auto for_with_range_statement = static_cast<CheckedAST::ForWithRangeStatement const*>(for_statement);
+			auto const& range_variable = m_program.get_variable(for_with_range_statement->range_variable_id());
+
+			m_code << "for (";
+			TRY(transpile_type(range_variable.type_id));
+			m_code << " ";
+			m_code << range_variable.name.view();
+			m_code << " : ";
+			TRY(transpile_expression(for_with_range_statement->range_expression()));
+			m_code << ")";
+			add_new_line();
+			TRY(transpile_block_expression(for_with_range_statement->body(), LastBlockStatementTreatment::Ignore));
+			break;
+		}
+	default:
 		assert(false && "Unhandled for statement");
 	}
 
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_return_statement(std::shared_ptr<CheckedAST::ReturnStatement const> return_statement) {
+Result<void, Error> Transpiler::transpile_return_statement(CheckedAST::ReturnStatement const* return_statement) {
 	auto const& return_value = return_statement->expression();
 	auto const& return_value_type = m_program.get_type(return_value->type_id());
 
@@ -402,52 +477,72 @@ Result<void, Error> Transpiler::transpile_return_statement(std::shared_ptr<Check
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_expression(std::shared_ptr<CheckedAST::Expression const> expression) {
-	if (expression->is_parenthesized_expression()) {
-		auto parenthesized_expression = std::static_pointer_cast<CheckedAST::ParenthesizedExpression const>(expression);
-		m_code << "(";
-		TRY(transpile_expression(parenthesized_expression->expression()));
-		m_code << ")";
-	} else if (expression->is_integer_literal()) {
-		TRY(transpile_integer_literal(std::static_pointer_cast<CheckedAST::IntegerLiteral const>(expression)));
-	} else if (expression->is_char_literal()) {
-		TRY(transpile_char_literal(std::static_pointer_cast<CheckedAST::CharLiteral const>(expression)));
-	} else if (expression->is_boolean_literal()) {
-		TRY(transpile_boolean_literal(std::static_pointer_cast<CheckedAST::BooleanLiteral const>(expression)));
-	} else if (expression->is_identifier()) {
-		TRY(transpile_identifier(std::static_pointer_cast<CheckedAST::Identifier const>(expression)));
-	} else if (expression->is_binary_expression()) {
-		TRY(transpile_binary_expression(std::static_pointer_cast<CheckedAST::BinaryExpression const>(expression)));
-	} else if (expression->is_unary_expression()) {
-		TRY(transpile_unary_expression(std::static_pointer_cast<CheckedAST::UnaryExpression const>(expression)));
-	} else if (expression->is_assignment_expression()) {
-		TRY(transpile_assignment_expression(std::static_pointer_cast<CheckedAST::AssignmentExpression const>(expression)));
-	} else if (expression->is_update_expression()) {
-		TRY(transpile_update_expression(std::static_pointer_cast<CheckedAST::UpdateExpression const>(expression)));
-	} else if (expression->is_pointer_dereference_expression()) {
-		TRY(transpile_pointer_dereference_expression(std::static_pointer_cast<CheckedAST::PointerDereferenceExpression const>(expression)));
-	} else if (expression->is_address_of_expression()) {
-		TRY(transpile_address_of_expression(std::static_pointer_cast<CheckedAST::AddressOfExpression const>(expression)));
-	} else if (expression->is_range_expression()) {
-		TRY(transpile_range_expression(std::static_pointer_cast<CheckedAST::RangeExpression const>(expression)));
-	} else if (expression->is_block_expression()) {
-		TRY(transpile_block_expression(std::static_pointer_cast<CheckedAST::BlockExpression const>(expression)));
-	} else if (expression->is_if_expression()) {
-		TRY(transpile_if_expression(std::static_pointer_cast<CheckedAST::IfExpression const>(expression)));
-	} else if (expression->is_function_call_expression()) {
-		TRY(transpile_function_call_expression(std::static_pointer_cast<CheckedAST::FunctionCallExpression const>(expression)));
-	} else if (expression->is_array_expression()) {
-		TRY(transpile_array_expression(std::static_pointer_cast<CheckedAST::ArrayExpression const>(expression)));
-	} else if (expression->is_array_subscription_expression()) {
-		TRY(transpile_array_subscript_expression(std::static_pointer_cast<CheckedAST::ArraySubscriptExpression const>(expression)));
-	} else {
+Result<void, Error> Transpiler::transpile_expression(CheckedAST::Expression const* expression) {
+	switch (expression->kind()) {
+	case CheckedAST::Kind::ParenthesizedExpression:
+		{
+			auto parenthesized_expression = static_cast<CheckedAST::ParenthesizedExpression const*>(expression);
+			m_code << "(";
+			TRY(transpile_expression(parenthesized_expression->expression()));
+			m_code << ")";
+			break;
+		}
+	case CheckedAST::Kind::IntegerLiteral:
+		TRY(transpile_integer_literal(static_cast<CheckedAST::IntegerLiteral const*>(expression)));
+		break;
+	case CheckedAST::Kind::CharLiteral:
+		TRY(transpile_char_literal(static_cast<CheckedAST::CharLiteral const*>(expression)));
+		break;
+	case CheckedAST::Kind::BooleanLiteral:
+		TRY(transpile_boolean_literal(static_cast<CheckedAST::BooleanLiteral const*>(expression)));
+		break;
+	case CheckedAST::Kind::Identifier:
+		TRY(transpile_identifier(static_cast<CheckedAST::Identifier const*>(expression)));
+		break;
+	case CheckedAST::Kind::BinaryExpression:
+		TRY(transpile_binary_expression(static_cast<CheckedAST::BinaryExpression const*>(expression)));
+		break;
+	case CheckedAST::Kind::UnaryExpression:
+		TRY(transpile_unary_expression(static_cast<CheckedAST::UnaryExpression const*>(expression)));
+		break;
+	case CheckedAST::Kind::AssignmentExpression:
+		TRY(transpile_assignment_expression(static_cast<CheckedAST::AssignmentExpression const*>(expression)));
+		break;
+	case CheckedAST::Kind::UpdateExpression:
+		TRY(transpile_update_expression(static_cast<CheckedAST::UpdateExpression const*>(expression)));
+		break;
+	case CheckedAST::Kind::PointerDereferenceExpression:
+		TRY(transpile_pointer_dereference_expression(static_cast<CheckedAST::PointerDereferenceExpression const*>(expression)));
+		break;
+	case CheckedAST::Kind::AddressOfExpression:
+		TRY(transpile_address_of_expression(static_cast<CheckedAST::AddressOfExpression const*>(expression)));
+		break;
+	case CheckedAST::Kind::RangeExpression:
+		TRY(transpile_range_expression(static_cast<CheckedAST::RangeExpression const*>(expression)));
+		break;
+	case CheckedAST::Kind::BlockExpression:
+		TRY(transpile_block_expression(static_cast<CheckedAST::BlockExpression const*>(expression)));
+		break;
+	case CheckedAST::Kind::IfExpression:
+		TRY(transpile_if_expression(static_cast<CheckedAST::IfExpression const*>(expression)));
+		break;
+	case CheckedAST::Kind::FunctionCallExpression:
+		TRY(transpile_function_call_expression(static_cast<CheckedAST::FunctionCallExpression const*>(expression)));
+		break;
+	case CheckedAST::Kind::ArrayExpression:
+		TRY(transpile_array_expression(static_cast<CheckedAST::ArrayExpression const*>(expression)));
+		break;
+	case CheckedAST::Kind::ArraySubscriptExpression:
+		TRY(transpile_array_subscript_expression(static_cast<CheckedAST::ArraySubscriptExpression const*>(expression)));
+		break;
+	default:
 		assert(false && "Expression not handled!");
 	}
 
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_integer_literal(std::shared_ptr<CheckedAST::IntegerLiteral const> integer_literal) {
+Result<void, Error> Transpiler::transpile_integer_literal(CheckedAST::IntegerLiteral const* integer_literal) {
 	if (!integer_literal->suffix().empty()) {
 		m_code << integer_literal->value() << "_" << integer_literal->suffix();
 	} else {
@@ -461,7 +556,7 @@ Result<void, Error> Transpiler::transpile_integer_literal(std::shared_ptr<Checke
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_char_literal(std::shared_ptr<CheckedAST::CharLiteral const> char_literal) {
+Result<void, Error> Transpiler::transpile_char_literal(CheckedAST::CharLiteral const* char_literal) {
 	m_code << "static_cast<";
 	TRY(transpile_type(char_literal->type_id(), IgnoreFirstQualifier::Yes));
 	m_code << ">(";
@@ -471,7 +566,7 @@ Result<void, Error> Transpiler::transpile_char_literal(std::shared_ptr<CheckedAS
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_boolean_literal(std::shared_ptr<CheckedAST::BooleanLiteral const> boolean_literal) {
+Result<void, Error> Transpiler::transpile_boolean_literal(CheckedAST::BooleanLiteral const* boolean_literal) {
 	m_code << "static_cast<";
 	TRY(transpile_type(boolean_literal->type_id(), IgnoreFirstQualifier::Yes));
 	m_code << ">(";
@@ -481,13 +576,13 @@ Result<void, Error> Transpiler::transpile_boolean_literal(std::shared_ptr<Checke
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_identifier(std::shared_ptr<CheckedAST::Identifier const> identifier) {
+Result<void, Error> Transpiler::transpile_identifier(CheckedAST::Identifier const* identifier) {
 	auto const& variable = m_program.get_variable(identifier->variable_id());
-	m_code << variable.name;
+	m_code << variable.name.view();
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_binary_expression(std::shared_ptr<CheckedAST::BinaryExpression const> binary_expression) {
+Result<void, Error> Transpiler::transpile_binary_expression(CheckedAST::BinaryExpression const* binary_expression) {
 	m_code << "static_cast<";
 	TRY(transpile_type(binary_expression->type_id(), IgnoreFirstQualifier::Yes));
 	m_code << ">(";
@@ -506,7 +601,7 @@ Result<void, Error> Transpiler::transpile_binary_expression(std::shared_ptr<Chec
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_unary_expression(std::shared_ptr<CheckedAST::UnaryExpression const> unary_expression) {
+Result<void, Error> Transpiler::transpile_unary_expression(CheckedAST::UnaryExpression const* unary_expression) {
 	m_code << "static_cast<";
 	TRY(transpile_type(unary_expression->type_id(), IgnoreFirstQualifier::Yes));
 	m_code << ">(";
@@ -521,7 +616,7 @@ Result<void, Error> Transpiler::transpile_unary_expression(std::shared_ptr<Check
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_assignment_expression(std::shared_ptr<CheckedAST::AssignmentExpression const> assignment_expression) {
+Result<void, Error> Transpiler::transpile_assignment_expression(CheckedAST::AssignmentExpression const* assignment_expression) {
 	m_code << "static_cast<";
 	TRY(transpile_type(assignment_expression->type_id(), IgnoreFirstQualifier::Yes));
 	m_code << ">(";
@@ -555,7 +650,7 @@ Result<void, Error> Transpiler::transpile_assignment_expression(std::shared_ptr<
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_update_expression(std::shared_ptr<CheckedAST::UpdateExpression const> update_expression) {
+Result<void, Error> Transpiler::transpile_update_expression(CheckedAST::UpdateExpression const* update_expression) {
 	m_code << "static_cast<";
 	TRY(transpile_type(update_expression->type_id(), IgnoreFirstQualifier::Yes));
 	m_code << ">(";
@@ -577,7 +672,7 @@ Result<void, Error> Transpiler::transpile_update_expression(std::shared_ptr<Chec
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_pointer_dereference_expression(std::shared_ptr<CheckedAST::PointerDereferenceExpression const> pointer_dereference_expression) {
+Result<void, Error> Transpiler::transpile_pointer_dereference_expression(CheckedAST::PointerDereferenceExpression const* pointer_dereference_expression) {
 	m_code << "*";
 	m_code << ")";
 	TRY(transpile_expression(pointer_dereference_expression->operand()));
@@ -585,7 +680,7 @@ Result<void, Error> Transpiler::transpile_pointer_dereference_expression(std::sh
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_address_of_expression(std::shared_ptr<CheckedAST::AddressOfExpression const> address_of_expression) {
+Result<void, Error> Transpiler::transpile_address_of_expression(CheckedAST::AddressOfExpression const* address_of_expression) {
 	m_code << "&";
 	m_code << "(";
 	TRY(transpile_expression(address_of_expression->operand()));
@@ -593,7 +688,7 @@ Result<void, Error> Transpiler::transpile_address_of_expression(std::shared_ptr<
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_range_expression(std::shared_ptr<CheckedAST::RangeExpression const> range_expression) {
+Result<void, Error> Transpiler::transpile_range_expression(CheckedAST::RangeExpression const* range_expression) {
 	TRY(transpile_type(range_expression->type_id()));
 	m_code << "(";
 	TRY(transpile_expression(range_expression->start()));
@@ -603,7 +698,7 @@ Result<void, Error> Transpiler::transpile_range_expression(std::shared_ptr<Check
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_block_expression(std::shared_ptr<CheckedAST::BlockExpression const> block_expression, LastBlockStatementTreatment last_statement_treatment) {
+Result<void, Error> Transpiler::transpile_block_expression(CheckedAST::BlockExpression const* block_expression, LastBlockStatementTreatment last_statement_treatment) {
 	if (m_program.get_type(block_expression->type_id()).is<Types::Void>() || last_statement_treatment == LastBlockStatementTreatment::Ignore) {
 		m_code << "{";
 		++m_indent_level;
@@ -673,7 +768,7 @@ Result<void, Error> Transpiler::transpile_block_expression(std::shared_ptr<Check
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_if_expression(std::shared_ptr<CheckedAST::IfExpression const> if_expression) {
+Result<void, Error> Transpiler::transpile_if_expression(CheckedAST::IfExpression const* if_expression) {
 	if (m_program.get_type(if_expression->type_id()).is<Types::Void>()) {
 		m_code << "if (";
 		TRY(transpile_expression(if_expression->condition()));
@@ -689,7 +784,7 @@ Result<void, Error> Transpiler::transpile_if_expression(std::shared_ptr<CheckedA
 			m_code << "else";
 			add_new_line();
 			if (else_->is_block_expression()) {
-				TRY(transpile_block_expression(std::static_pointer_cast<CheckedAST::BlockExpression const>(else_), LastBlockStatementTreatment::Ignore));
+				TRY(transpile_block_expression(static_cast<CheckedAST::BlockExpression const*>(else_), LastBlockStatementTreatment::Ignore));
 			} else {
 				TRY(transpile_expression(else_));
 			}
@@ -742,9 +837,9 @@ Result<void, Error> Transpiler::transpile_if_expression(std::shared_ptr<CheckedA
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_function_call_expression(std::shared_ptr<CheckedAST::FunctionCallExpression const> function_call_expression) {
+Result<void, Error> Transpiler::transpile_function_call_expression(CheckedAST::FunctionCallExpression const* function_call_expression) {
 	auto const& function = m_program.get_function(function_call_expression->function_id());
-	m_code << function->name();
+	m_code << function->name().view();
 	m_code << "(";
 	for (std::size_t i = 0; i < function_call_expression->arguments().size(); ++i) {
 		auto const& argument = function_call_expression->arguments()[i];
@@ -757,7 +852,7 @@ Result<void, Error> Transpiler::transpile_function_call_expression(std::shared_p
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_array_expression(std::shared_ptr<CheckedAST::ArrayExpression const> array_expression) {
+Result<void, Error> Transpiler::transpile_array_expression(CheckedAST::ArrayExpression const* array_expression) {
 	m_code << "(";
 	TRY(transpile_type(array_expression->type_id(), IgnoreFirstQualifier::Yes));
 	m_code << "{";
@@ -771,7 +866,7 @@ Result<void, Error> Transpiler::transpile_array_expression(std::shared_ptr<Check
 	return {};
 }
 
-Result<void, Error> Transpiler::transpile_array_subscript_expression(std::shared_ptr<CheckedAST::ArraySubscriptExpression const> array_subscript_expression) {
+Result<void, Error> Transpiler::transpile_array_subscript_expression(CheckedAST::ArraySubscriptExpression const* array_subscript_expression) {
 	m_code << "(";
 	TRY(transpile_expression(array_subscript_expression->array()));
 	m_code << ")[";
@@ -2,20 +2,34 @@
 
 #include "CheckedAST.hpp"
 #include "Error.hpp"
+#include "OutputBuffer.hpp"
+#include "OutputSink.hpp"
+#include "utils/Parallel.hpp"
 #include "utils/Result.hpp"
 
-#include <sstream>
+#include <string>
 
 namespace bo {
 
 class Transpiler {
 public:
-	explicit Transpiler(CheckedAST::Program const& program)
-	  : m_program(program) {}
+	explicit Transpiler(CheckedAST::Program const& program, std::size_t thread_count = default_thread_count())
+	  : m_program(program), m_thread_count(std::max<std::size_t>(thread_count, 1)) {}
+
+	enum class PreludeMode {
+		// NOTE: Paste the prelude at the top of the generated file.
+		Inline,
+		// NOTE: Include prelude_header_name, see write_precompiled_prelude().
+		Include
+	};
+
+	void set_prelude_mode(PreludeMode mode) { m_prelude_mode = mode; }
 
 	Result<std::string, Error> transpile();
+	Result<void, Error> transpile(OutputSink&);
 
 private:
+
 	void add_new_line();
 	void add_prelude();
 
@@ -37,31 +51,33 @@ private:
 		Ignore
 	};
 
-	Result<void, Error> transpile_statement(std::shared_ptr<CheckedAST::Statement const>);
-	Result<void, Error> transpile_variable_declaration_statement(std::shared_ptr<CheckedAST::VariableDeclarationStatement const>);
-	Result<void, Error> transpile_function(std::shared_ptr<CheckedAST::Function const>);
-	Result<void, Error> transpile_for_statement(std::shared_ptr<CheckedAST::ForStatement const>);
-	Result<void, Error> transpile_return_statement(std::shared_ptr<CheckedAST::ReturnStatement const>);
-	Result<void, Error> transpile_expression(std::shared_ptr<CheckedAST::Expression const>);
-	Result<void, Error> transpile_integer_literal(std::shared_ptr<CheckedAST::IntegerLiteral const>);
-	Result<void, Error> transpile_char_literal(std::shared_ptr<CheckedAST::CharLiteral const>);
-	Result<void, Error> transpile_boolean_literal(std::shared_ptr<CheckedAST::BooleanLiteral const>);
-	Result<void, Error> transpile_identifier(std::shared_ptr<CheckedAST::Identifier const>);
-	Result<void, Error> transpile_binary_expression(std::shared_ptr<CheckedAST::BinaryExpression const>);
-	Result<void, Error> transpile_unary_expression(std::shared_ptr<CheckedAST::UnaryExpression const>);
-	Result<void, Error> transpile_assignment_expression(std::shared_ptr<CheckedAST::AssignmentExpression const>);
-	Result<void, Error> transpile_update_expression(std::shared_ptr<CheckedAST::UpdateExpression const>);
-	Result<void, Error> transpile_pointer_dereference_expression(std::shared_ptr<CheckedAST::PointerDereferenceExpression const>);
-	Result<void, Error> transpile_address_of_expression(std::shared_ptr<CheckedAST::AddressOfExpression const>);
-	Result<void, Error> transpile_range_expression(std::shared_ptr<CheckedAST::RangeExpression const>);
-	Result<void, Error> transpile_block_expression(std::shared_ptr<CheckedAST::BlockExpression const>, LastBlockStatementTreatment = LastBlockStatementTreatment::AsExpression);
-	Result<void, Error> transpile_if_expression(std::shared_ptr<CheckedAST::IfExpression const>);
-	Result<void, Error> transpile_function_call_expression(std::shared_ptr<CheckedAST::FunctionCallExpression const>);
-	Result<void, Error> transpile_array_expression(std::shared_ptr<CheckedAST::ArrayExpression const>);
-	Result<void, Error> transpile_array_subscript_expression(std::shared_ptr<CheckedAST::ArraySubscriptExpression const>);
+	Result<void, Error> transpile_statement(CheckedAST::Statement const*);
+	Result<void, Error> transpile_variable_declaration_statement(CheckedAST::VariableDeclarationStatement const*);
+	Result<void, Error> transpile_function(CheckedAST::Function const*);
+	Result<void, Error> transpile_for_statement(CheckedAST::ForStatement const*);
+	Result<void, Error> transpile_return_statement(CheckedAST::ReturnStatement const*);
+	Result<void, Error> transpile_expression(CheckedAST::Expression const*);
+	Result<void, Error> transpile_integer_literal(CheckedAST::IntegerLiteral const*);
+	Result<void, Error> transpile_char_literal(CheckedAST::CharLiteral const*);
+	Result<void, Error> transpile_boolean_literal(CheckedAST::BooleanLiteral const*);
+	Result<void, Error> transpile_identifier(CheckedAST::Identifier const*);
+	Result<void, Error> transpile_binary_expression(CheckedAST::BinaryExpression const*);
+	Result<void, Error> transpile_unary_expression(CheckedAST::UnaryExpression const*);
+	Result<void, Error> transpile_assignment_expression(CheckedAST::AssignmentExpression const*);
+	Result<void, Error> transpile_update_expression(CheckedAST::UpdateExpression const*);
+	Result<void, Error> transpile_pointer_dereference_expression(CheckedAST::PointerDereferenceExpression const*);
+	Result<void, Error> transpile_address_of_expression(CheckedAST::AddressOfExpression const*);
+	Result<void, Error> transpile_range_expression(CheckedAST::RangeExpression const*);
+	Result<void, Error> transpile_block_expression(CheckedAST::BlockExpression const*, LastBlockStatementTreatment = LastBlockStatementTreatment::AsExpression);
+	Result<void, Error> transpile_if_expression(CheckedAST::IfExpression const*);
+	Result<void, Error> transpile_function_call_expression(CheckedAST::FunctionCallExpression const*);
+	Result<void, Error> transpile_array_expression(CheckedAST::ArrayExpression const*);
+	Result<void, Error> transpile_array_subscript_expression(CheckedAST::ArraySubscriptExpression const*);
 
 	CheckedAST::Program const& m_program;
-	std::stringstream m_code;
+	std::size_t m_thread_count { 1 };
+	PreludeMode m_prelude_mode { PreludeMode::Inline };
+	OutputBuffer m_code;
 	int m_indent_level { 0 };
 	int m_temp_variable_iota { 0 };
 };
@@ -1,22 +1,95 @@
 #include "Typechecker.hpp"
+#include "Tracer.hpp"
 #include "Types.hpp"
 
 #include <fmt/core.h>
-#include <memory>
+
+#include <algorithm>
+#include <atomic>
 
 namespace bo {
 
-Result<void, Error> Typechecker::check(std::shared_ptr<AST::Program const> parsed_program) {
-	for (auto function_declaration : parsed_program->function_declarations()) {
-		auto checked_function = TRY(check_function_declaration(function_declaration));
-		m_program.add_function(checked_function);
+Typechecker::Typechecker(std::size_t thread_count)
+  : m_owned_program(std::make_unique<CheckedAST::Program>()), m_program(*m_owned_program), m_arena(m_program.arena()), m_thread_count(std::max<std::size_t>(thread_count, 1)) {}
+
+Typechecker::Typechecker(CheckedAST::Program& program, Arena& arena)
+  : m_program(program), m_arena(arena) {}
+
+Result<void, Error> Typechecker::check(AST::Program const* parsed_program) {
+	TraceScope trace { "typecheck", "program" };
+	auto function_declarations = parsed_program->function_declarations();
+
+	// NOTE: Signatures are checked first, in declaration order, so that the
+	//       bodies can then be checked in parallel. A bad signature stops this
+	//       phase, but the bodies declared before it are still checked since
+	//       an error in one of them comes first in the source.
+	std::vector<std::size_t> function_ids;
+	std::vector<std::size_t> scope_ids;
+	std::optional<Error> signature_error;
+	for (auto function_declaration : function_declarations) {
+		auto scope_id = m_program.create_function_scope(m_program.functions().size());
+		auto signature = check_function_signature(function_declaration, scope_id);
+		if (signature.is_error()) {
+			signature_error = signature.release_error();
+			break;
+		}
+
+		function_ids.push_back(m_program.add_function(signature.value()));
+		scope_ids.push_back(scope_id);
+	}
+
+	auto body_count = function_ids.size();
+	std::vector<CheckedAST::Function const*> checked_functions(body_count, nullptr);
+	std::vector<std::optional<Error>> body_errors(body_count);
+	std::atomic<std::size_t> first_failed_body { body_count };
+
+	// NOTE: Spawning a thread costs more than checking a handful of small
+	//       functions, so each worker gets a minimum share of the bodies.
+	constexpr std::size_t minimum_bodies_per_worker = 16;
+	auto worker_count = std::clamp<std::size_t>(body_count / minimum_bodies_per_worker, 1, m_thread_count);
+	std::vector<Typechecker> workers;
+	workers.reserve(worker_count);
+	for (std::size_t i = 0; i < worker_count; ++i) {
+		workers.push_back(Typechecker { m_program, m_program.create_arena() });
+	}
+
+	parallel_for(body_count, worker_count, [&](std::size_t worker, std::size_t i) {
+		// NOTE: Only the first error is reported, so bodies after a failed one
+		//       don't need to be checked.
+		if (i > first_failed_body.load(std::memory_order_relaxed)) {
+			return;
+		}
+
+		auto checked_function = workers[worker].check_function_body(function_declarations[i], function_ids[i], scope_ids[i]);
+		if (checked_function.is_error()) {
+			body_errors[i] = checked_function.release_error();
+			auto first_failed = first_failed_body.load(std::memory_order_relaxed);
+			while (i < first_failed && !first_failed_body.compare_exchange_weak(first_failed, i, std::memory_order_relaxed)) {}
+			return;
+		}
+
+		checked_functions[i] = checked_function.value();
+	});
+
+	for (auto& body_error : body_errors) {
+		if (body_error) {
+			return std::move(*body_error);
+		}
+	}
+
+	if (signature_error) {
+		return std::move(*signature_error);
+	}
+
+	for (std::size_t i = 0; i < body_count; ++i) {
+		m_program.replace_function(function_ids[i], checked_functions[i]);
 	}
 
 	m_is_checked = true;
 	return {};
 }
 
-Result<std::size_t, Error> Typechecker::define_variable(Types::Id type_id, std::string_view name, Span declaration_span) {
+Result<std::size_t, Error> Typechecker::define_variable(Types::Id type_id, Symbol name, Span declaration_span) {
 	if (auto previously_declared_variable_id = m_program.find_variable(name, *m_current_scope)) {
 		return Error { "Variable already declared", m_program.get_variable(*previously_declared_variable_id).declaration_span };
 	}
@@ -24,7 +97,7 @@ Result<std::size_t, Error> Typechecker::define_variable(Types::Id type_id, std::
 	return m_program.define_variable(CheckedAST::Variable { type_id, name, declaration_span, *m_current_scope });
 }
 
-Result<std::size_t, Error> Typechecker::check_array_size(std::shared_ptr<AST::IntegerLiteral const> size_literal) {
+Result<std::size_t, Error> Typechecker::check_array_size(AST::IntegerLiteral const* size_literal) {
 	int base;
 	switch (size_literal->type()) {
 	case AST::IntegerLiteral::Type::Decimal:
@@ -50,7 +123,7 @@ Result<std::size_t, Error> Typechecker::check_array_size(std::shared_ptr<AST::In
 	return Error { "Invalid array size", size_literal->span() };
 }
 
-Result<Types::Id, Error> Typechecker::check_type(std::shared_ptr<AST::Type const> type) {
+Result<Types::Id, Error> Typechecker::check_type(AST::Type const* type) {
 	using namespace std::literals;
 
 	if (type->is_pointer()) {
@@ -85,22 +158,23 @@ Result<Types::Id, Error> Typechecker::check_type(std::shared_ptr<AST::Type const
 	return Error { "Unknown type", type->span() };
 }
 
-Result<std::shared_ptr<CheckedAST::Function const>, Error> Typechecker::check_function_declaration(std::shared_ptr<AST::FunctionDeclarationStatement const> function_declaration) {
-	auto function_name = function_declaration->name()->id();
+Result<CheckedAST::Function const*, Error> Typechecker::check_function_signature(AST::FunctionDeclarationStatement const* function_declaration, std::size_t scope_id) {
+	auto function_name = function_declaration->name()->symbol();
+	TraceScope trace { "typecheck signature", function_name.view() };
 	std::vector<CheckedAST::FunctionParameter> checked_parameters;
 	std::vector<Types::Id> signature;
 
-	m_current_scope = m_program.create_scope();
 	for (auto const& parameter : function_declaration->parameters()) {
-		auto parameter_name = parameter.name->id();
+		auto parameter_name = parameter.name->symbol();
 		auto parameter_type_id = TRY(check_type(parameter.type));
 		if (m_program.get_type(parameter_type_id).is<Types::Void>()) {
 			return Error { "Void type cannot be used as a parameter", parameter.type->span() };
 		}
 
 		auto parameter_span = parameter.name->span();
-		auto variable = CheckedAST::Variable { parameter_type_id, parameter_name, parameter_span, *m_current_scope };
+		auto variable = CheckedAST::Variable { parameter_type_id, parameter_name, parameter_span, scope_id };
 		checked_parameters.emplace_back(variable, parameter.is_anonymous);
+		signature.push_back(parameter_type_id);
 	}
 
 	if (m_program.find_function(function_name, signature)) {
@@ -108,57 +182,72 @@ Result<std::shared_ptr<CheckedAST::Function const>, Error> Typechecker::check_fu
 	}
 
 	auto function_return_type_id = TRY(check_type(function_declaration->return_type()));
-	m_expected_return_type_id = function_return_type_id;
+	return m_arena.make<CheckedAST::Function>(function_name, m_arena.make_array(checked_parameters), function_return_type_id, nullptr, false, function_declaration->span());
+}
+
+Result<CheckedAST::Function const*, Error> Typechecker::check_function_body(AST::FunctionDeclarationStatement const* function_declaration, std::size_t function_id, std::size_t scope_id) {
+	TraceScope trace { "typecheck", function_declaration->name()->id() };
+	auto signature = m_program.get_function(function_id);
+	m_current_function_id = function_id;
+	m_current_scope = scope_id;
+	m_expected_return_type_id = signature->return_type_id();
 
-	for (auto const& parameter : checked_parameters) {
+	for (auto const& parameter : signature->parameters()) {
 		m_program.define_variable(parameter.variable);
 	}
 
 	auto checked_block = TRY(check_block_expression(function_declaration->body()));
-	if (!are_types_compatible_for_assignment(function_return_type_id, checked_block->type_id())) {
+	if (!are_types_compatible_for_assignment(signature->return_type_id(), checked_block->type_id())) {
 		return Error { "Incompatible return types", function_declaration->return_type()->span() };
 	}
 
-	auto checked_function = std::make_shared<CheckedAST::Function const>(function_name, std::move(checked_parameters), function_return_type_id, checked_block, false, function_declaration->span());
+	auto checked_function = m_arena.make<CheckedAST::Function>(signature->name(), signature->parameters(), signature->return_type_id(), checked_block, false, signature->span());
 	m_expected_return_type_id.reset();
 	m_current_scope.reset();
 	return checked_function;
 }
 
-Result<std::shared_ptr<CheckedAST::Statement const>, Error> Typechecker::check_statement(std::shared_ptr<AST::Statement const> statement) {
-	if (statement->is_expression_statement()) {
-		auto expression_statement = std::static_pointer_cast<AST::ExpressionStatement const>(statement);
-		auto checked_expression = TRY(check_expression(expression_statement->expression()));
-		auto checked_expression_statement_type_id = !expression_statement->ends_with_semicolon() ? checked_expression->type_id() : Types::builtin_void_id;
-		auto checked_expression_statement = std::make_shared<CheckedAST::ExpressionStatement>(checked_expression, expression_statement->ends_with_semicolon(), checked_expression_statement_type_id, expression_statement->span());
-		return std::static_pointer_cast<CheckedAST::Statement const>(checked_expression_statement);
-	}
-
-	if (statement->is_variable_declaration()) {
-		auto variable_declaration_statement = std::static_pointer_cast<AST::VariableDeclarationStatement const>(statement);
-		auto checked_variable_declaration_statement = TRY(check_variable_declaration_statement(variable_declaration_statement));
-		return std::static_pointer_cast<CheckedAST::Statement const>(checked_variable_declaration_statement);
-	}
-
-	if (statement->is_for_statement()) {
-		auto for_statement = std::static_pointer_cast<AST::ForStatement const>(statement);
-		auto checked_for_statement = TRY(check_for_statement(for_statement));
-		return std::static_pointer_cast<CheckedAST::Statement const>(checked_for_statement);
-	}
-
-	if (statement->is_return_statement()) {
-		auto return_statement = std::static_pointer_cast<AST::ReturnStatement const>(statement);
-		auto checked_return_statement = TRY(check_return_statement(return_statement));
-		return std::static_pointer_cast<CheckedAST::Statement const>(checked_return_statement);
+Result<CheckedAST::Statement const*, Error> Typechecker::check_statement(AST::Statement const* statement) {
+	switch (statement->kind()) {
+	case AST::Kind::ExpressionStatement:
+		{
+			auto expression_statement = static_cast<AST::ExpressionStatement const*>(statement);
+			auto checked_expression = TRY(check_expression(expression_statement->expression()));
+			auto checked_expression_statement_type_id = !expression_statement->ends_with_semicolon() ? checked_expression->type_id() : Types::builtin_void_id;
+			auto checked_expression_statement = m_arena.make<CheckedAST::ExpressionStatement>(checked_expression, expression_statement->ends_with_semicolon(), checked_expression_statement_type_id, expression_statement->span());
+			return static_cast<CheckedAST::Statement const*>(checked_expression_statement);
+		}
+	case AST::Kind::VariableDeclarationStatement:
+		{
+			auto variable_declaration_statement = static_cast<AST::VariableDeclarationStatement const*>(statement);
+			auto checked_variable_declaration_statement = TRY(check_variable_declaration_statement(variable_declaration_statement));
+			return static_cast<CheckedAST::Statement const*>(checked_variable_declaration_statement);
+		}
+	case AST::Kind::InfiniteForStatement:
+	case AST::Kind::ForWithConditionStatement:
+	case AST::Kind::ForWithRangeStatement:
+		{
+			auto for_statement = static_cast<AST::ForStatement const*>(statement);
+			auto checked_for_statement = TRY(check_for_statement(for_statement));
+			return static_cast<CheckedAST::Statement const*>(checked_for_statement);
+		}
+	case AST::Kind::ReturnStatement:
+		{
+			auto return_statement = static_cast<AST::ReturnStatement const*>(statement);
+			auto checked_return_statement = TRY(check_return_statement(return_statement));
+			return static_cast<CheckedAST::Statement const*>(checked_return_statement);
+		}
+	default:
+		break;
 	}
 
 	assert(false && "Statement not handled");
 }
 
-Result<std::shared_ptr<CheckedAST::VariableDeclarationStatement const>, Error> Typechecker::check_variable_declaration_statement(std::shared_ptr<AST::VariableDeclarationStatement const> variable_declaration_statement) {
+Result<CheckedAST::VariableDeclarationStatement const*, Error> Typechecker::check_variable_declaration_statement(AST::VariableDeclarationStatement const* variable_declaration_statement) {
 	assert(m_current_scope);
 
-	auto variable_name = variable_declaration_statement->identifier()->id();
+	auto variable_name = variable_declaration_statement->identifier()->symbol();
 	auto variable_span = variable_declaration_statement->identifier()->span();
 
 	Types::Id variable_type_id = Types::builtin_unknown_id;
@@ -170,7 +259,7 @@ Result<std::shared_ptr<CheckedAST::VariableDeclarationStatement const>, Error> T
 		}
 	}
 
-	std::shared_ptr<CheckedAST::Expression const> checked_initializer;
+	CheckedAST::Expression const* checked_initializer = nullptr;
 	if (variable_declaration_statement->initializer()) {
 		checked_initializer = TRY(check_expression(variable_declaration_statement->initializer(), variable_type_id));
 		if (checked_initializer->type_id() == Types::builtin_void_id) {
@@ -189,72 +278,77 @@ Result<std::shared_ptr<CheckedAST::VariableDeclarationStatement const>, Error> T
 	}
 
 	auto variable_id = TRY(define_variable(variable_type_id, variable_name, variable_span));
-	return std::make_shared<CheckedAST::VariableDeclarationStatement const>(variable_id, checked_initializer, variable_declaration_statement->span());
+	return m_arena.make<CheckedAST::VariableDeclarationStatement>(variable_id, checked_initializer, variable_declaration_statement->span());
 }
 
-Result<std::shared_ptr<CheckedAST::ForStatement const>, Error> Typechecker::check_for_statement(std::shared_ptr<AST::ForStatement const> for_statement) {
+Result<CheckedAST::ForStatement const*, Error> Typechecker::check_for_statement(AST::ForStatement const* for_statement) {
 	assert(m_current_scope);
 
-	if (for_statement->is_infinite()) {
-		auto old_scope = *m_current_scope;
-		m_current_scope = m_program.create_scope(old_scope);
-		auto checked_body = TRY(check_block_expression(for_statement->body()));
-		m_current_scope = old_scope;
-		auto checked_infinite_for = std::make_shared<CheckedAST::InfiniteForStatement const>(checked_body, for_statement->span());
-		return std::static_pointer_cast<CheckedAST::ForStatement const>(checked_infinite_for);
-	}
-
-	if (for_statement->is_with_condition()) {
-		auto for_with_condition = std::static_pointer_cast<AST::ForWithConditionStatement const>(for_statement);
-		auto checked_condition = TRY(check_expression(for_with_condition->condition()));
-		if (!m_program.get_type(checked_condition->type_id()).is<Types::Bool>()) {
-			return Error { "For condition must be a boolean expression", for_with_condition->condition()->span() };
+	switch (for_statement->kind()) {
+	case AST::Kind::InfiniteForStatement:
+		{
+			auto old_scope = *m_current_scope;
+			m_current_scope = m_program.create_scope(old_scope);
+			auto checked_body = TRY(check_block_expression(for_statement->body()));
+			m_current_scope = old_scope;
+			auto checked_infinite_for = m_arena.make<CheckedAST::InfiniteForStatement>(checked_body, for_statement->span());
+			return static_cast<CheckedAST::ForStatement const*>(checked_infinite_for);
 		}
+	case AST::Kind::ForWithConditionStatement:
+		{
+			auto for_with_condition = static_cast<AST::ForWithConditionStatement const*>(for_statement);
+			auto checked_condition = TRY(check_expression(for_with_condition->condition()));
+			if (!m_program.get_type(checked_condition->type_id()).is<Types::Bool>()) {
+				return Error { "For condition must be a boolean expression", for_with_condition->condition()->span() };
+			}
 
-		auto old_scope = *m_current_scope;
-		m_current_scope = m_program.create_scope(old_scope);
-		auto checked_body = TRY(check_block_expression(for_with_condition->body()));
-		m_current_scope = old_scope;
-
-		auto checked_for_with_condition = std::make_shared<CheckedAST::ForWithConditionStatement>(checked_condition, checked_body, for_with_condition->span());
-		return std::static_pointer_cast<CheckedAST::ForStatement const>(checked_for_with_condition);
-	}
-
-	if (for_statement->is_with_range()) {
-		auto for_with_range = std::static_pointer_cast<AST::ForWithRangeStatement const>(for_statement);
-		auto checked_range_expression = TRY(check_expression(for_with_range->range_expression()));
+			auto old_scope = *m_current_scope;
+			m_current_scope = m_program.create_scope(old_scope);
+			auto checked_body = TRY(check_block_expression(for_with_condition->body()));
+			m_current_scope = old_scope;
 
-		Types::Id range_variable_type_id = Types::builtin_unknown_id;
-		if (m_program.get_type(checked_range_expression->type_id()).is<Types::Range>()) {
-			range_variable_type_id = m_program.get_type(checked_range_expression->type_id()).as<Types::Range>().element_type_id();
-		} else if (m_program.get_type(checked_range_expression->type_id()).is<Types::Array>()) {
-			range_variable_type_id = m_program.get_type(checked_range_expression->type_id()).as<Types::Array>().inner_type_id();
-		} else if (m_program.get_type(checked_range_expression->type_id()).is<Types::Slice>()) {
-			range_variable_type_id = m_program.get_type(checked_range_expression->type_id()).as<Types::Slice>().inner_type_id();
-		} else {
-			return Error { "Range expression must be a range, array or slice", for_with_range->range_expression()->span() };
+			auto checked_for_with_condition = m_arena.make<CheckedAST::ForWithConditionStatement>(checked_condition, checked_body, for_with_condition->span());
+			return static_cast<CheckedAST::ForStatement const*>(checked_for_with_condition);
 		}
+	case AST::Kind::ForWithRangeStatement:
+		{
+			auto for_with_range = static_cast<AST::ForWithRangeStatement const*>(for_statement);
+			auto checked_range_expression = TRY(check_expression(for_with_range->range_expression()));
+
+			Types::Id range_variable_type_id = Types::builtin_unknown_id;
+			if (m_program.get_type(checked_range_expression->type_id()).is<Types::Range>()) {
+				range_variable_type_id = m_program.get_type(checked_range_expression->type_id()).as<Types::Range>().element_type_id();
+			} else if (m_program.get_type(checked_range_expression->type_id()).is<Types::Array>()) {
+				range_variable_type_id = m_program.get_type(checked_range_expression->type_id()).as<Types::Array>().inner_type_id();
+			} else if (m_program.get_type(checked_range_expression->type_id()).is<Types::Slice>()) {
+				range_variable_type_id = m_program.get_type(checked_range_expression->type_id()).as<Types::Slice>().inner_type_id();
+			} else {
+				return Error { "Range expression must be a range, array or slice", for_with_range->range_expression()->span() };
+			}
 
-		auto range_variable_name = for_with_range->range_variable()->id();
-		auto range_variable_span = for_with_range->range_variable()->span();
+			auto range_variable_name = for_with_range->range_variable()->symbol();
+			auto range_variable_span = for_with_range->range_variable()->span();
 
-		auto old_scope = *m_current_scope;
-		m_current_scope = m_program.create_scope(old_scope);
-		auto range_variable_id = TRY(define_variable(range_variable_type_id, range_variable_name, range_variable_span));
-		auto checked_body = TRY(check_block_expression(for_with_range->body()));
-		m_current_scope = old_scope;
+			auto old_scope = *m_current_scope;
+			m_current_scope = m_program.create_scope(old_scope);
+			auto range_variable_id = TRY(define_variable(range_variable_type_id, range_variable_name, range_variable_span));
+			auto checked_body = TRY(check_block_expression(for_with_range->body()));
+			m_current_scope = old_scope;
 
-		auto checked_for_with_range = std::make_shared<CheckedAST::ForWithRangeStatement>(range_variable_id, checked_range_expression, checked_body, for_with_range->span());
-		return std::static_pointer_cast<CheckedAST::ForStatement const>(checked_for_with_range);
+			auto checked_for_with_range = m_arena.make<CheckedAST::ForWithRangeStatement>(range_variable_id, checked_range_expression, checked_body, for_with_range->span());
+			return static_cast<CheckedAST::ForStatement const*>(checked_for_with_range);
+		}
+	default:
+		break;
 	}
 
 	assert(false && "For statement not handled");
 }
 
-Result<std::shared_ptr<CheckedAST::ReturnStatement const>, Error> Typechecker::check_return_statement(std::shared_ptr<AST::ReturnStatement const> return_statement) {
+Result<CheckedAST::ReturnStatement const*, Error> Typechecker::check_return_statement(AST::ReturnStatement const* return_statement) {
 	assert(m_current_scope && m_expected_return_type_id);
 
-	std::shared_ptr<CheckedAST::Expression const> checked_return_value = nullptr;
+	CheckedAST::Expression const* checked_return_value = nullptr;
 	if (return_statement->expression()) {
 		checked_return_value = TRY(check_expression(return_statement->expression()));
 	}
@@ -263,102 +357,107 @@ Result<std::shared_ptr<CheckedAST::ReturnStatement const>, Error> Typechecker::c
 		return Error { "Incompatible return types", return_statement->span() };
 	}
 
-	return std::make_shared<CheckedAST::ReturnStatement const>(checked_return_value, return_statement->span());
+	return m_arena.make<CheckedAST::ReturnStatement>(checked_return_value, return_statement->span());
 }
 
-Result<std::shared_ptr<CheckedAST::Expression const>, Error> Typechecker::check_expression(std::shared_ptr<AST::Expression const> expression, [[maybe_unused]] Types::Id type_hint) {
-	if (expression->is_parenthesized_expression()) {
-		return check_expression(std::static_pointer_cast<AST::ParenthesizedExpression const>(expression)->expression(), type_hint);
-	}
-
-	if (expression->is_integer_literal()) {
-		auto checked_integer_literal = TRY(check_integer_literal(std::static_pointer_cast<AST::IntegerLiteral const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_integer_literal);
-	}
-
-	if (expression->is_char_literal()) {
-		auto checked_char_literal = TRY(check_char_literal(std::static_pointer_cast<AST::CharLiteral const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_char_literal);
-	}
-
-	if (expression->is_boolean_literal()) {
-		auto checked_boolean_literal = TRY(check_boolean_literal(std::static_pointer_cast<AST::BooleanLiteral const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_boolean_literal);
-	}
-
-	if (expression->is_identifier()) {
-		auto checked_identifier = TRY(check_identifier(std::static_pointer_cast<AST::Identifier const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_identifier);
-	}
-
-	if (expression->is_binary_expression()) {
-		auto checked_binary_expression = TRY(check_binary_expression(std::static_pointer_cast<AST::BinaryExpression const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_binary_expression);
-	}
-
-	if (expression->is_unary_expression()) {
-		auto checked_unary_expression = TRY(check_unary_expression(std::static_pointer_cast<AST::UnaryExpression const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_unary_expression);
-	}
-
-	if (expression->is_assignment_expression()) {
-		auto checked_assignment_expression = TRY(check_assignment_expression(std::static_pointer_cast<AST::AssignmentExpression const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_assignment_expression);
-	}
-
-	if (expression->is_update_expression()) {
-		auto checked_update_expression = TRY(check_update_expression(std::static_pointer_cast<AST::UpdateExpression const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_update_expression);
-	}
-
-	if (expression->is_pointer_dereference_expression()) {
-		auto checked_pointer_dereference_expression = TRY(check_pointer_dereference_expression(std::static_pointer_cast<AST::PointerDereferenceExpression const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_pointer_dereference_expression);
-	}
-
-	if (expression->is_address_of_expression()) {
-		auto checked_address_of_expression = TRY(check_address_of_expression(std::static_pointer_cast<AST::AddressOfExpression const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_address_of_expression);
-	}
-
-	if (expression->is_range_expression()) {
-		auto checked_range_expression = TRY(check_range_expression(std::static_pointer_cast<AST::RangeExpression const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_range_expression);
-	}
-
-	if (expression->is_block_expression()) {
-		assert(m_current_scope);
-		auto old_scope = *m_current_scope;
-		old_scope = m_program.create_scope(old_scope);
-		auto checked_block = TRY(check_block_expression(std::static_pointer_cast<AST::BlockExpression const>(expression)));
-		m_current_scope = old_scope;
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_block);
-	}
-
-	if (expression->is_if_expression()) {
-		auto checked_if_expression = TRY(check_if_expression(std::static_pointer_cast<AST::IfExpression const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_if_expression);
-	}
-
-	if (expression->is_function_call_expression()) {
-		auto checked_function_call_expression = TRY(check_function_call_expression(std::static_pointer_cast<AST::FunctionCallExpression const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_function_call_expression);
-	}
-
-	if (expression->is_array_expression()) {
-		auto checked_array_expression = TRY(check_array_expression(std::static_pointer_cast<AST::ArrayExpression const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_array_expression);
-	}
-
-	if (expression->is_array_subscription_expression()) {
-		auto checked_array_subscript_expression = TRY(check_array_subscript_expression(std::static_pointer_cast<AST::ArraySubscriptExpression const>(expression)));
-		return std::static_pointer_cast<CheckedAST::Expression const>(checked_array_subscript_expression);
+Result<CheckedAST::Expression const*, Error> Typechecker::check_expression(AST::Expression const* expression, [[maybe_unused]] Types::Id type_hint) {
+	switch (expression->kind()) {
+	case AST::Kind::ParenthesizedExpression:
+		{
+			return check_expression(static_cast<AST::ParenthesizedExpression const*>(expression)->expression(), type_hint);
+		}
+	case AST::Kind::IntegerLiteral:
+		{
+			auto checked_integer_literal = TRY(check_integer_literal(static_cast<AST::IntegerLiteral const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_integer_literal);
+		}
+	case AST::Kind::CharLiteral:
+		{
+			auto checked_char_literal = TRY(check_char_literal(static_cast<AST::CharLiteral const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_char_literal);
+		}
+	case AST::Kind::BooleanLiteral:
+		{
+			auto checked_boolean_literal = TRY(check_boolean_literal(static_cast<AST::BooleanLiteral const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_boolean_literal);
+		}
+	case AST::Kind::Identifier:
+		{
+			auto checked_identifier = TRY(check_identifier(static_cast<AST::Identifier const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_identifier);
+		}
+	case AST::Kind::BinaryExpression:
+		{
+			auto checked_binary_expression = TRY(check_binary_expression(static_cast<AST::BinaryExpression const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_binary_expression);
+		}
+	case AST::Kind::UnaryExpression:
+		{
+			auto checked_unary_expression = TRY(check_unary_expression(static_cast<AST::UnaryExpression const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_unary_expression);
+		}
+	case AST::Kind::AssignmentExpression:
+		{
+			auto checked_assignment_expression = TRY(check_assignment_expression(static_cast<AST::AssignmentExpression const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_assignment_expression);
+		}
+	case AST::Kind::UpdateExpression:
+		{
+			auto checked_update_expression = TRY(check_update_expression(static_cast<AST::UpdateExpression const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_update_expression);
+		}
+	case AST::Kind::PointerDereferenceExpression:
+		{
+			auto checked_pointer_dereference_expression = TRY(check_pointer_dereference_expression(static_cast<AST::PointerDereferenceExpression const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_pointer_dereference_expression);
+		}
+	case AST::Kind::AddressOfExpression:
+		{
+			auto checked_address_of_expression = TRY(check_address_of_expression(static_cast<AST::AddressOfExpression const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_address_of_expression);
+		}
+	case AST::Kind::RangeExpression:
+		{
+			auto checked_range_expression = TRY(check_range_expression(static_cast<AST::RangeExpression const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_range_expression);
+		}
+	case AST::Kind::BlockExpression:
+		{
+			assert(m_current_scope);
+			auto old_scope = *m_current_scope;
+			old_scope = m_program.create_scope(old_scope);
+			auto checked_block = TRY(check_block_expression(static_cast<AST::BlockExpression const*>(expression)));
+			m_current_scope = old_scope;
+			return static_cast<CheckedAST::Expression const*>(checked_block);
+		}
+	case AST::Kind::IfExpression:
+		{
+			auto checked_if_expression = TRY(check_if_expression(static_cast<AST::IfExpression const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_if_expression);
+		}
+	case AST::Kind::FunctionCallExpression:
+		{
+			auto checked_function_call_expression = TRY(check_function_call_expression(static_cast<AST::FunctionCallExpression const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_function_call_expression);
+		}
+	case AST::Kind::ArrayExpression:
+		{
+			auto checked_array_expression = TRY(check_array_expression(static_cast<AST::ArrayExpression const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_array_expression);
+		}
+	case AST::Kind::ArraySubscriptExpression:
+		{
+			auto checked_array_subscript_expression = TRY(check_array_subscript_expression(static_cast<AST::ArraySubscriptExpression const*>(expression)));
+			return static_cast<CheckedAST::Expression const*>(checked_array_subscript_expression);
+		}
+	default:
+		break;
 	}
 
 	assert(false && "Expression not handled!");
 }
 
-Result<std::shared_ptr<CheckedAST::IntegerLiteral const>, Error> Typechecker::check_integer_literal(std::shared_ptr<AST::IntegerLiteral const> integer_literal) {
+Result<CheckedAST::IntegerLiteral const*, Error> Typechecker::check_integer_literal(AST::IntegerLiteral const* integer_literal) {
 	auto integer_literal_type_id = Types::builtin_unknown_id;
 	if (integer_literal->suffix().empty()) {
 		integer_literal_type_id = Types::builtin_i32_id;
@@ -386,28 +485,28 @@ Result<std::shared_ptr<CheckedAST::IntegerLiteral const>, Error> Typechecker::ch
 		return Error { "Invalid suffix for integer literal", integer_literal->span() };
 	}
 
-	return std::make_shared<CheckedAST::IntegerLiteral const>(integer_literal->value(), integer_literal->suffix(), integer_literal_type_id, integer_literal->span());
+	return m_arena.make<CheckedAST::IntegerLiteral>(integer_literal->value(), integer_literal->suffix(), integer_literal_type_id, integer_literal->span());
 }
 
-Result<std::shared_ptr<CheckedAST::CharLiteral const>, Error> Typechecker::check_char_literal(std::shared_ptr<AST::CharLiteral const> char_literal) {
-	return std::make_shared<CheckedAST::CharLiteral const>(char_literal->value(), char_literal->span());
+Result<CheckedAST::CharLiteral const*, Error> Typechecker::check_char_literal(AST::CharLiteral const* char_literal) {
+	return m_arena.make<CheckedAST::CharLiteral>(char_literal->value(), char_literal->span());
 }
 
-Result<std::shared_ptr<CheckedAST::BooleanLiteral const>, Error> Typechecker::check_boolean_literal(std::shared_ptr<AST::BooleanLiteral const> boolean_literal) {
-	return std::make_shared<CheckedAST::BooleanLiteral const>(boolean_literal->value(), boolean_literal->span());
+Result<CheckedAST::BooleanLiteral const*, Error> Typechecker::check_boolean_literal(AST::BooleanLiteral const* boolean_literal) {
+	return m_arena.make<CheckedAST::BooleanLiteral>(boolean_literal->value(), boolean_literal->span());
 }
 
-Result<std::shared_ptr<CheckedAST::Identifier const>, Error> Typechecker::check_identifier(std::shared_ptr<AST::Identifier const> identifier) {
+Result<CheckedAST::Identifier const*, Error> Typechecker::check_identifier(AST::Identifier const* identifier) {
 	assert(m_current_scope);
 
-	if (auto variable_id = m_program.find_variable(identifier->id(), *m_current_scope)) {
-		return std::make_shared<CheckedAST::Identifier const>(*variable_id, m_program.get_variable(*variable_id).type_id, identifier->span());
+	if (auto variable_id = m_program.find_variable(identifier->symbol(), *m_current_scope)) {
+		return m_arena.make<CheckedAST::Identifier>(*variable_id, m_program.get_variable(*variable_id).type_id, identifier->span());
 	}
 
 	return Error { "Unknown identifier", identifier->span() };
 }
 
-Result<std::shared_ptr<CheckedAST::BinaryExpression const>, Error> Typechecker::check_binary_expression(std::shared_ptr<AST::BinaryExpression const> binary_expression) {
+Result<CheckedAST::BinaryExpression const*, Error> Typechecker::check_binary_expression(AST::BinaryExpression const* binary_expression) {
 	assert(m_current_scope);
 
 	auto checked_lhs = TRY(check_expression(binary_expression->lhs()));
@@ -425,7 +524,7 @@ Result<std::shared_ptr<CheckedAST::BinaryExpression const>, Error> Typechecker::
 				return Error { "Logical operator requires boolean type", binary_expression->lhs()->span() };
 			}
 
-			return std::make_shared<CheckedAST::BinaryExpression const>(checked_lhs, checked_rhs, binary_expression->op(), Types::builtin_bool_id, binary_expression->span());
+			return m_arena.make<CheckedAST::BinaryExpression>(checked_lhs, checked_rhs, binary_expression->op(), Types::builtin_bool_id, binary_expression->span());
 		}
 	case AST::BinaryOperator::BitwiseLeftShift:
 	case AST::BinaryOperator::BitwiseRightShift:
@@ -434,7 +533,7 @@ Result<std::shared_ptr<CheckedAST::BinaryExpression const>, Error> Typechecker::
 				return Error { "Incompatible types for binary operation", binary_expression->span() };
 			}
 
-			return std::make_shared<CheckedAST::BinaryExpression const>(checked_lhs, checked_rhs, binary_expression->op(), checked_lhs->type_id(), binary_expression->span());
+			return m_arena.make<CheckedAST::BinaryExpression>(checked_lhs, checked_rhs, binary_expression->op(), checked_lhs->type_id(), binary_expression->span());
 		}
 	case AST::BinaryOperator::Addition:
 	case AST::BinaryOperator::Subtraction:
@@ -457,7 +556,7 @@ Result<std::shared_ptr<CheckedAST::BinaryExpression const>, Error> Typechecker::
 				return Error { "Incompatible types for binary operation", binary_expression->span() };
 			}
 
-			return std::make_shared<CheckedAST::BinaryExpression const>(checked_lhs, checked_rhs, binary_expression->op(), checked_lhs->type_id(), binary_expression->span());
+			return m_arena.make<CheckedAST::BinaryExpression>(checked_lhs, checked_rhs, binary_expression->op(), checked_lhs->type_id(), binary_expression->span());
 		}
 	case AST::BinaryOperator::LessThan:
 	case AST::BinaryOperator::GreaterThan:
@@ -466,14 +565,14 @@ Result<std::shared_ptr<CheckedAST::BinaryExpression const>, Error> Typechecker::
 		{
 			if (m_program.get_type(checked_lhs->type_id()).is_integer() && m_program.get_type(checked_rhs->type_id()).is_integer()) {
 				if (!(m_program.get_type(checked_lhs->type_id()).is_signed() ^ m_program.get_type(checked_rhs->type_id()).is_signed())) {
-					return std::make_shared<CheckedAST::BinaryExpression const>(checked_lhs, checked_rhs, binary_expression->op(), Types::builtin_bool_id, binary_expression->span());
+					return m_arena.make<CheckedAST::BinaryExpression>(checked_lhs, checked_rhs, binary_expression->op(), Types::builtin_bool_id, binary_expression->span());
 				}
 
 				return Error { "Comparison between types of different signedness", binary_expression->span() };
 			}
 
 			if (m_program.get_type(checked_lhs->type_id()).is<Types::Char>() && m_program.get_type(checked_rhs->type_id()).is<Types::Char>()) {
-				return std::make_shared<CheckedAST::BinaryExpression const>(checked_lhs, checked_rhs, binary_expression->op(), Types::builtin_bool_id, binary_expression->span());
+				return m_arena.make<CheckedAST::BinaryExpression>(checked_lhs, checked_rhs, binary_expression->op(), Types::builtin_bool_id, binary_expression->span());
 			}
 
 			return Error { "Incompatible types for binary operation", binary_expression->span() };
@@ -483,14 +582,14 @@ Result<std::shared_ptr<CheckedAST::BinaryExpression const>, Error> Typechecker::
 		{
 			if (m_program.get_type(checked_lhs->type_id()).is_integer() && m_program.get_type(checked_rhs->type_id()).is_integer()) {
 				if (!(m_program.get_type(checked_lhs->type_id()).is_signed() ^ m_program.get_type(checked_rhs->type_id()).is_signed())) {
-					return std::make_shared<CheckedAST::BinaryExpression const>(checked_lhs, checked_rhs, binary_expression->op(), Types::builtin_bool_id, binary_expression->span());
+					return m_arena.make<CheckedAST::BinaryExpression>(checked_lhs, checked_rhs, binary_expression->op(), Types::builtin_bool_id, binary_expression->span());
 				}
 
 				return Error { "Comparison between types of different signedness", binary_expression->span() };
 			}
 
 			if (m_program.get_type(checked_lhs->type_id()) == m_program.get_type(checked_rhs->type_id())) {
-				return std::make_shared<CheckedAST::BinaryExpression const>(checked_lhs, checked_rhs, binary_expression->op(), Types::builtin_bool_id, binary_expression->span());
+				return m_arena.make<CheckedAST::BinaryExpression>(checked_lhs, checked_rhs, binary_expression->op(), Types::builtin_bool_id, binary_expression->span());
 			}
 
 			return Error { "Incompatible types for binary operation", binary_expression->span() };
@@ -500,7 +599,7 @@ Result<std::shared_ptr<CheckedAST::BinaryExpression const>, Error> Typechecker::
 	assert(false && "Binary expression not handled");
 }
 
-Result<std::shared_ptr<CheckedAST::UnaryExpression const>, Error> Typechecker::check_unary_expression(std::shared_ptr<AST::UnaryExpression const> unary_expression) {
+Result<CheckedAST::UnaryExpression const*, Error> Typechecker::check_unary_expression(AST::UnaryExpression const* unary_expression) {
 	assert(m_current_scope);
 
 	auto checked_operand = TRY(check_expression(unary_expression->operand()));
@@ -518,7 +617,7 @@ Result<std::shared_ptr<CheckedAST::UnaryExpression const>, Error> Typechecker::c
 				return Error { "Unary operator requires integer type", unary_expression->operand()->span() };
 			}
 
-			return std::make_shared<CheckedAST::UnaryExpression const>(checked_operand, unary_expression->op(), checked_operand->type_id(), unary_expression->span());
+			return m_arena.make<CheckedAST::UnaryExpression>(checked_operand, unary_expression->op(), checked_operand->type_id(), unary_expression->span());
 		}
 	case AST::UnaryOperator::LogicalNot:
 		{
@@ -526,14 +625,14 @@ Result<std::shared_ptr<CheckedAST::UnaryExpression const>, Error> Typechecker::c
 				return Error { "Unary operator requires boolean type", unary_expression->operand()->span() };
 			}
 
-			return std::make_shared<CheckedAST::UnaryExpression const>(checked_operand, unary_expression->op(), checked_operand->type_id(), unary_expression->span());
+			return m_arena.make<CheckedAST::UnaryExpression>(checked_operand, unary_expression->op(), checked_operand->type_id(), unary_expression->span());
 		}
 	}
 
 	assert(false && "Unary expression not handled");
 }
 
-Result<std::shared_ptr<CheckedAST::AssignmentExpression const>, Error> Typechecker::check_assignment_expression(std::shared_ptr<AST::AssignmentExpression const> assignment_expression) {
+Result<CheckedAST::AssignmentExpression const*, Error> Typechecker::check_assignment_expression(AST::AssignmentExpression const* assignment_expression) {
 	assert(m_current_scope);
 
 	auto checked_lhs = TRY(check_expression(assignment_expression->lhs()));
@@ -554,7 +653,7 @@ Result<std::shared_ptr<CheckedAST::AssignmentExpression const>, Error> Typecheck
 				return Error { "Incompatible types for assignment", assignment_expression->span() };
 			}
 
-			return std::make_shared<CheckedAST::AssignmentExpression const>(checked_lhs, checked_rhs, assignment_expression->op(), checked_lhs->type_id(), assignment_expression->span());
+			return m_arena.make<CheckedAST::AssignmentExpression>(checked_lhs, checked_rhs, assignment_expression->op(), checked_lhs->type_id(), assignment_expression->span());
 		}
 	case AST::AssignmentOperator::AdditionAssignment:
 	case AST::AssignmentOperator::SubtractionAssignment:
@@ -577,7 +676,7 @@ Result<std::shared_ptr<CheckedAST::AssignmentExpression const>, Error> Typecheck
 				return Error { "Incompatible types for binary operation", assignment_expression->span() };
 			}
 
-			return std::make_shared<CheckedAST::AssignmentExpression const>(checked_lhs, checked_rhs, assignment_expression->op(), checked_lhs->type_id(), assignment_expression->span());
+			return m_arena.make<CheckedAST::AssignmentExpression>(checked_lhs, checked_rhs, assignment_expression->op(), checked_lhs->type_id(), assignment_expression->span());
 		}
 	case AST::AssignmentOperator::BitwiseLeftShiftAssignment:
 	case AST::AssignmentOperator::BitwiseRightShiftAssignment:
@@ -586,7 +685,7 @@ Result<std::shared_ptr<CheckedAST::AssignmentExpression const>, Error> Typecheck
 				return Error { "Incompatible types for binary operation", assignment_expression->span() };
 			}
 
-			return std::make_shared<CheckedAST::AssignmentExpression const>(checked_lhs, checked_rhs, assignment_expression->op(), checked_lhs->type_id(), assignment_expression->span());
+			return m_arena.make<CheckedAST::AssignmentExpression>(checked_lhs, checked_rhs, assignment_expression->op(), checked_lhs->type_id(), assignment_expression->span());
 		}
 	case AST::AssignmentOperator::LogicalAndAssignment:
 	case AST::AssignmentOperator::LogicalOrAssignment:
@@ -595,14 +694,14 @@ Result<std::shared_ptr<CheckedAST::AssignmentExpression const>, Error> Typecheck
 				return Error { "Incompatible types for binary operation", assignment_expression->span() };
 			}
 
-			return std::make_shared<CheckedAST::AssignmentExpression const>(checked_lhs, checked_rhs, assignment_expression->op(), checked_lhs->type_id(), assignment_expression->span());
+			return m_arena.make<CheckedAST::AssignmentExpression>(checked_lhs, checked_rhs, assignment_expression->op(), checked_lhs->type_id(), assignment_expression->span());
 		}
 	}
 
 	assert(false && "Assignment expression not handled");
 }
 
-Result<std::shared_ptr<CheckedAST::UpdateExpression const>, Error> Typechecker::check_update_expression(std::shared_ptr<AST::UpdateExpression const> update_expression) {
+Result<CheckedAST::UpdateExpression const*, Error> Typechecker::check_update_expression(AST::UpdateExpression const* update_expression) {
 	assert(m_current_scope);
 
 	auto checked_operand = TRY(check_expression(update_expression->operand()));
@@ -619,10 +718,10 @@ Result<std::shared_ptr<CheckedAST::UpdateExpression const>, Error> Typechecker::
 		return Error { "Update operator requires integer type", update_expression->operand()->span() };
 	}
 
-	return std::make_shared<CheckedAST::UpdateExpression const>(checked_operand, update_expression->op(), update_expression->is_prefixed(), checked_operand->type_id(), update_expression->span());
+	return m_arena.make<CheckedAST::UpdateExpression>(checked_operand, update_expression->op(), update_expression->is_prefixed(), checked_operand->type_id(), update_expression->span());
 }
 
-Result<std::shared_ptr<CheckedAST::PointerDereferenceExpression const>, Error> Typechecker::check_pointer_dereference_expression(std::shared_ptr<AST::PointerDereferenceExpression const> pointer_dereference_expression) {
+Result<CheckedAST::PointerDereferenceExpression const*, Error> Typechecker::check_pointer_dereference_expression(AST::PointerDereferenceExpression const* pointer_dereference_expression) {
 	assert(m_current_scope);
 
 	auto checked_operand = TRY(check_expression(pointer_dereference_expression->operand()));
@@ -632,10 +731,10 @@ Result<std::shared_ptr<CheckedAST::PointerDereferenceExpression const>, Error> T
 	}
 
 	auto inner_type_id = m_program.get_type(checked_operand->type_id()).as<Types::Pointer>().inner_type_id();
-	return std::make_shared<CheckedAST::PointerDereferenceExpression const>(checked_operand, inner_type_id, pointer_dereference_expression->span());
+	return m_arena.make<CheckedAST::PointerDereferenceExpression>(checked_operand, inner_type_id, pointer_dereference_expression->span());
 }
 
-Result<std::shared_ptr<CheckedAST::AddressOfExpression const>, Error> Typechecker::check_address_of_expression(std::shared_ptr<AST::AddressOfExpression const> address_of_expression) {
+Result<CheckedAST::AddressOfExpression const*, Error> Typechecker::check_address_of_expression(AST::AddressOfExpression const* address_of_expression) {
 	assert(m_current_scope);
 
 	auto checked_operand = TRY(check_expression(address_of_expression->operand()));
@@ -645,37 +744,37 @@ Result<std::shared_ptr<CheckedAST::AddressOfExpression const>, Error> Typechecke
 	}
 
 	auto pointer_type_id = m_program.find_or_add_type(Types::Type::pointer(Types::Pointer::Kind::Strong, checked_operand->type_id(), false));
-	return std::make_shared<CheckedAST::AddressOfExpression const>(checked_operand, pointer_type_id, address_of_expression->span());
+	return m_arena.make<CheckedAST::AddressOfExpression>(checked_operand, pointer_type_id, address_of_expression->span());
 }
 
-Result<std::shared_ptr<CheckedAST::BlockExpression const>, Error> Typechecker::check_block_expression(std::shared_ptr<AST::BlockExpression const> block_expression) {
+Result<CheckedAST::BlockExpression const*, Error> Typechecker::check_block_expression(AST::BlockExpression const* block_expression) {
 	assert(m_current_scope);
 
 	if (block_expression->statements().empty()) {
-		std::vector<std::shared_ptr<CheckedAST::Statement const>> empty_checked_statements;
-		return std::make_shared<CheckedAST::BlockExpression const>(empty_checked_statements, Types::builtin_void_id, false, *m_current_scope, block_expression->span());
+		std::vector<CheckedAST::Statement const*> empty_checked_statements;
+		return m_arena.make<CheckedAST::BlockExpression>(m_arena.make_array(empty_checked_statements), false, *m_current_scope, Types::builtin_void_id, block_expression->span());
 	}
 
 	bool contains_return_statement = false;
-	std::vector<std::shared_ptr<CheckedAST::Statement const>> checked_statements;
+	std::vector<CheckedAST::Statement const*> checked_statements;
 	for (std::size_t i = 0; i < block_expression->statements().size(); ++i) {
 		auto checked_statement = TRY(check_statement(block_expression->statements()[i]));
 		if (checked_statement->is_return_statement()) {
 			contains_return_statement = true;
 		} else if (checked_statement->is_expression_statement()) {
-			auto expression_statement = std::static_pointer_cast<CheckedAST::ExpressionStatement const>(checked_statement);
+			auto expression_statement = static_cast<CheckedAST::ExpressionStatement const*>(checked_statement);
 			if (expression_statement->expression()->is_block_expression()) {
-				auto inner_block_expression = std::static_pointer_cast<CheckedAST::BlockExpression const>(expression_statement->expression());
+				auto inner_block_expression = static_cast<CheckedAST::BlockExpression const*>(expression_statement->expression());
 				contains_return_statement = contains_return_statement || inner_block_expression->contains_return_statement();
 			}
 		}
 		checked_statements.push_back(checked_statement);
 	}
 
-	return std::make_shared<CheckedAST::BlockExpression const>(checked_statements, contains_return_statement, *m_current_scope, checked_statements.back()->type_id(), block_expression->span());
+	return m_arena.make<CheckedAST::BlockExpression>(m_arena.make_array(checked_statements), contains_return_statement, *m_current_scope, checked_statements.back()->type_id(), block_expression->span());
 }
 
-Result<std::shared_ptr<CheckedAST::RangeExpression const>, Error> Typechecker::check_range_expression(std::shared_ptr<AST::RangeExpression const> range_expression) {
+Result<CheckedAST::RangeExpression const*, Error> Typechecker::check_range_expression(AST::RangeExpression const* range_expression) {
 	assert(m_current_scope);
 
 	auto checked_range_start = TRY(check_expression(range_expression->start()));
@@ -686,10 +785,10 @@ Result<std::shared_ptr<CheckedAST::RangeExpression const>, Error> Typechecker::c
 	}
 
 	auto range_type_id = m_program.find_or_add_type(Types::Type::range(checked_range_start->type_id(), range_expression->is_inclusive()));
-	return std::make_shared<CheckedAST::RangeExpression const>(checked_range_start, checked_range_end, range_expression->is_inclusive(), range_type_id, range_expression->span());
+	return m_arena.make<CheckedAST::RangeExpression>(checked_range_start, checked_range_end, range_expression->is_inclusive(), range_type_id, range_expression->span());
 }
 
-Result<std::shared_ptr<CheckedAST::IfExpression const>, Error> Typechecker::check_if_expression(std::shared_ptr<AST::IfExpression const> if_expression) {
+Result<CheckedAST::IfExpression const*, Error> Typechecker::check_if_expression(AST::IfExpression const* if_expression) {
 	assert(m_current_scope);
 
 	auto checked_condition = TRY(check_expression(if_expression->condition()));
@@ -700,7 +799,7 @@ Result<std::shared_ptr<CheckedAST::IfExpression const>, Error> Typechecker::chec
 	auto old_scope = *m_current_scope;
 	m_current_scope = m_program.create_scope(old_scope);
 	auto checked_then = TRY(check_block_expression(if_expression->then()));
-	std::shared_ptr<CheckedAST::Expression const> checked_else = nullptr;
+	CheckedAST::Expression const* checked_else = nullptr;
 
 	Types::Id if_type_id = Types::builtin_void_id;
 	if (if_expression->else_()) {
@@ -713,11 +812,11 @@ Result<std::shared_ptr<CheckedAST::IfExpression const>, Error> Typechecker::chec
 		if_type_id = checked_then->type_id();
 	}
 
-	return std::make_shared<CheckedAST::IfExpression const>(checked_condition, checked_then, checked_else, if_type_id, if_expression->span());
+	return m_arena.make<CheckedAST::IfExpression>(checked_condition, checked_then, checked_else, if_type_id, if_expression->span());
 }
 
-Result<std::shared_ptr<CheckedAST::FunctionCallExpression const>, Error> Typechecker::check_function_call_expression(std::shared_ptr<AST::FunctionCallExpression const> function_call_expression) {
-	auto function_name = function_call_expression->name()->id();
+Result<CheckedAST::FunctionCallExpression const*, Error> Typechecker::check_function_call_expression(AST::FunctionCallExpression const* function_call_expression) {
+	auto function_name = function_call_expression->name()->symbol();
 	std::vector<CheckedAST::FunctionArgument> checked_arguments;
 	std::vector<Types::Id> signature;
 
@@ -727,12 +826,12 @@ Result<std::shared_ptr<CheckedAST::FunctionCallExpression const>, Error> Typeche
 			return Error { "Void type cannot be used as function argument", argument.value->span() };
 		}
 
-		checked_arguments.emplace_back(argument.name ? argument.name->id() : "", checked_argument);
+		checked_arguments.emplace_back(argument.name ? argument.name->symbol() : Symbol {}, checked_argument);
 		signature.push_back(checked_argument->type_id());
 	}
 
 	auto function_id = m_program.find_function(function_name, signature);
-	if (!function_id) {
+	if (!function_id || *function_id >= m_current_function_id) {
 		return Error { "Unknown function", function_call_expression->name()->span() };
 	}
 
@@ -744,10 +843,10 @@ Result<std::shared_ptr<CheckedAST::FunctionCallExpression const>, Error> Typeche
 		}
 	}
 
-	return std::make_shared<CheckedAST::FunctionCallExpression const>(*function_id, checked_arguments, function->return_type_id(), function_call_expression->span());
+	return m_arena.make<CheckedAST::FunctionCallExpression>(*function_id, m_arena.make_array(checked_arguments), function->return_type_id(), function_call_expression->span());
 }
 
-Result<std::shared_ptr<CheckedAST::ArrayExpression const>, Error> Typechecker::check_array_expression(std::shared_ptr<AST::ArrayExpression const> array_expression, [[maybe_unused]] Types::Id type_hint) {
+Result<CheckedAST::ArrayExpression const*, Error> Typechecker::check_array_expression(AST::ArrayExpression const* array_expression, [[maybe_unused]] Types::Id type_hint) {
 	assert(m_current_scope);
 
 	Types::Id expected_array_inner_type_id = Types::builtin_unknown_id;
@@ -766,7 +865,7 @@ Result<std::shared_ptr<CheckedAST::ArrayExpression const>, Error> Typechecker::c
 	}
 
 	Types::Id array_inner_type_id = Types::builtin_unknown_id;
-	std::vector<std::shared_ptr<CheckedAST::Expression const>> checked_elements;
+	std::vector<CheckedAST::Expression const*> checked_elements;
 	for (auto element : array_expression->elements()) {
 		auto checked_element = TRY(check_expression(element));
 		if (m_program.get_type(checked_element->type_id()).is<Types::Void>()) {
@@ -788,7 +887,7 @@ Result<std::shared_ptr<CheckedAST::ArrayExpression const>, Error> Typechecker::c
 		}
 
 		auto array_type_id = m_program.find_or_add_type(Types::Type::array(checked_elements.size(), array_inner_type_id, false));
-		return std::make_shared<CheckedAST::ArrayExpression const>(checked_elements, array_type_id, array_expression->span());
+		return m_arena.make<CheckedAST::ArrayExpression>(m_arena.make_array(checked_elements), array_type_id, array_expression->span());
 	}
 
 	if (expected_array_inner_type_id != array_inner_type_id) {
@@ -797,10 +896,10 @@ Result<std::shared_ptr<CheckedAST::ArrayExpression const>, Error> Typechecker::c
 	}
 
 	auto array_type_id = m_program.find_or_add_type(Types::Type::array(checked_elements.size(), array_inner_type_id, false));
-	return std::make_shared<CheckedAST::ArrayExpression const>(checked_elements, array_type_id, array_expression->span());
+	return m_arena.make<CheckedAST::ArrayExpression>(m_arena.make_array(checked_elements), array_type_id, array_expression->span());
 }
 
-Result<std::shared_ptr<CheckedAST::ArraySubscriptExpression const>, Error> Typechecker::check_array_subscript_expression(std::shared_ptr<AST::ArraySubscriptExpression const> array_subscript_expression) {
+Result<CheckedAST::ArraySubscriptExpression const*, Error> Typechecker::check_array_subscript_expression(AST::ArraySubscriptExpression const* array_subscript_expression) {
 	assert(m_current_scope);
 
 	auto checked_array = TRY(check_expression(array_subscript_expression->array()));
@@ -811,40 +910,39 @@ Result<std::shared_ptr<CheckedAST::ArraySubscriptExpression const>, Error> Typec
 	}
 
 	if (m_program.get_type(checked_array->type_id()).is<Types::Array>()) {
-		return std::make_shared<CheckedAST::ArraySubscriptExpression const>(checked_array, checked_index, m_program.get_type(checked_array->type_id()).as<Types::Array>().inner_type_id(), array_subscript_expression->span());
+		return m_arena.make<CheckedAST::ArraySubscriptExpression>(checked_array, checked_index, m_program.get_type(checked_array->type_id()).as<Types::Array>().inner_type_id(), array_subscript_expression->span());
 	}
 
 	if (m_program.get_type(checked_array->type_id()).is<Types::Slice>()) {
-		return std::make_shared<CheckedAST::ArraySubscriptExpression const>(checked_array, checked_index, m_program.get_type(checked_array->type_id()).as<Types::Slice>().inner_type_id(), array_subscript_expression->span());
+		return m_arena.make<CheckedAST::ArraySubscriptExpression>(checked_array, checked_index, m_program.get_type(checked_array->type_id()).as<Types::Slice>().inner_type_id(), array_subscript_expression->span());
 	}
 
 	return Error { "Array subscript requires array or slice type", array_subscript_expression->array()->span() };
 }
 
 bool Typechecker::are_types_compatible_for_assignment(Types::Id lhs, Types::Id rhs) const {
-	if (m_program.get_type(lhs).is<Types::Void>() && m_program.get_type(rhs).is<Types::Void>()) {
-		return true;
-	}
-
-	if (m_program.get_type(lhs).is_integer() && m_program.get_type(rhs).is_integer()) {
-		if (!(m_program.get_type(lhs).is_signed() ^ m_program.get_type(rhs).is_signed())) {
-			return m_program.get_type(lhs).size() >= m_program.get_type(rhs).size();
-		} else if (m_program.get_type(lhs).is_signed()) {
-			return m_program.get_type(lhs).size() > m_program.get_type(rhs).size();
+	auto const& lhs_traits = m_program.get_type(lhs).traits();
+	auto const& rhs_traits = m_program.get_type(rhs).traits();
+
+	if (lhs_traits.is_integer && rhs_traits.is_integer) {
+		if (!(lhs_traits.is_signed ^ rhs_traits.is_signed)) {
+			return lhs_traits.size >= rhs_traits.size;
+		} else if (lhs_traits.is_signed) {
+			return lhs_traits.size > rhs_traits.size;
 		}
 
 		return false;
 	}
 
-	if (m_program.get_type(lhs).is<Types::Char>() && m_program.get_type(rhs).is<Types::Char>()) {
-		return true;
+	if (lhs_traits.kind != rhs_traits.kind) {
+		return lhs_traits.kind == Types::Kind::Slice && rhs_traits.kind == Types::Kind::Array && lhs_traits.inner_type_id == rhs_traits.inner_type_id;
 	}
 
-	if (m_program.get_type(lhs).is<Types::Bool>() && m_program.get_type(rhs).is<Types::Bool>()) {
+	if (lhs_traits.kind == Types::Kind::Void || lhs_traits.kind == Types::Kind::Char || lhs_traits.kind == Types::Kind::Bool) {
 		return true;
 	}
 
-	if (m_program.get_type(lhs).is<Types::Pointer>() && m_program.get_type(rhs).is<Types::Pointer>()) {
+	if (lhs_traits.kind == Types::Kind::Pointer) {
 		auto const& lhs_pointer = m_program.get_type(lhs).as<Types::Pointer>();
 		auto const& rhs_pointer = m_program.get_type(rhs).as<Types::Pointer>();
 
@@ -858,7 +956,7 @@ bool Typechecker::are_types_compatible_for_assignment(Types::Id lhs, Types::Id r
 		return are_types_compatible_for_assignment(lhs_inner_type_id, rhs_inner_type_id);
 	}
 
-	if (m_program.get_type(lhs).is<Types::Array>() && m_program.get_type(rhs).is<Types::Array>()) {
+	if (lhs_traits.kind == Types::Kind::Array) {
 		auto const& lhs_array = m_program.get_type(lhs).as<Types::Array>();
 		auto const& rhs_array = m_program.get_type(rhs).as<Types::Array>();
 		if (lhs_array.size() != rhs_array.size()) {
@@ -868,18 +966,8 @@ bool Typechecker::are_types_compatible_for_assignment(Types::Id lhs, Types::Id r
 		return lhs_array.inner_type_id() == rhs_array.inner_type_id();
 	}
 
-	if (m_program.get_type(lhs).is<Types::Slice>()) {
-		if (m_program.get_type(rhs).is<Types::Array>()) {
-			auto const& lhs_slice = m_program.get_type(lhs).as<Types::Slice>();
-			auto const& rhs_array = m_program.get_type(rhs).as<Types::Array>();
-
-			return lhs_slice.inner_type_id() == rhs_array.inner_type_id();
-		} else if (m_program.get_type(rhs).is<Types::Slice>()) {
-			auto const& lhs_slice = m_program.get_type(lhs).as<Types::Slice>();
-			auto const& rhs_slice = m_program.get_type(rhs).as<Types::Slice>();
-
-			return lhs_slice.inner_type_id() == rhs_slice.inner_type_id();
-		}
+	if (lhs_traits.kind == Types::Kind::Slice) {
+		return lhs_traits.inner_type_id == rhs_traits.inner_type_id;
 	}
 
 	return false;
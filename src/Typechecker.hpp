@@ -4,15 +4,18 @@
 #include "CheckedAST.hpp"
 #include "Error.hpp"
 #include "Types.hpp"
+#include "utils/Parallel.hpp"
 #include "utils/Result.hpp"
 
+#include <memory>
+
 namespace bo {
 
 class Typechecker {
 public:
-	explicit Typechecker() = default;
+	explicit Typechecker(std::size_t thread_count = default_thread_count());
 
-	Result<void, Error> check(std::shared_ptr<AST::Program const> program);
+	Result<void, Error> check(AST::Program const* program);
 
 	bool is_checked() const { return m_is_checked; }
 	CheckedAST::Program const& program() const {
@@ -20,39 +23,57 @@ public:
 		return m_program;
 	}
 
+	// NOTE: For the passes that rewrite the checked program, see ConstantFolder.
+	CheckedAST::Program& program() {
+		assert(m_is_checked);
+		return m_program;
+	}
+
 private:
-	Result<std::size_t, Error> define_variable(Types::Id, std::string_view name, Span declaration_span);
-
-	Result<std::size_t, Error> check_array_size(std::shared_ptr<AST::IntegerLiteral const>);
-	Result<Types::Id, Error> check_type(std::shared_ptr<AST::Type const>);
-	Result<std::shared_ptr<CheckedAST::Function const>, Error> check_function_declaration(std::shared_ptr<AST::FunctionDeclarationStatement const>);
-	Result<std::shared_ptr<CheckedAST::BlockExpression const>, Error> check_block_expression(std::shared_ptr<AST::BlockExpression const>);
-	Result<std::shared_ptr<CheckedAST::Statement const>, Error> check_statement(std::shared_ptr<AST::Statement const>);
-	Result<std::shared_ptr<CheckedAST::VariableDeclarationStatement const>, Error> check_variable_declaration_statement(std::shared_ptr<AST::VariableDeclarationStatement const>);
-	Result<std::shared_ptr<CheckedAST::ForStatement const>, Error> check_for_statement(std::shared_ptr<AST::ForStatement const>);
-	Result<std::shared_ptr<CheckedAST::ReturnStatement const>, Error> check_return_statement(std::shared_ptr<AST::ReturnStatement const>);
-	Result<std::shared_ptr<CheckedAST::Expression const>, Error> check_expression(std::shared_ptr<AST::Expression const>, Types::Id type_hint = Types::builtin_unknown_id);
-	Result<std::shared_ptr<CheckedAST::IntegerLiteral const>, Error> check_integer_literal(std::shared_ptr<AST::IntegerLiteral const>);
-	Result<std::shared_ptr<CheckedAST::CharLiteral const>, Error> check_char_literal(std::shared_ptr<AST::CharLiteral const>);
-	Result<std::shared_ptr<CheckedAST::BooleanLiteral const>, Error> check_boolean_literal(std::shared_ptr<AST::BooleanLiteral const>);
-	Result<std::shared_ptr<CheckedAST::Identifier const>, Error> check_identifier(std::shared_ptr<AST::Identifier const>);
-	Result<std::shared_ptr<CheckedAST::BinaryExpression const>, Error> check_binary_expression(std::shared_ptr<AST::BinaryExpression const>);
-	Result<std::shared_ptr<CheckedAST::UnaryExpression const>, Error> check_unary_expression(std::shared_ptr<AST::UnaryExpression const>);
-	Result<std::shared_ptr<CheckedAST::AssignmentExpression const>, Error> check_assignment_expression(std::shared_ptr<AST::AssignmentExpression const>);
-	Result<std::shared_ptr<CheckedAST::UpdateExpression const>, Error> check_update_expression(std::shared_ptr<AST::UpdateExpression const>);
-	Result<std::shared_ptr<CheckedAST::PointerDereferenceExpression const>, Error> check_pointer_dereference_expression(std::shared_ptr<AST::PointerDereferenceExpression const>);
-	Result<std::shared_ptr<CheckedAST::AddressOfExpression const>, Error> check_address_of_expression(std::shared_ptr<AST::AddressOfExpression const>);
-	Result<std::shared_ptr<CheckedAST::RangeExpression const>, Error> check_range_expression(std::shared_ptr<AST::RangeExpression const>);
-	Result<std::shared_ptr<CheckedAST::IfExpression const>, Error> check_if_expression(std::shared_ptr<AST::IfExpression const>);
-	Result<std::shared_ptr<CheckedAST::FunctionCallExpression const>, Error> check_function_call_expression(std::shared_ptr<AST::FunctionCallExpression const>);
-	Result<std::shared_ptr<CheckedAST::ArrayExpression const>, Error> check_array_expression(std::shared_ptr<AST::ArrayExpression const>, Types::Id type_hint = Types::builtin_unknown_id);
-	Result<std::shared_ptr<CheckedAST::ArraySubscriptExpression const>, Error> check_array_subscript_expression(std::shared_ptr<AST::ArraySubscriptExpression const>);
+	// NOTE: Function bodies are checked by worker instances, one per thread,
+	//       which share the program of the Typechecker that spawned them but
+	//       allocate nodes from their own arena.
+	explicit Typechecker(CheckedAST::Program& program, Arena& arena);
+
+	Result<std::size_t, Error> define_variable(Types::Id, Symbol name, Span declaration_span);
+
+	Result<std::size_t, Error> check_array_size(AST::IntegerLiteral const*);
+	Result<Types::Id, Error> check_type(AST::Type const*);
+	Result<CheckedAST::Function const*, Error> check_function_signature(AST::FunctionDeclarationStatement const*, std::size_t scope_id);
+	Result<CheckedAST::Function const*, Error> check_function_body(AST::FunctionDeclarationStatement const*, std::size_t function_id, std::size_t scope_id);
+	Result<CheckedAST::BlockExpression const*, Error> check_block_expression(AST::BlockExpression const*);
+	Result<CheckedAST::Statement const*, Error> check_statement(AST::Statement const*);
+	Result<CheckedAST::VariableDeclarationStatement const*, Error> check_variable_declaration_statement(AST::VariableDeclarationStatement const*);
+	Result<CheckedAST::ForStatement const*, Error> check_for_statement(AST::ForStatement const*);
+	Result<CheckedAST::ReturnStatement const*, Error> check_return_statement(AST::ReturnStatement const*);
+	Result<CheckedAST::Expression const*, Error> check_expression(AST::Expression const*, Types::Id type_hint = Types::builtin_unknown_id);
+	Result<CheckedAST::IntegerLiteral const*, Error> check_integer_literal(AST::IntegerLiteral const*);
+	Result<CheckedAST::CharLiteral const*, Error> check_char_literal(AST::CharLiteral const*);
+	Result<CheckedAST::BooleanLiteral const*, Error> check_boolean_literal(AST::BooleanLiteral const*);
+	Result<CheckedAST::Identifier const*, Error> check_identifier(AST::Identifier const*);
+	Result<CheckedAST::BinaryExpression const*, Error> check_binary_expression(AST::BinaryExpression const*);
+	Result<CheckedAST::UnaryExpression const*, Error> check_unary_expression(AST::UnaryExpression const*);
+	Result<CheckedAST::AssignmentExpression const*, Error> check_assignment_expression(AST::AssignmentExpression const*);
+	Result<CheckedAST::UpdateExpression const*, Error> check_update_expression(AST::UpdateExpression const*);
+	Result<CheckedAST::PointerDereferenceExpression const*, Error> check_pointer_dereference_expression(AST::PointerDereferenceExpression const*);
+	Result<CheckedAST::AddressOfExpression const*, Error> check_address_of_expression(AST::AddressOfExpression const*);
+	Result<CheckedAST::RangeExpression const*, Error> check_range_expression(AST::RangeExpression const*);
+	Result<CheckedAST::IfExpression const*, Error> check_if_expression(AST::IfExpression const*);
+	Result<CheckedAST::FunctionCallExpression const*, Error> check_function_call_expression(AST::FunctionCallExpression const*);
+	Result<CheckedAST::ArrayExpression const*, Error> check_array_expression(AST::ArrayExpression const*, Types::Id type_hint = Types::builtin_unknown_id);
+	Result<CheckedAST::ArraySubscriptExpression const*, Error> check_array_subscript_expression(AST::ArraySubscriptExpression const*);
 
 	bool are_types_compatible_for_assignment(Types::Id lhs, Types::Id rhs) const;
 
-	CheckedAST::Program m_program;
+	std::unique_ptr<CheckedAST::Program> m_owned_program;
+	CheckedAST::Program& m_program;
+	Arena& m_arena;
+	std::size_t m_thread_count { 1 };
 	bool m_is_checked { false };
 
+	// NOTE: Only functions declared before the one being checked can be called
+	//       from it, since the transpiled code has no forward declarations.
+	std::size_t m_current_function_id { 0 };
 	std::optional<std::size_t> m_current_scope;
 	std::optional<Types::Id> m_expected_return_type_id;
 };
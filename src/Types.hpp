@@ -1,9 +1,13 @@
 #pragma once
 
+#include "utils/Hash.hpp"
+
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <sys/types.h>
+#include <type_traits>
 #include <variant>
 
 template<typename... Ts>
@@ -110,6 +114,34 @@ private:
 	bool m_is_inclusive;
 };
 
+enum class Kind : std::uint8_t {
+#define BO_ENUMERATE_BUILTIN_TYPE(klass_name, type_name) klass_name,
+	_BO_ENUMERATE_BUILTIN_TYPES
+#undef BO_ENUMERATE_BUILTIN_TYPE
+	Pointer,
+	Array,
+	Slice,
+	Range
+};
+
+// NOTE: Everything the typechecker keeps asking about a type, worked out once
+//       when the type is created instead of visiting it on every query. The
+//       size and alignment are only known for scalars and pointers, for the
+//       other types they are 0. The inner type is the pointee of pointers, the
+//       element of arrays, slices and ranges, and unknown for the rest.
+struct Traits {
+	Kind kind;
+	bool is_builtin { true };
+	bool is_integer { false };
+	bool is_signed { false };
+	std::uint8_t size { 0 };
+	std::uint8_t alignment { 0 };
+	Id inner_type_id { builtin_unknown_id };
+
+	template<typename T>
+	static constexpr Traits integer(Kind kind) { return Traits { kind, true, true, std::is_signed_v<T>, sizeof(T), alignof(T) }; }
+};
+
 class Type {
 private:
 	// clang-format off
@@ -141,7 +173,8 @@ public:
 		return Type(TypeVariant { type.m_impl }, is_mutable);
 	}
 
-	inline bool operator==(Type const&) const = default;
+	// NOTE: The traits are derived from the rest, so they are left out.
+	bool operator==(Type const& other) const { return m_impl == other.m_impl && m_is_mutable == other.m_is_mutable; }
 
 	template<typename T>
 	bool is() const { return std::holds_alternative<T>(m_impl); }
@@ -154,86 +187,70 @@ public:
 
 	bool is_mutable() const { return m_is_mutable; }
 
-	bool is_builtin() const {
-		// NOTE: Not using the macro here, because clang-format sucks :)
-		auto visitor = overload {
-			[](Unknown const&) { return true; },
-			[](Void const&) { return true; },
-			[](U8 const&) { return true; },
-			[](U16 const&) { return true; },
-			[](U32 const&) { return true; },
-			[](U64 const&) { return true; },
-			[](USize const&) { return true; },
-			[](I8 const&) { return true; },
-			[](I16 const&) { return true; },
-			[](I32 const&) { return true; },
-			[](I64 const&) { return true; },
-			[](ISize const&) { return true; },
-			[](Bool const&) { return true; },
-			[](Char const&) { return true; },
-			[](auto&&) { return false; }
-		};
-
-		return std::visit(visitor, m_impl);
-	}
-
-	bool is_integer() const {
+	Traits const& traits() const { return m_traits; }
+	Kind kind() const { return m_traits.kind; }
+	bool is_builtin() const { return m_traits.is_builtin; }
+	bool is_integer() const { return m_traits.is_integer; }
+	bool is_signed() const { return m_traits.is_signed; }
+	std::size_t size() const { return m_traits.size; }
+	std::size_t alignment() const { return m_traits.alignment; }
+	Id inner_type_id() const { return m_traits.inner_type_id; }
+
+	// NOTE: Inner types are referenced by their canonical Id, so hashing only
+	//       needs to look at the outermost layer of the type.
+	std::size_t hash() const {
 		auto visitor = overload {
-			[](U8 const&) { return true; },
-			[](U16 const&) { return true; },
-			[](U32 const&) { return true; },
-			[](U64 const&) { return true; },
-			[](USize const&) { return true; },
-			[](I8 const&) { return true; },
-			[](I16 const&) { return true; },
-			[](I32 const&) { return true; },
-			[](I64 const&) { return true; },
-			[](ISize const&) { return true; },
-			[](auto&&) { return false; }
+			[](Pointer const& pointer) { return hash_combine(static_cast<std::size_t>(pointer.kind()), pointer.inner_type_id()); },
+			[](Array const& array) { return hash_combine(array.size(), array.inner_type_id()); },
+			[](Slice const& slice) { return slice.inner_type_id(); },
+			[](Range const& range) { return hash_combine(range.element_type_id(), range.is_inclusive()); },
+			[](auto&&) -> std::size_t { return 0; }
 		};
 
-		return std::visit(visitor, m_impl);
+		return hash_combine(hash_combine(m_impl.index(), m_is_mutable), std::visit(visitor, m_impl));
 	}
 
-	bool is_signed() const {
-		auto visitor = overload {
-			[](I8 const&) { return true; },
-			[](I16 const&) { return true; },
-			[](I32 const&) { return true; },
-			[](I64 const&) { return true; },
-			[](ISize const&) { return true; },
-			[](auto&&) { return false; }
-		};
-
-		return std::visit(visitor, m_impl);
-	}
+private:
+	explicit Type(TypeVariant&& impl, bool is_mutable)
+	  : m_impl(std::move(impl)), m_is_mutable(is_mutable), m_traits(compute_traits(m_impl)) {}
 
-	std::size_t size() const {
+	static Traits compute_traits(TypeVariant const& impl) {
 		auto visitor = overload {
-			[](U8 const&) { return sizeof(std::uint8_t); },
-			[](U16 const&) { return sizeof(std::uint16_t); },
-			[](U32 const&) { return sizeof(std::uint32_t); },
-			[](U64 const&) { return sizeof(std::uint64_t); },
-			[](USize const&) { return sizeof(std::size_t); },
-			[](I8 const&) { return sizeof(std::int8_t); },
-			[](I16 const&) { return sizeof(std::int16_t); },
-			[](I32 const&) { return sizeof(std::int32_t); },
-			[](I64 const&) { return sizeof(std::int64_t); },
-			[](ISize const&) { return sizeof(ssize_t); },
-			[](auto&&) -> std::size_t { return 0; }
+			[](Unknown const&) { return Traits { Kind::Unknown }; },
+			[](Void const&) { return Traits { Kind::Void }; },
+			[](U8 const&) { return Traits::integer<std::uint8_t>(Kind::U8); },
+			[](U16 const&) { return Traits::integer<std::uint16_t>(Kind::U16); },
+			[](U32 const&) { return Traits::integer<std::uint32_t>(Kind::U32); },
+			[](U64 const&) { return Traits::integer<std::uint64_t>(Kind::U64); },
+			[](USize const&) { return Traits::integer<std::size_t>(Kind::USize); },
+			[](I8 const&) { return Traits::integer<std::int8_t>(Kind::I8); },
+			[](I16 const&) { return Traits::integer<std::int16_t>(Kind::I16); },
+			[](I32 const&) { return Traits::integer<std::int32_t>(Kind::I32); },
+			[](I64 const&) { return Traits::integer<std::int64_t>(Kind::I64); },
+			[](ISize const&) { return Traits::integer<ssize_t>(Kind::ISize); },
+			[](Bool const&) { return Traits { Kind::Bool, true, false, false, sizeof(bool), alignof(bool) }; },
+			[](Char const&) { return Traits { Kind::Char, true, false, false, sizeof(char), alignof(char) }; },
+			[](Pointer const& pointer) { return Traits { Kind::Pointer, false, false, false, sizeof(void*), alignof(void*), pointer.inner_type_id() }; },
+			[](Array const& array) { return Traits { Kind::Array, false, false, false, 0, 0, array.inner_type_id() }; },
+			[](Slice const& slice) { return Traits { Kind::Slice, false, false, false, 0, 0, slice.inner_type_id() }; },
+			[](Range const& range) { return Traits { Kind::Range, false, false, false, 0, 0, range.element_type_id() }; }
 		};
 
-		return std::visit(visitor, m_impl);
+		auto traits = std::visit(visitor, impl);
+		assert(static_cast<std::size_t>(traits.kind) == impl.index());
+		return traits;
 	}
 
-private:
-	explicit Type(TypeVariant&& impl, bool is_mutable)
-	  : m_impl(std::move(impl)), m_is_mutable(is_mutable) {}
-
 	TypeVariant m_impl;
 	bool m_is_mutable;
+	Traits m_traits;
 };
 
 }
 
 }
+
+template<>
+struct std::hash<bo::Types::Type> {
+	std::size_t operator()(bo::Types::Type const& type) const { return type.hash(); }
+};
@@ -1,40 +1,339 @@
+#include "AllocationCounter.hpp"
+#include "CompileCache.hpp"
+#include "Driver.hpp"
 #include "Error.hpp"
-#include "Parser.hpp"
+#include "OutputSink.hpp"
+#include "Prelude.hpp"
+#include "SourceManager.hpp"
+#include "TimeReport.hpp"
+#include "Tracer.hpp"
 #include "Transpiler.hpp"
-#include "Typechecker.hpp"
 #include "utils/Result.hpp"
 
 #include <fmt/core.h>
 
-Result<void, bo::Error> my_main() {
-	auto source = R"(
-fn add(anon a: u32, anon b: u32): u32 { a + b }
-fn add(anon a: i32, anon b: i32): i32 { a + b }
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+#include <unistd.h>
 
-fn main(): void {
-	print(1 == 2 && false);
+struct Options {
+	// NOTE: When set, the prelude is written and precompiled there once and
+	//       the generated files include it instead of pasting it.
+	std::optional<std::string> prelude_directory;
+	std::optional<std::string> cache_directory;
+	bool time_report { false };
+	std::vector<std::string_view> paths;
+};
+
+constexpr std::string_view cache_directory_option = "--cache-dir=";
+
+// NOTE: The cache is opt-in, either per invocation or for a whole CI job
+//       through BOC_CACHE_DIR, whose size is capped by BOC_CACHE_MAX_SIZE (in
+//       bytes) if set.
+static std::optional<std::string> default_cache_directory() {
+	auto const* directory = std::getenv("BOC_CACHE_DIR");
+	if (directory == nullptr || *directory == '\0') {
+		return {};
+	}
+
+	return directory;
+}
+
+static std::uint64_t cache_max_size() {
+	auto const* variable = std::getenv("BOC_CACHE_MAX_SIZE");
+	std::string_view max_size = variable != nullptr ? variable : "";
+	std::uint64_t value;
+	auto [end, error] = std::from_chars(max_size.data(), max_size.data() + max_size.size(), value);
+	if (error != std::errc {} || end != max_size.data() + max_size.size()) {
+		return bo::CompileCache::default_max_size;
+	}
+
+	return value;
+}
+
+static std::string default_compiler() {
+	auto const* compiler = std::getenv("CXX");
+	return compiler != nullptr ? compiler : "c++";
+}
+
+// NOTE: The generated code needs C++23 whatever else is asked for.
+static std::vector<std::string> compiler_flags(std::string_view extra_flags) {
+	std::vector<std::string> flags { "-std=c++23" };
+	while (!extra_flags.empty()) {
+		auto end = extra_flags.find(' ');
+		if (auto flag = extra_flags.substr(0, end); !flag.empty()) {
+			flags.emplace_back(flag);
+		}
+
+		extra_flags.remove_prefix(end == std::string_view::npos ? extra_flags.size() : end + 1);
+	}
+
+	return flags;
+}
+
+// NOTE: Errors outside of the source, like a file that can't be opened, are
+//       reported against the path being compiled.
+static void report_error(std::string_view path, bo::Error const& error, bo::SourceManager const& sources) {
+	if (auto location = sources.resolve(error.span().start)) {
+		fmt::println("Error: {}:{}:{}: {}", location->path, location->line, location->column, error.message());
+	} else {
+		fmt::println("Error: {}: {}", path, error.message());
+	}
+}
+
+Result<void, bo::Error> compile_file(std::string_view path, Options const& options, bo::SourceManager& sources, bo::CompileCache* cache, bo::TimeReport& report) {
+	report.start("read");
+	auto const& file = *TRY(sources.load(std::string { path }));
+	auto prelude_mode = options.prelude_directory ? bo::Transpiler::PreludeMode::Include : bo::Transpiler::PreludeMode::Inline;
+	bo::FileDescriptorSink sink { STDOUT_FILENO };
+	return bo::compile_to_cpp(file, prelude_mode, sink, report, cache);
+}
+
+std::optional<Options> parse_options(std::span<char*> arguments) {
+	constexpr std::string_view prelude_directory_option = "--prelude-dir=";
+
+	Options options;
+	options.cache_directory = default_cache_directory();
+	for (std::string_view argument : arguments) {
+		if (argument.starts_with(prelude_directory_option)) {
+			options.prelude_directory = std::string { argument.substr(prelude_directory_option.size()) };
+		} else if (argument.starts_with(cache_directory_option)) {
+			options.cache_directory = std::string { argument.substr(cache_directory_option.size()) };
+		} else if (argument == "--time-report") {
+			options.time_report = true;
+		} else if (argument.starts_with("--")) {
+			return {};
+		} else {
+			options.paths.push_back(argument);
+		}
+	}
+
+	if (options.paths.empty()) {
+		return {};
+	}
+
+	return options;
 }
-)"sv;
 
-	auto parser = TRY(bo::Parser::create(source));
-	auto program = TRY(parser.parse_program());
-	bo::Typechecker typechecker;
-	TRY(typechecker.check(program));
-	bo::Transpiler transpiler(typechecker.program());
-	auto code = TRY(transpiler.transpile());
-	fmt::print("{}", code);
-	return {};
+std::optional<bo::BuildOptions> parse_build_options(std::span<char*> arguments) {
+	constexpr std::string_view work_directory_option = "--work-dir=";
+	constexpr std::string_view compiler_option = "--cxx=";
+	constexpr std::string_view compiler_flags_option = "--cxx-flags=";
+
+	bo::BuildOptions options;
+	options.work_directory = ".boc";
+	options.compiler = default_compiler();
+	options.compiler_flags = compiler_flags("-O2 -march=native -flto");
+	options.cache_directory = default_cache_directory();
+	options.cache_max_size = cache_max_size();
+	for (std::size_t i = 0; i < arguments.size(); ++i) {
+		std::string_view argument = arguments[i];
+		if (argument == "-o") {
+			if (++i == arguments.size()) {
+				return {};
+			}
+
+			options.output_path = arguments[i];
+		} else if (argument.starts_with(work_directory_option)) {
+			options.work_directory = argument.substr(work_directory_option.size());
+		} else if (argument.starts_with(compiler_option)) {
+			options.compiler = argument.substr(compiler_option.size());
+		} else if (argument.starts_with(cache_directory_option)) {
+			options.cache_directory = argument.substr(cache_directory_option.size());
+		} else if (argument.starts_with(compiler_flags_option)) {
+			options.compiler_flags = compiler_flags(argument.substr(compiler_flags_option.size()));
+		} else if (argument == "--pch") {
+			options.precompile_prelude = true;
+		} else if (argument == "-v" || argument == "--verbose") {
+			options.verbose = true;
+		} else if (argument == "--time-report") {
+			options.time_report = true;
+		} else if (argument.starts_with("-") || !options.source_path.empty()) {
+			return {};
+		} else {
+			options.source_path = argument;
+		}
+	}
+
+	if (options.source_path.empty()) {
+		return {};
+	}
+
+	return options;
 }
 
-int main() {
-	auto result = my_main();
+int build(std::string_view program_name, std::span<char*> arguments) {
+	auto options = parse_build_options(arguments);
+	if (!options) {
+		fmt::print(stderr, "Usage: {} build [-o <output>] [--work-dir=<directory>] [--cxx=<compiler>] [--cxx-flags=<flags>] [--pch] [--cache-dir=<directory>] [--time-report] [--trace=<file>] [-v] <file>\n", program_name);
+		return 1;
+	}
+
+	if (options->time_report) {
+		bo::AllocationCounter::enable();
+	}
+
+	bo::SourceManager sources;
+	bo::TimeReport report;
+	auto result = bo::build(*options, sources, report);
+	report.stop();
+	if (options->time_report) {
+		report.print(stderr);
+	}
+
 	if (result.is_error()) {
-		// FIXME: Use custom formatter for Error
-		auto error = result.release_error();
-		fmt::println("Error: {}", error.message());
-		fmt::println("Span: {}", error.span());
+		report_error(options->source_path, result.error(), sources);
+		return 1;
+	}
+
+	return 0;
+}
+
+int cache(std::string_view program_name, std::span<char*> arguments) {
+	auto cache_directory = default_cache_directory();
+	std::string_view action;
+	for (std::string_view argument : arguments) {
+		if (argument.starts_with(cache_directory_option)) {
+			cache_directory = std::string { argument.substr(cache_directory_option.size()) };
+		} else if (action.empty() && (argument == "stats" || argument == "clear")) {
+			action = argument;
+		} else {
+			action = {};
+			break;
+		}
+	}
+
+	if (action.empty() || !cache_directory) {
+		fmt::print(stderr, "Usage: {} cache stats|clear [--cache-dir=<directory>]\n", program_name);
+		return 1;
+	}
+
+	auto run = [&]() -> Result<void, bo::Error> {
+		auto cache = TRY(bo::CompileCache::open(*cache_directory, cache_max_size()));
+		if (action == "clear") {
+			return cache.clear();
+		}
+
+		auto stats = TRY(cache.stats());
+		auto lookups = stats.hits + stats.misses;
+		fmt::println("directory: {}", cache.directory());
+		fmt::println("hits:      {}", stats.hits);
+		fmt::println("misses:    {}", stats.misses);
+		fmt::println("hit rate:  {:.1f}%", lookups == 0 ? 0.0 : 100.0 * static_cast<double>(stats.hits) / static_cast<double>(lookups));
+		fmt::println("evictions: {}", stats.evictions);
+		fmt::println("size:      {} / {} bytes", stats.size, cache.max_size());
+		return {};
+	};
+
+	if (auto result = run(); result.is_error()) {
+		fmt::println("Error: {}", result.error().message());
+		return 1;
+	}
+
+	return 0;
+}
+
+// NOTE: Tracing is understood by every command, so it's taken out of the
+//       arguments before they're parsed.
+static std::optional<std::string> extract_trace_path(std::vector<char*>& arguments) {
+	constexpr std::string_view trace_option = "--trace=";
+
+	std::optional<std::string> trace_path;
+	std::erase_if(arguments, [&](std::string_view argument) {
+		if (!argument.starts_with(trace_option)) {
+			return false;
+		}
+
+		trace_path = std::string { argument.substr(trace_option.size()) };
+		return true;
+	});
+
+	return trace_path;
+}
+
+int run(std::string_view program_name, std::span<char*> arguments) {
+	if (arguments.size() >= 2 && std::string_view { arguments[1] } == "build") {
+		return build(program_name, arguments.subspan(2));
+	}
+
+	if (arguments.size() >= 2 && std::string_view { arguments[1] } == "cache") {
+		return cache(program_name, arguments.subspan(2));
+	}
+
+	auto options = parse_options(arguments.empty() ? arguments : arguments.subspan(1));
+	if (!options) {
+		fmt::print(stderr, "Usage: {} [--prelude-dir=<directory>] [--cache-dir=<directory>] [--time-report] [--trace=<file>] <file>...\n", program_name);
+		fmt::print(stderr, "       {} cache stats|clear [--cache-dir=<directory>]\n", program_name);
+		fmt::print(stderr, "       {} build [-o <output>] [--work-dir=<directory>] [--cxx=<compiler>] [--cxx-flags=<flags>] [--pch] [--cache-dir=<directory>] [--time-report] [--trace=<file>] [-v] <file>\n", program_name);
 		return 1;
 	}
 
+	if (options->prelude_directory) {
+		// NOTE: The generated code has to be compiled with the same compiler and
+		//       flags for the precompiled header to be used.
+		auto result = bo::write_precompiled_prelude(*options->prelude_directory, default_compiler(), compiler_flags({}));
+		if (result.is_error()) {
+			fmt::println("Error: {}", result.error().message());
+			return 1;
+		}
+	}
+
+	std::optional<bo::CompileCache> cache;
+	if (options->cache_directory) {
+		auto opened_cache = bo::CompileCache::open(*options->cache_directory, cache_max_size());
+		if (opened_cache.is_error()) {
+			fmt::println("Error: {}", opened_cache.error().message());
+			return 1;
+		}
+
+		cache = opened_cache.release_value();
+	}
+
+	if (options->time_report) {
+		bo::AllocationCounter::enable();
+	}
+
+	// NOTE: Every file stays loaded until the end, since errors are only
+	//       resolved to lines and columns against the manager.
+	bo::SourceManager sources;
+	for (auto path : options->paths) {
+		bo::TimeReport report;
+		auto result = compile_file(path, *options, sources, cache ? &*cache : nullptr, report);
+		report.stop();
+		if (options->time_report) {
+			fmt::print(stderr, "{}:\n", path);
+			report.print(stderr);
+		}
+
+		if (result.is_error()) {
+			report_error(path, result.error(), sources);
+			return 1;
+		}
+	}
+
 	return 0;
 }
+
+int main(int argc, char** argv) {
+	std::vector<char*> arguments { argv, argv + argc };
+	std::string_view program_name = arguments.empty() ? "boc" : arguments[0];
+	auto trace_path = extract_trace_path(arguments);
+	if (trace_path) {
+		bo::Tracer::enable();
+	}
+
+	auto status = run(program_name, arguments);
+	if (trace_path) {
+		if (auto result = bo::Tracer::write(*trace_path); result.is_error()) {
+			fmt::println("Error: {}", result.error().message());
+			return 1;
+		}
+	}
+
+	return status;
+}
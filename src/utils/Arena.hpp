@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace bo {
+
+// NOTE: A bump allocator that owns every node of a compilation unit. Objects
+//       placed in it are never destroyed individually: the whole arena is
+//       released at once by dropping its chunks, so anything a node refers to
+//       (child nodes, arrays of children, ...) must live in an arena too.
+class Arena {
+public:
+	static constexpr std::size_t default_chunk_size = 64 * 1024;
+
+	explicit Arena(std::size_t chunk_size = default_chunk_size)
+	  : m_chunk_size(chunk_size) {}
+
+	Arena(Arena const&) = delete;
+	Arena& operator=(Arena const&) = delete;
+	Arena(Arena&&) = delete;
+	Arena& operator=(Arena&&) = delete;
+	~Arena() = default;
+
+	void* allocate(std::size_t size, std::size_t alignment) {
+		auto current = reinterpret_cast<std::uintptr_t>(m_current);
+		auto aligned = (current + alignment - 1) & ~(alignment - 1);
+		if (m_current == nullptr || aligned + size > reinterpret_cast<std::uintptr_t>(m_end)) [[unlikely]] {
+			add_chunk(size + alignment);
+			current = reinterpret_cast<std::uintptr_t>(m_current);
+			aligned = (current + alignment - 1) & ~(alignment - 1);
+		}
+
+		m_current = reinterpret_cast<std::byte*>(aligned + size);
+		m_bytes_allocated += size;
+		return reinterpret_cast<void*>(aligned);
+	}
+
+	template<typename T, typename... Args>
+	T* make(Args&&... args) {
+		void* memory = allocate(sizeof(T), alignof(T));
+		++m_object_count;
+		return new (memory) T(std::forward<Args>(args)...);
+	}
+
+	template<typename T>
+	std::span<T const> make_array(std::span<T const> elements) {
+		if (elements.empty()) {
+			return {};
+		}
+
+		auto* memory = static_cast<T*>(allocate(sizeof(T) * elements.size(), alignof(T)));
+		std::uninitialized_copy(elements.begin(), elements.end(), memory);
+		return { memory, elements.size() };
+	}
+
+	template<typename T>
+	std::span<T const> make_array(std::vector<T> const& elements) { return make_array(std::span<T const> { elements }); }
+
+	std::size_t bytes_allocated() const { return m_bytes_allocated; }
+	// NOTE: Number of objects created with make(), which for the syntax trees
+	//       amounts to their node count.
+	std::size_t object_count() const { return m_object_count; }
+	std::size_t chunk_count() const { return m_chunks.size(); }
+
+private:
+	void add_chunk(std::size_t minimum_size) {
+		auto size = std::max(m_chunk_size, minimum_size);
+		m_chunks.push_back(std::make_unique_for_overwrite<std::byte[]>(size));
+		m_current = m_chunks.back().get();
+		m_end = m_current + size;
+	}
+
+	std::size_t m_chunk_size;
+	std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+	std::byte* m_current { nullptr };
+	std::byte* m_end { nullptr };
+	std::size_t m_bytes_allocated { 0 };
+	std::size_t m_object_count { 0 };
+};
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace bo {
+
+// NOTE: Maps equal values to the same dense id, from any number of threads.
+//       Values are stored in segments that double in size and are never
+//       reallocated, so a reference returned by get() stays valid and reading
+//       an id doesn't need the lock: an id can only be observed after the
+//       lock that published it was released. Lookups of existing values take
+//       the lock too, since most calls either hit cheaply or insert anyway,
+//       and reads vastly outnumber both.
+template<typename T, typename Hash = std::hash<T>>
+class ConcurrentInterner {
+public:
+	std::size_t intern(T const& value) {
+		std::scoped_lock lock { m_mutex };
+		auto [it, inserted] = m_ids.try_emplace(value, m_size);
+		if (inserted) {
+			auto [segment, offset] = locate(m_size);
+			if (offset == 0) {
+				assert(segment < max_segments);
+				m_segments[segment].reserve(first_segment_size << segment);
+			}
+
+			m_segments[segment].push_back(value);
+			++m_size;
+		}
+
+		return it->second;
+	}
+
+	T const& get(std::size_t id) const {
+		if (id < first_segment_size) [[likely]] {
+			return m_segments[0][id];
+		}
+
+		auto [segment, offset] = locate(id);
+		return m_segments[segment][offset];
+	}
+
+	std::size_t size() const {
+		std::scoped_lock lock { m_mutex };
+		return m_size;
+	}
+
+private:
+	static constexpr std::size_t first_segment_size = 64;
+	static constexpr std::size_t max_segments = 32;
+
+	struct Location {
+		std::size_t segment;
+		std::size_t offset;
+	};
+
+	// NOTE: Segment k holds first_segment_size << k values, starting at id
+	//       first_segment_size * (2^k - 1).
+	static Location locate(std::size_t id) {
+		auto segment = static_cast<std::size_t>(std::bit_width(id / first_segment_size + 1)) - 1;
+		return { segment, id - first_segment_size * ((std::size_t(1) << segment) - 1) };
+	}
+
+	mutable std::mutex m_mutex;
+	std::unordered_map<T, std::size_t, Hash> m_ids;
+	std::array<std::vector<T>, max_segments> m_segments;
+	std::size_t m_size { 0 };
+};
+
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace bo {
+
+// NOTE: Same mixing step as boost::hash_combine, widened to 64 bits.
+constexpr std::size_t hash_combine(std::size_t seed, std::size_t value) {
+	return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+// NOTE: A streaming 128-bit hash for content addressing, made of two 64-bit
+//       lanes in the style of MurmurHash2 and MurmurHash3 with different
+//       constants. It's meant to make accidental collisions between cache keys
+//       practically impossible, not to resist deliberate ones.
+class ContentHasher {
+public:
+	void update(std::string_view bytes) {
+		m_length += bytes.size();
+		if (m_pending_size != 0) {
+			auto count = std::min(bytes.size(), sizeof(m_pending) - m_pending_size);
+			std::memcpy(m_pending + m_pending_size, bytes.data(), count);
+			m_pending_size += count;
+			bytes.remove_prefix(count);
+			if (m_pending_size < sizeof(m_pending)) {
+				return;
+			}
+
+			mix(load(m_pending));
+			m_pending_size = 0;
+		}
+
+		for (; bytes.size() >= sizeof(std::uint64_t); bytes.remove_prefix(sizeof(std::uint64_t))) {
+			mix(load(bytes.data()));
+		}
+
+		if (!bytes.empty()) {
+			std::memcpy(m_pending, bytes.data(), bytes.size());
+		}
+
+		m_pending_size = bytes.size();
+	}
+
+	// NOTE: Hashes the length before the bytes, so that consecutive fields
+	//       can't run into each other.
+	void update_field(std::string_view field) {
+		char length[sizeof(std::uint64_t)];
+		auto size = static_cast<std::uint64_t>(field.size());
+		std::memcpy(length, &size, sizeof(length));
+		update({ length, sizeof(length) });
+		update(field);
+	}
+
+	// NOTE: The hash as 32 lowercase hexadecimal digits.
+	std::string hex_digest() const {
+		auto lanes = m_lanes;
+		if (m_pending_size != 0) {
+			char last[sizeof(std::uint64_t)] {};
+			std::memcpy(last, m_pending, m_pending_size);
+			mix(lanes, load(last));
+		}
+
+		mix(lanes, m_length);
+
+		constexpr std::string_view digits = "0123456789abcdef";
+		std::string digest;
+		digest.reserve(32);
+		for (auto lane : lanes) {
+			lane = finalize(lane);
+			for (int shift = 60; shift >= 0; shift -= 4) {
+				digest.push_back(digits[(lane >> shift) & 0xf]);
+			}
+		}
+
+		return digest;
+	}
+
+private:
+	static std::uint64_t load(char const* bytes) {
+		std::uint64_t word;
+		std::memcpy(&word, bytes, sizeof(word));
+		return word;
+	}
+
+	static void mix(std::array<std::uint64_t, 2>& lanes, std::uint64_t word) {
+		constexpr std::uint64_t m = 0xc6a4a7935bd1e995ULL;
+		auto k = word * m;
+		k ^= k >> 47;
+		k *= m;
+		lanes[0] = (lanes[0] ^ k) * m;
+
+		constexpr std::uint64_t c1 = 0x87c37b91114253d5ULL;
+		constexpr std::uint64_t c2 = 0x4cf5ad432745937fULL;
+		lanes[1] ^= std::rotl(word * c1, 31) * c2;
+		lanes[1] = std::rotl(lanes[1], 27) * 5 + 0x52dce729;
+	}
+
+	void mix(std::uint64_t word) { mix(m_lanes, word); }
+
+	static std::uint64_t finalize(std::uint64_t h) {
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		h *= 0xc4ceb9fe1a85ec53ULL;
+		h ^= h >> 33;
+		return h;
+	}
+
+	std::array<std::uint64_t, 2> m_lanes { 0x243f6a8885a308d3ULL, 0x13198a2e03707344ULL };
+	std::uint64_t m_length { 0 };
+	char m_pending[sizeof(std::uint64_t)];
+	std::size_t m_pending_size { 0 };
+};
+
+}
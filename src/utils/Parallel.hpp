@@ -0,0 +1,47 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace bo {
+
+inline std::size_t default_thread_count() {
+	return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+// NOTE: Calls `body(worker, index)` once for every index in [0, count), from
+//       up to `worker_count` threads. Indices are handed out one at a time from
+//       a shared counter so that uneven items balance out, and `worker` (in
+//       [0, worker_count)) lets the body pick per-thread scratch state. With a
+//       single worker everything runs on the calling thread.
+template<typename Body>
+void parallel_for(std::size_t count, std::size_t worker_count, Body const& body) {
+	worker_count = std::clamp<std::size_t>(worker_count, 1, std::max<std::size_t>(count, 1));
+	if (worker_count == 1) {
+		for (std::size_t i = 0; i < count; ++i) {
+			body(std::size_t(0), i);
+		}
+
+		return;
+	}
+
+	std::atomic<std::size_t> next_index { 0 };
+	auto run = [&](std::size_t worker) {
+		for (auto i = next_index.fetch_add(1, std::memory_order_relaxed); i < count; i = next_index.fetch_add(1, std::memory_order_relaxed)) {
+			body(worker, i);
+		}
+	};
+
+	std::vector<std::jthread> threads;
+	threads.reserve(worker_count - 1);
+	for (std::size_t worker = 1; worker < worker_count; ++worker) {
+		threads.emplace_back(run, worker);
+	}
+
+	run(0);
+}
+
+}
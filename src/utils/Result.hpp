@@ -1,8 +1,51 @@
 #pragma once
 
 #include <cassert>
-#include <optional>
-#include <variant>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// NOTE: Errors are rare, so a Result keeps them out of line: the error lives in
+//       a heap box and the Result itself only holds a pointer to it next to
+//       the value. This keeps a Result about as small as its value, which
+//       matters for the deeply recursive parser and typechecker, where every
+//       frame holds a few of them. Creating and destroying the box are kept
+//       out of the hot path, and TRY hands the box over to the caller's Result
+//       as is instead of moving the error into a new one.
+
+template<typename ErrorType>
+class [[nodiscard]] ErrorBox {
+public:
+	explicit ErrorBox(ErrorType* error)
+	  : m_error(error) {}
+
+	ErrorBox(ErrorBox&& other)
+	  : m_error(std::exchange(other.m_error, nullptr)) {}
+
+	ErrorBox(ErrorBox const&) = delete;
+	ErrorBox& operator=(ErrorBox const&) = delete;
+
+	~ErrorBox() {
+		if (m_error != nullptr) [[unlikely]] {
+			destroy(m_error);
+		}
+	}
+
+	template<typename... Arguments>
+	[[gnu::cold, gnu::noinline]] static ErrorType* create(Arguments&&... arguments) {
+		return new ErrorType(std::forward<Arguments>(arguments)...);
+	}
+
+	[[gnu::cold, gnu::noinline]] static void destroy(ErrorType* error) {
+		delete error;
+	}
+
+	ErrorType* release() { return std::exchange(m_error, nullptr); }
+
+private:
+	ErrorType* m_error;
+};
 
 // NOTE: Marking these classes as [[nodiscard]] so that whenever we use them we
 //       are warned if we don't call them with TRY or MUST.
@@ -11,46 +54,78 @@ template<typename ValueType, typename ErrorType>
 class [[nodiscard]] Result {
 public:
 	Result(ValueType const& value)
-	  : m_impl(value) {}
+	  : m_value(value) {}
 
 	Result(ValueType&& value)
-	  : m_impl(std::move(value)) {}
+	  : m_value(std::move(value)) {}
 
 	Result(ErrorType const& error)
-	  : m_impl(error) {}
+	  : m_error(ErrorBox<ErrorType>::create(error)), m_is_error(true) {}
 
 	Result(ErrorType&& error)
-	  : m_impl(std::move(error)) {}
+	  : m_error(ErrorBox<ErrorType>::create(std::move(error))), m_is_error(true) {}
+
+	Result(ErrorBox<ErrorType>&& error)
+	  : m_error(error.release()), m_is_error(true) {}
+
+	Result(Result&& other)
+	  : m_is_error(other.m_is_error) {
+		if (m_is_error) [[unlikely]] {
+			m_error = std::exchange(other.m_error, nullptr);
+		} else {
+			new (&m_value) ValueType(std::move(other.m_value));
+		}
+	}
 
-	Result(Result const&) = default;
-	Result(Result&&) = default;
-	~Result() = default;
+	Result(Result const&) = delete;
+	Result& operator=(Result const&) = delete;
+
+	~Result() {
+		if (m_is_error) [[unlikely]] {
+			if (m_error != nullptr) {
+				ErrorBox<ErrorType>::destroy(m_error);
+			}
+		} else {
+			m_value.~ValueType();
+		}
+	}
 
-	bool is_value() const { return std::holds_alternative<ValueType>(m_impl); }
-	bool is_error() const { return std::holds_alternative<ErrorType>(m_impl); }
+	bool is_value() const { return !m_is_error; }
+	bool is_error() const { return m_is_error; }
 
 	ValueType& value() {
 		assert(is_value());
-		return std::get<ValueType>(m_impl);
+		return m_value;
 	}
 
 	ValueType&& release_value() {
 		assert(is_value());
-		return std::get<ValueType>(std::move(m_impl));
+		return std::move(m_value);
 	}
 
 	ErrorType& error() {
-		assert(is_error());
-		return std::get<ErrorType>(m_impl);
+		assert(is_error() && m_error != nullptr);
+		return *m_error;
 	}
 
 	ErrorType&& release_error() {
+		assert(is_error() && m_error != nullptr);
+		return std::move(*m_error);
+	}
+
+	// NOTE: Passes the error on to another Result without unboxing it, leaving
+	//       this one empty.
+	ErrorBox<ErrorType> forward_error() {
 		assert(is_error());
-		return std::get<ErrorType>(std::move(m_impl));
+		return ErrorBox<ErrorType> { std::exchange(m_error, nullptr) };
 	}
 
 private:
-	std::variant<ValueType, ErrorType> m_impl;
+	union {
+		ValueType m_value;
+		ErrorType* m_error;
+	};
+	bool m_is_error { false };
 };
 
 template<typename ErrorType>
@@ -59,46 +134,64 @@ public:
 	Result() = default;
 
 	Result(ErrorType const& error)
-	  : m_impl(error) {}
+	  : m_error(ErrorBox<ErrorType>::create(error)) {}
+
+	Result(ErrorType&& error)
+	  : m_error(ErrorBox<ErrorType>::create(std::move(error))) {}
+
+	Result(ErrorBox<ErrorType>&& error)
+	  : m_error(error.release()) {}
 
-	Result(ErrorType& error)
-	  : m_impl(std::move(error)) {}
+	Result(Result&& other)
+	  : m_error(std::exchange(other.m_error, nullptr)) {}
 
-	Result(Result const&) = default;
-	Result(Result&&) = default;
-	~Result() = default;
+	Result(Result const&) = delete;
+	Result& operator=(Result const&) = delete;
+
+	~Result() {
+		if (m_error != nullptr) [[unlikely]] {
+			ErrorBox<ErrorType>::destroy(m_error);
+		}
+	}
 
 	bool is_value() const { return !is_error(); }
-	bool is_error() const { return m_impl.has_value(); }
+	bool is_error() const { return m_error != nullptr; }
 
 	void value() { assert(is_value()); }
 	void release_value() { assert(is_value()); }
 
 	ErrorType& error() {
 		assert(is_error());
-		return *m_impl;
+		return *m_error;
 	}
 
 	ErrorType&& release_error() {
 		assert(is_error());
-		return std::move(*m_impl);
+		return std::move(*m_error);
+	}
+
+	ErrorBox<ErrorType> forward_error() {
+		assert(is_error());
+		return ErrorBox<ErrorType> { std::exchange(m_error, nullptr) };
 	}
 
 private:
-	std::optional<ErrorType> m_impl;
+	ErrorType* m_error { nullptr };
 };
 
-#define TRY(expr)                  \
-	({                               \
-		auto _tmp = (expr);            \
-		if (_tmp.is_error())           \
-			return _tmp.release_error(); \
-		_tmp.release_value();          \
+// NOTE: Results are only ever moved, an lvalue passed to TRY or MUST is
+//       consumed like a temporary would be.
+#define TRY(expr)                       \
+	({                                    \
+		auto&& _tmp = (expr);               \
+		if (_tmp.is_error()) [[unlikely]]   \
+			return _tmp.forward_error();      \
+		_tmp.release_value();               \
 	})
 
 #define MUST(expr)           \
 	({                         \
-		auto _tmp = (expr);      \
+		auto&& _tmp = (expr);    \
 		assert(_tmp.is_value()); \
 		_tmp.release_value();    \
 	})
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__AVX2__)
+#	include <immintrin.h>
+#elif defined(__SSE2__)
+#	include <emmintrin.h>
+#endif
+
+namespace bo {
+
+// NOTE: Byte scanners used by the Lexer to skip whitespace and comments. Each
+//       one returns the position of the first match at or after `position`, or
+//       `source.size()` if there is none. When the target supports it they
+//       look at 32 (AVX2) or 16 (SSE2) bytes per step; the scalar loop handles
+//       other targets and the tail of the input.
+
+// NOTE: Same set as std::isspace in the "C" locale, without the locale lookup.
+constexpr bool is_ascii_whitespace(char c) {
+	return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+}
+
+#if defined(__AVX2__)
+namespace Scan {
+
+constexpr std::size_t width = 32;
+
+inline __m256i load(char const* data) { return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data)); }
+inline __m256i splat(char c) { return _mm256_set1_epi8(c); }
+inline std::uint32_t equal_mask(__m256i a, __m256i b) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))); }
+
+inline std::uint32_t whitespace_mask(__m256i bytes) {
+	auto offset = _mm256_sub_epi8(bytes, splat('\t'));
+	auto is_control_space = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, splat('\r' - '\t')), offset);
+	auto is_space = _mm256_cmpeq_epi8(bytes, splat(' '));
+	return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(is_control_space, is_space)));
+}
+
+}
+#elif defined(__SSE2__)
+namespace Scan {
+
+constexpr std::size_t width = 16;
+
+inline __m128i load(char const* data) { return _mm_loadu_si128(reinterpret_cast<__m128i const*>(data)); }
+inline __m128i splat(char c) { return _mm_set1_epi8(c); }
+inline std::uint32_t equal_mask(__m128i a, __m128i b) { return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))); }
+
+inline std::uint32_t whitespace_mask(__m128i bytes) {
+	auto offset = _mm_sub_epi8(bytes, splat('\t'));
+	auto is_control_space = _mm_cmpeq_epi8(_mm_min_epu8(offset, splat('\r' - '\t')), offset);
+	auto is_space = _mm_cmpeq_epi8(bytes, splat(' '));
+	return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(is_control_space, is_space)));
+}
+
+}
+#endif
+
+inline std::size_t find_non_whitespace(std::string_view source, std::size_t position) {
+#if defined(__AVX2__) || defined(__SSE2__)
+	constexpr std::uint32_t all_lanes = Scan::width == 32 ? ~std::uint32_t(0) : (std::uint32_t(1) << Scan::width) - 1;
+	for (; position + Scan::width <= source.size(); position += Scan::width) {
+		auto mask = ~Scan::whitespace_mask(Scan::load(source.data() + position)) & all_lanes;
+		if (mask != 0) {
+			return position + std::countr_zero(mask);
+		}
+	}
+#endif
+
+	while (position < source.size() && is_ascii_whitespace(source[position])) {
+		++position;
+	}
+
+	return position;
+}
+
+inline std::size_t find_byte(std::string_view source, std::size_t position, char byte) {
+#if defined(__AVX2__) || defined(__SSE2__)
+	auto needle = Scan::splat(byte);
+	for (; position + Scan::width <= source.size(); position += Scan::width) {
+		auto mask = Scan::equal_mask(Scan::load(source.data() + position), needle);
+		if (mask != 0) {
+			return position + std::countr_zero(mask);
+		}
+	}
+#endif
+
+	while (position < source.size() && source[position] != byte) {
+		++position;
+	}
+
+	return position;
+}
+
+// NOTE: Returns the position of the '*' of the first "*/" at or after
+//       `position`.
+inline std::size_t find_block_comment_end(std::string_view source, std::size_t position) {
+#if defined(__AVX2__) || defined(__SSE2__)
+	auto asterisk = Scan::splat('*');
+	auto solidus = Scan::splat('/');
+	for (; position + Scan::width + 1 <= source.size(); position += Scan::width) {
+		auto asterisks = Scan::equal_mask(Scan::load(source.data() + position), asterisk);
+		auto solidi = Scan::equal_mask(Scan::load(source.data() + position + 1), solidus);
+		auto mask = asterisks & solidi;
+		if (mask != 0) {
+			return position + std::countr_zero(mask);
+		}
+	}
+#endif
+
+	while (position + 1 < source.size() && !(source[position] == '*' && source[position + 1] == '/')) {
+		++position;
+	}
+
+	return position + 1 < source.size() ? position : source.size();
+}
+
+}
@@ -0,0 +1,11 @@
+# NOTE: Run with `cmake -P`. Fails unless dump-ast gives the same output for
+#       the pointer and the flat AST of SOURCE.
+execute_process(COMMAND ${DUMP_AST} pointer ${SOURCE} OUTPUT_VARIABLE pointer_dump RESULT_VARIABLE pointer_result)
+execute_process(COMMAND ${DUMP_AST} flat ${SOURCE} OUTPUT_VARIABLE flat_dump RESULT_VARIABLE flat_result)
+if(NOT pointer_result EQUAL 0 OR NOT flat_result EQUAL 0)
+	message(FATAL_ERROR "dump-ast failed on ${SOURCE}")
+endif()
+
+if(NOT pointer_dump STREQUAL flat_dump)
+	message(FATAL_ERROR "The flat AST of ${SOURCE} dumps differently:\n${pointer_dump}\n${flat_dump}")
+endif()
@@ -0,0 +1,39 @@
+#include "FlatAST.hpp"
+#include "Parser.hpp"
+#include "SourceFile.hpp"
+#include "utils/Result.hpp"
+
+#include <fmt/core.h>
+
+#include <string_view>
+
+// NOTE: Prints the pointer AST of a program, or the flat tree converted from
+//       it, so that the test can check that both dumps are the same.
+static Result<void, bo::Error> dump_ast(std::string const& path, bool is_flat) {
+	auto file = TRY(bo::SourceFile::open(path));
+	bo::Arena arena;
+	auto parser = TRY(bo::Parser::create(file.contents(), arena));
+	auto program = TRY(parser.parse_program());
+	if (is_flat) {
+		bo::FlatAST::flatten(program).dump();
+	} else {
+		program->dump();
+	}
+
+	return {};
+}
+
+int main(int argc, char** argv) {
+	std::string_view layout = argc == 3 ? argv[1] : "";
+	if (layout != "pointer" && layout != "flat") {
+		fmt::print(stderr, "Usage: {} pointer|flat <file>\n", argc > 0 ? argv[0] : "dump-ast");
+		return 1;
+	}
+
+	if (auto result = dump_ast(argv[2], layout == "flat"); result.is_error()) {
+		fmt::print(stderr, "Error: {}: {}\n", argv[2], result.error().message());
+		return 1;
+	}
+
+	return 0;
+}